@@ -233,6 +233,121 @@ OPL *Config::create(DriverId driver, OplType type) {
 	}
 }
 
+namespace {
+
+// Operator offsets of the nine channels of a register set
+const uint8 kBenchmarkOperators[9] = { 0x00, 0x01, 0x02, 0x08, 0x09, 0x0A, 0x10, 0x11, 0x12 };
+
+// A minor scale, as F-Number/block pairs
+const uint16 kBenchmarkNotes[8] = { 0x157, 0x181, 0x198, 0x1CA, 0x202, 0x220, 0x263, 0x2AE };
+
+void writeBenchmarkNote(OPL *opl, int bank, int channel, uint step) {
+	const uint16 fnum = kBenchmarkNotes[(step + channel) & 7];
+	const int block = 3 + (channel % 3);
+
+	opl->writeReg(bank + 0xB0 + channel, (block << 2) | (fnum >> 8));
+	opl->writeReg(bank + 0xA0 + channel, fnum & 0xFF);
+	opl->writeReg(bank + 0xB0 + channel, 0x20 | (block << 2) | (fnum >> 8));
+}
+
+void setupBenchmarkChannels(OPL *opl, int bank) {
+	for (int channel = 0; channel < 9; ++channel) {
+		const int op = kBenchmarkOperators[channel];
+
+		opl->writeReg(bank + 0x20 + op, 0x21);
+		opl->writeReg(bank + 0x23 + op, 0x21 | (channel & 1) << 6);
+		opl->writeReg(bank + 0x40 + op, 0x18);
+		opl->writeReg(bank + 0x43 + op, 0x04);
+		opl->writeReg(bank + 0x60 + op, 0xF3);
+		opl->writeReg(bank + 0x63 + op, 0xF4);
+		opl->writeReg(bank + 0x80 + op, 0x55);
+		opl->writeReg(bank + 0x83 + op, 0x37);
+		opl->writeReg(bank + 0xE0 + op, channel & 3);
+		opl->writeReg(bank + 0xE3 + op, 0);
+		opl->writeReg(bank + 0xC0 + channel, 0x30 | ((channel % 7) << 1));
+	}
+}
+
+} // End of anonymous namespace
+
+Common::Array<Config::BenchmarkResult> Config::benchmark(uint seconds) {
+	static const OplType types[] = { kOpl2, kDualOpl2, kOpl3 };
+	static const uint32 typeFlags[] = { kFlagOpl2, kFlagDualOpl2, kFlagOpl3 };
+
+	Common::Array<BenchmarkResult> results;
+
+	// The instances below never produce output, so they do not conflict
+	// with one an engine may be using right now.
+	const bool hadInstance = OPL::hasInstance();
+
+	for (int i = 0; _drivers[i].name; ++i) {
+		const DriverId driver = _drivers[i].id;
+		if (driver != kMame && driver != kDOSBox && driver != kNuked)
+			continue;
+
+		for (int t = 0; t < ARRAYSIZE(types); ++t) {
+			if (!(_drivers[i].flags & typeFlags[t]))
+				continue;
+
+			OPL::setHasInstance(false);
+			EmulatedOPL *opl = static_cast<EmulatedOPL *>(create(driver, types[t]));
+			if (!opl)
+				continue;
+
+			if (!opl->init()) {
+				delete opl;
+				continue;
+			}
+
+			if (types[t] == kOpl3)
+				opl->writeReg(0x105, 0x01);
+			opl->writeReg(0x01, 0x20);
+			setupBenchmarkChannels(opl, 0);
+			if (types[t] == kOpl3)
+				setupBenchmarkChannels(opl, 0x100);
+
+			const int channels = opl->isStereo() ? 2 : 1;
+			const uint32 samples = seconds * opl->getRate();
+			const uint32 samplesPerStep = opl->getRate() / 8;
+			int16 buffer[2 * 512];
+			uint32 rendered = 0;
+			uint step = 0;
+
+			opl->setCallbackFrequency(OPL::kDefaultCallbackFrequency);
+
+			const uint32 startTime = g_system->getMillis();
+			while (rendered < samples) {
+				// Retrigger the notes of a few channels every 1/8 second
+				if (rendered >= step * samplesPerStep) {
+					for (int channel = step % 3; channel < 9; channel += 3) {
+						writeBenchmarkNote(opl, 0, channel, step);
+						if (types[t] == kOpl3)
+							writeBenchmarkNote(opl, 0x100, channel, step + 4);
+					}
+					++step;
+				}
+
+				const uint32 count = MIN<uint32>(samples - rendered, ARRAYSIZE(buffer) / channels);
+				opl->readBuffer(buffer, count * channels);
+				rendered += count;
+			}
+
+			BenchmarkResult result;
+			result.driver = driver;
+			result.type = types[t];
+			result.samples = rendered;
+			result.millis = g_system->getMillis() - startTime;
+			results.push_back(result);
+
+			delete opl;
+		}
+	}
+
+	OPL::setHasInstance(hadInstance);
+
+	return results;
+}
+
 void OPL::start(TimerCallback *callback, int timerFrequency) {
 	_callback.reset(callback);
 	startCallbacks(timerFrequency);
@@ -25,6 +25,7 @@
 
 #include "audio/audiostream.h"
 
+#include "common/array.h"
 #include "common/func.h"
 #include "common/ptr.h"
 #include "common/scummsys.h"
@@ -102,6 +103,25 @@ public:
 	 */
 	static OPL *create(OplType type = kOpl2);
 
+	struct BenchmarkResult {
+		DriverId driver;
+		OplType type;
+		uint32 samples;		// rendered samples per channel
+		uint32 millis;		// time taken to render them
+	};
+
+	/**
+	 * Renders the same register sequence through every available OPL
+	 * emulator, for every chip type it supports, and measures how long it
+	 * takes. No sound is output and hardware OPL drivers are skipped.
+	 *
+	 * This may be run while another OPL instance is in use.
+	 *
+	 * @param seconds	amount of audio to render per emulator and type
+	 * @return one entry per emulator and type
+	 */
+	static Common::Array<BenchmarkResult> benchmark(uint seconds);
+
 private:
 	static const EmulatorDescription _drivers[];
 };
@@ -121,6 +141,19 @@ public:
 	OPL();
 	virtual ~OPL() { _hasInstance = false; }
 
+	/**
+	 * Whether an OPL instance exists. Only one may exist at a time.
+	 */
+	static bool hasInstance() { return _hasInstance; }
+
+	/**
+	 * Overrides the single instance check. Only meant for instances that
+	 * never produce output, like those of Config::benchmark().
+	 *
+	 * @param hasInstance	whether the next OPL() constructor fails
+	 */
+	static void setHasInstance(bool hasInstance) { _hasInstance = hasInstance; }
+
 	/**
 	 * Initializes the OPL emulator.
 	 *
@@ -247,6 +280,7 @@ public:
 
 	// AudioStream API
 	int readBuffer(int16 *buffer, const int numSamples);
+	virtual bool isStereo() const = 0;
 	int getRate() const;
 	bool endOfData() const { return false; }
 
@@ -50,7 +50,9 @@ _activeTrack(255),
 _abortParse(false),
 _jumpingToTick(false),
 _doParse(true),
-_pause(false) {
+_pause(false),
+_seekIndexEnabled(false),
+_seekIndexTrack(255) {
 	memset(_activeNotes, 0, sizeof(_activeNotes));
 	memset(_tracks, 0, sizeof(_tracks));
 	_nextEvent.start = NULL;
@@ -79,6 +81,10 @@ void MidiParser::property(int prop, int value) {
 	case mpDisableAutoStartPlayback:
 		_disableAutoStartPlayback = (value != 0);
 		break;
+	case mpSeekIndex:
+		_seekIndexEnabled = (value != 0);
+		invalidateSeekIndex();
+		break;
 	default:
 		break;
 	}
@@ -463,8 +469,35 @@ bool MidiParser::jumpToTick(uint32 tick, bool fireEvents, bool stopNotes, bool d
 	Tracker currentPos(_position);
 	EventInfo currentEvent(_nextEvent);
 
+	const SeekCheckpoint *checkpoint = 0;
+	if (_seekIndexEnabled && tick > 0) {
+		if (_seekIndexTrack != _activeTrack)
+			buildSeekIndex();
+		checkpoint = findSeekCheckpoint(tick, fireEvents, dontSendNoteOn);
+	}
+
 	resetTracking();
-	_position._playPos = _tracks[_activeTrack];
+	if (checkpoint) {
+		// The ticks before the first tempo event are timed with
+		// the tempo in effect before the jump.
+		uint32 untimedTime = checkpoint->untimedTicks * _psecPerTick;
+
+		_position = checkpoint->position;
+		_position._lastEventTime += untimedTime;
+		_position._playTime += untimedTime;
+
+		if (checkpoint->tempoData) {
+			setTempo(checkpoint->tempo);
+			if (fireEvents)
+				sendMetaEventToDriver(0x51, checkpoint->tempoData, (uint16)checkpoint->tempoLength);
+		}
+		if (fireEvents) {
+			for (uint i = 0; i < checkpoint->channelState.size(); ++i)
+				sendToDriver(checkpoint->channelState[i]);
+		}
+	} else {
+		_position._playPos = _tracks[_activeTrack];
+	}
 	parseNextEvent(_nextEvent);
 	if (tick > 0) {
 		while (true) {
@@ -520,7 +553,172 @@ bool MidiParser::jumpToTick(uint32 tick, bool fireEvents, bool stopNotes, bool d
 	return true;
 }
 
+void MidiParser::buildSeekIndex() {
+	invalidateSeekIndex();
+	_seekIndexTrack = _activeTrack;
+
+	Tracker currentPos(_position);
+	EventInfo currentEvent(_nextEvent);
+	uint32 currentTempo = _tempo;
+
+	// The channel state replaying the events so far would leave behind.
+	// 0xFF (0xFFFF for pitch bends) marks values which were never set.
+	byte program[16];
+	byte controllers[16][128];
+	byte pressure[16];
+	uint16 pitchBend[16];
+	byte programBank[16][2];
+	uint16 notes[128];
+	memset(program, 0xFF, sizeof(program));
+	memset(controllers, 0xFF, sizeof(controllers));
+	memset(pressure, 0xFF, sizeof(pressure));
+	memset(pitchBend, 0xFF, sizeof(pitchBend));
+	memset(programBank, 0xFF, sizeof(programBank));
+	memset(notes, 0, sizeof(notes));
+
+	bool channelEventsOnly = true;
+	byte *tempoData = 0;
+	uint32 tempoLength = 0;
+	uint32 untimedTicks = 0;
+
+	const uint32 interval = MAX<uint32>(_ppqn, 1) * kSeekIndexInterval;
+	uint32 nextCheckpoint = interval;
+
+	_position.clear();
+	_position._playPos = _tracks[_activeTrack];
+	Tracker eventPos(_position);
+	parseNextEvent(_nextEvent);
+	while (true) {
+		EventInfo &info = _nextEvent;
+		if (info.event == 0xFF && info.ext.type == 0x2F)
+			break;
+
+		uint32 eventTick = _position._lastEventTick + info.delta;
+		if (eventTick >= nextCheckpoint) {
+			SeekCheckpoint checkpoint;
+			checkpoint.position = eventPos;
+			checkpoint.untimedTicks = untimedTicks;
+			checkpoint.tempo = _tempo;
+			checkpoint.tempoData = tempoData;
+			checkpoint.tempoLength = tempoLength;
+			checkpoint.channelEventsOnly = channelEventsOnly;
+			checkpoint.notesHeld = false;
+			for (int i = 0; i < 128; ++i)
+				checkpoint.notesHeld |= (notes[i] != 0);
+
+			if (channelEventsOnly) {
+				for (byte ch = 0; ch < 16; ++ch) {
+					// A bank select only applies to the next program change,
+					// so select the bank the program was chosen from first.
+					if (program[ch] != 0xFF) {
+						if (programBank[ch][0] != 0xFF)
+							checkpoint.channelState.push_back(0xB0 | ch | (programBank[ch][0] << 16));
+						if (programBank[ch][1] != 0xFF)
+							checkpoint.channelState.push_back(0xB0 | ch | (32 << 8) | (programBank[ch][1] << 16));
+						checkpoint.channelState.push_back(0xC0 | ch | (program[ch] << 8));
+					}
+					for (int i = 0; i < 128; ++i) {
+						if (controllers[ch][i] != 0xFF)
+							checkpoint.channelState.push_back(0xB0 | ch | (i << 8) | (controllers[ch][i] << 16));
+					}
+					if (pressure[ch] != 0xFF)
+						checkpoint.channelState.push_back(0xD0 | ch | (pressure[ch] << 8));
+					if (pitchBend[ch] != 0xFFFF)
+						checkpoint.channelState.push_back(0xE0 | ch | ((pitchBend[ch] & 0x7F) << 8) | ((pitchBend[ch] >> 7) << 16));
+				}
+			}
+
+			_seekIndex.push_back(checkpoint);
+			nextCheckpoint = (eventTick / interval + 1) * interval;
+			if (nextCheckpoint <= eventTick)
+				break;
+		}
+
+		_position._lastEventTick = eventTick;
+		if (tempoData)
+			_position._lastEventTime += info.delta * _psecPerTick;
+		else
+			untimedTicks += info.delta;
+		_position._playTick = _position._lastEventTick;
+		_position._playTime = _position._lastEventTime;
+
+		byte ch = info.channel();
+		switch (info.command()) {
+		case 0x8:
+			notes[info.basic.param1 & 0x7F] &= ~(1 << ch);
+			break;
+		case 0x9:
+			if (info.basic.param2)
+				notes[info.basic.param1 & 0x7F] |= (1 << ch);
+			else
+				notes[info.basic.param1 & 0x7F] &= ~(1 << ch);
+			break;
+		case 0xB:
+			if (info.basic.param1 == 6 || info.basic.param1 == 38 ||
+			    (info.basic.param1 >= 96 && info.basic.param1 <= 101) || info.basic.param1 >= 120) {
+				// The effect of (N)RPN data entry and channel mode
+				// messages depends on when they are sent.
+				channelEventsOnly = false;
+			} else {
+				controllers[ch][info.basic.param1] = info.basic.param2 & 0x7F;
+			}
+			break;
+		case 0xC:
+			program[ch] = info.basic.param1 & 0x7F;
+			programBank[ch][0] = controllers[ch][0];
+			programBank[ch][1] = controllers[ch][32];
+			break;
+		case 0xD:
+			pressure[ch] = info.basic.param1 & 0x7F;
+			break;
+		case 0xE:
+			pitchBend[ch] = (info.basic.param1 & 0x7F) | ((info.basic.param2 & 0x7F) << 7);
+			break;
+		case 0xF:
+			if (info.event == 0xFF && info.ext.type == 0x51 && info.length >= 3) {
+				tempoData = info.ext.data;
+				tempoLength = info.length;
+			} else {
+				channelEventsOnly = false;
+			}
+			break;
+		default:
+			break;
+		}
+
+		processEvent(info, false);
+
+		eventPos = _position;
+		parseNextEvent(_nextEvent);
+	}
+
+	_position = currentPos;
+	_nextEvent = currentEvent;
+	setTempo(currentTempo);
+}
+
+const MidiParser::SeekCheckpoint *MidiParser::findSeekCheckpoint(uint32 tick, bool fireEvents, bool dontSendNoteOn) const {
+	// The last checkpoint whose preceding event lies before the target
+	// tick. Parsing from there stops at the same event as parsing from
+	// the start of the track would.
+	for (int i = (int)_seekIndex.size() - 1; i >= 0; --i) {
+		const SeekCheckpoint &checkpoint = _seekIndex[i];
+		if (checkpoint.position._lastEventTick >= tick)
+			continue;
+		if (!fireEvents || (checkpoint.channelEventsOnly && (dontSendNoteOn || !checkpoint.notesHeld)))
+			return &checkpoint;
+	}
+	return 0;
+}
+
+void MidiParser::invalidateSeekIndex() {
+	_seekIndex.clear();
+	_seekIndexTrack = 255;
+}
+
 void MidiParser::unloadMusic() {
+	invalidateSeekIndex();
+
 	if (_numTracks == 0)
 		// No music data loaded
 		return;
@@ -26,6 +26,7 @@
 #define AUDIO_MIDIPARSER_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/endian.h"
 
 class MidiDriver_BASE;
@@ -321,6 +322,29 @@ protected:
 	bool   _doParse;       ///< True if the parser should be parsing; false if it should not be active
 	bool   _pause;		   ///< True if the parser has paused parsing
 
+	/**
+	 * A position in the active track from which jumpToTick can resume
+	 * parsing. It holds the parser state right before an event is parsed,
+	 * together with the channel state that replaying all preceding events
+	 * would have left the driver in.
+	 */
+	struct SeekCheckpoint {
+		Tracker position;       ///< Tracker before parsing the event. Times only cover the ticks after the first tempo event.
+		uint32 untimedTicks;    ///< Ticks before the first tempo event; these are timed with the tempo in effect when jumping.
+		uint32 tempo;           ///< Tempo after the preceding events. Only valid if tempoData is set.
+		byte  *tempoData;       ///< Data of the last preceding tempo event, or 0 if there was none.
+		uint32 tempoLength;     ///< Length of the data of the last preceding tempo event.
+		bool   channelEventsOnly; ///< True if only channel and tempo events precede the checkpoint.
+		bool   notesHeld;       ///< True if notes are still on at the checkpoint.
+		Common::Array<uint32> channelState; ///< Messages which restore the bank, program, controller, pressure and pitch bend state.
+	};
+
+	static const uint32 kSeekIndexInterval = 16; ///< Number of quarter notes between two checkpoints.
+
+	bool   _seekIndexEnabled; ///< Build a checkpoint index for jumpToTick
+	byte   _seekIndexTrack;   ///< The track _seekIndex was built for; 255 if there is no index.
+	Common::Array<SeekCheckpoint> _seekIndex; ///< Checkpoints of the active track, in ascending order.
+
 protected:
 	static uint32 readVLQ(byte * &data);
 	virtual void resetTracking();
@@ -332,6 +356,10 @@ protected:
 	void hangingNote(byte channel, byte note, uint32 ticksLeft, bool recycle = true);
 	void hangAllActiveNotes();
 
+	void buildSeekIndex();
+	const SeekCheckpoint *findSeekCheckpoint(uint32 tick, bool fireEvents, bool dontSendNoteOn) const;
+	void invalidateSeekIndex();
+
 	/**
 	 * Called before starting playback of a track.
 	 * Can be implemented by subclasses if they need to
@@ -422,7 +450,23 @@ public:
 		  * or setting the track. Use startPlaying to start playback.
 		  * Note that not every parser implementation might support this.
 		  */
-		 mpDisableAutoStartPlayback = 7
+		 mpDisableAutoStartPlayback = 7,
+
+		 /**
+		  * Builds an index of checkpoints the first time jumpToTick is
+		  * used on a track, so later jumps can resume parsing from the
+		  * closest checkpoint instead of the start of the track.
+		  * Only use this for formats whose parsing state is fully kept in
+		  * the Tracker and which never jump around in the track data while
+		  * parsing (e.g. SMF), and for parsers which do not override
+		  * processEvent.
+		  * When events are fired, the events before a checkpoint are
+		  * replaced by their resulting channel state. Checkpoints after
+		  * SysEx, meta events other than tempo changes, RPN/NRPN or channel
+		  * mode messages are not used in that case, nor are checkpoints
+		  * with notes still on unless note on events are not sent.
+		  */
+		 mpSeekIndex = 8
 	};
 
 public:
@@ -22,6 +22,7 @@
 
 #include "gui/EventRecorder.h"
 
+#include "common/profiler.h"
 #include "common/util.h"
 #include "common/textconsole.h"
 
@@ -267,6 +268,9 @@ void MixerImpl::playStream(
 int MixerImpl::mixCallback(byte *samples, uint len) {
 	assert(samples);
 
+	PROFILE_THREAD_NAME("audio");
+	PROFILE_ZONE("MixerImpl::mixCallback");
+
 	Common::StackLock lock(_mutex);
 
 	int16 *buf = (int16 *)samples;
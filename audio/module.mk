@@ -5,6 +5,7 @@ MODULE_OBJS := \
 	audiostream.o \
 	fmopl.o \
 	mididrv.o \
+	mididrv_base.o \
 	midiparser_qt.o \
 	midiparser_smf.o \
 	midiparser_xmidi.o \
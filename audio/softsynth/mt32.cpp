@@ -26,6 +26,8 @@
 #ifdef USE_MT32EMU
 
 #include "audio/softsynth/emumidi.h"
+#include "audio/softsynth/mt32.h"
+#include "audio/midiparser.h"
 #include "audio/musicplugin.h"
 #include "audio/mpu401.h"
 
@@ -40,6 +42,9 @@
 #include "common/textconsole.h"
 #include "common/translation.h"
 #include "common/osd_message_queue.h"
+#include "common/queue.h"
+#include "common/thread.h"
+#include "common/timer.h"
 
 #include "graphics/fontman.h"
 #include "graphics/surface.h"
@@ -58,7 +63,14 @@
 namespace MT32Emu {
 
 class ScummVMReportHandler : public MT32Emu::IReportHandler {
+	bool _showDialogs;
+
 public:
+	ScummVMReportHandler() : _showDialogs(true) {}
+
+	// The benchmark runs without a screen, it only reports errors
+	void setShowDialogs(bool show) { _showDialogs = show; }
+
 	// Callback for debug messages, in vprintf() format
 	void printDebug(const char *fmt, va_list list) {
 		Common::String out = Common::String::vformat(fmt, list);
@@ -67,13 +79,17 @@ public:
 
 	// Callbacks for reporting various errors and information
 	void onErrorControlROM() {
-		GUI::MessageDialog dialog("MT32Emu: Init Error - Missing or invalid Control ROM image", "OK");
-		dialog.runModal();
+		if (_showDialogs) {
+			GUI::MessageDialog dialog("MT32Emu: Init Error - Missing or invalid Control ROM image", "OK");
+			dialog.runModal();
+		}
 		error("MT32emu: Init Error - Missing or invalid Control ROM image");
 	}
 	void onErrorPCMROM() {
-		GUI::MessageDialog dialog("MT32Emu: Init Error - Missing PCM ROM image", "OK");
-		dialog.runModal();
+		if (_showDialogs) {
+			GUI::MessageDialog dialog("MT32Emu: Init Error - Missing PCM ROM image", "OK");
+			dialog.runModal();
+		}
 		error("MT32emu: Init Error - Missing PCM ROM image");
 	}
 	void showLCDMessage(const char *message) {
@@ -113,6 +129,58 @@ private:
 
 	int _outputRate;
 
+	// Render-ahead mode: a worker thread renders the synth into a ring
+	// buffer up to _renderAheadFrames ahead of playback, so the mixer
+	// callback only copies samples. MIDI events are queued and handed to
+	// MUNT with timestamps, which keeps their relative timing
+	// sample-accurate; they are delayed by the constant render-ahead
+	// latency. Without thread support, the mixer callback renders ahead
+	// itself whenever the ring runs low.
+	enum QueuedEventType {
+		kEventShort,
+		kEventSysex,
+		kEventWriteSysex
+	};
+
+	struct QueuedEvent {
+		QueuedEventType type;
+		uint32 timestamp;	// in output frames
+		uint32 msg;			// short message, or channel for kEventWriteSysex
+		byte *data;
+		uint16 length;
+	};
+
+	enum {
+		kRenderChunkFrames = 512,
+		kMinRenderAheadFrames = 256
+	};
+
+	uint32 _renderAheadFrames;
+	int16 *_ring;
+	uint32 _ringMask;
+	uint32 _ringRead, _ringWrite;	// output frame counters, wrapping
+	Common::Mutex _ringMutex;		// only held to access the counters
+
+	Common::Queue<QueuedEvent> _eventQueue;
+	Common::Mutex _eventMutex;
+
+	Common::Thread _renderThread;
+	Common::Mutex _renderThreadMutex;
+	Common::ConditionVariable _renderThreadWakeUp;	// signalled when frames were consumed
+	bool _renderThreadPending;
+	bool _renderThreadQuit;
+
+	int openSynth();
+	void closeSynth();
+
+	void queueEvent(QueuedEventType type, uint32 msg, const byte *data, uint16 length);
+	void freeQueuedEvents();
+	void renderAhead(uint32 minFrames);
+	void stopRenderThread();
+	static void renderThreadProc(void *param);
+
+	friend bool MT32Emu::benchmarkSynth(const Common::String &midiFile, MT32Emu::BenchmarkResult &result);
+
 protected:
 	void generateSamples(int16 *buf, int len) override;
 
@@ -150,6 +218,12 @@ MidiDriver_MT32::MidiDriver_MT32(Audio::Mixer *mixer) : MidiDriver_Emulated(mixe
 	_outputRate = 0;
 	_controlData = nullptr;
 	_pcmData = nullptr;
+	_renderAheadFrames = 0;
+	_ring = nullptr;
+	_ringMask = 0;
+	_ringRead = _ringWrite = 0;
+	_renderThreadPending = false;
+	_renderThreadQuit = false;
 }
 
 MidiDriver_MT32::~MidiDriver_MT32() {
@@ -172,6 +246,45 @@ int MidiDriver_MT32::open() {
 		g_system->getPaletteManager()->setPalette(dummy_palette, 0, 3);
 	}
 
+	int result = openSynth();
+	if (result != 0)
+		return result;
+
+	MidiDriver_Emulated::open();
+
+	_renderAheadFrames = 0;
+	if (ConfMan.hasKey("mt32_render_ahead"))
+		_renderAheadFrames = MAX(ConfMan.getInt("mt32_render_ahead"), 0) * _outputRate / 1000;
+
+	if (_renderAheadFrames) {
+		_renderAheadFrames = MAX<uint32>(_renderAheadFrames, kMinRenderAheadFrames);
+
+		// The mixer side pulls at most one callback worth of frames at a
+		// time, which the slack on top of the render-ahead covers.
+		uint32 ringSize = 1;
+		while (ringSize < _renderAheadFrames + kMinRenderAheadFrames)
+			ringSize <<= 1;
+
+		_ring = new int16[ringSize * 2];
+		_ringMask = ringSize - 1;
+		_ringRead = _ringWrite = 0;
+
+		renderAhead(0);
+
+		_renderThreadPending = false;
+		_renderThreadQuit = false;
+		if (!_renderThread.start(&renderThreadProc, this))
+			debug(1, "MT-32 emulator renders ahead in the mixer callback, as there is no thread support");
+
+		debug(1, "MT-32 emulator renders %d ms ahead", _renderAheadFrames * 1000 / _outputRate);
+	}
+
+	_mixer->playStream(Audio::Mixer::kPlainSoundType, &_mixerSoundHandle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
+
+	return 0;
+}
+
+int MidiDriver_MT32::openSynth() {
 	debug(4, _s("Initializing MT-32 Emulator"));
 
 	Common::File controlFile;
@@ -219,16 +332,17 @@ int MidiDriver_MT32::open() {
 	// AudioStream.
 	_outputRate = _service.getActualStereoOutputSamplerate();
 
-	MidiDriver_Emulated::open();
-
-	_mixer->playStream(Audio::Mixer::kPlainSoundType, &_mixerSoundHandle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
-
 	return 0;
 }
 
 void MidiDriver_MT32::send(uint32 b) {
 	midiDriverCommonSend(b);
 
+	if (_ring) {
+		queueEvent(kEventShort, b, nullptr, 0);
+		return;
+	}
+
 	Common::StackLock lock(_mutex);
 	_service.playMsg(b);
 }
@@ -240,6 +354,12 @@ void MidiDriver_MT32::setPitchBendRange(byte channel, uint range) {
 		warning("setPitchBendRange() called with range > 24: %d", range);
 	}
 	byte benderRangeSysex[4] = { 0, 0, 4, (uint8)range };
+
+	if (_ring) {
+		queueEvent(kEventWriteSysex, channel, benderRangeSysex, 4);
+		return;
+	}
+
 	Common::StackLock lock(_mutex);
 	_service.writeSysex(channel, benderRangeSysex, 4);
 }
@@ -247,6 +367,11 @@ void MidiDriver_MT32::setPitchBendRange(byte channel, uint range) {
 void MidiDriver_MT32::sysEx(const byte *msg, uint16 length) {
 	midiDriverCommonSysEx(msg, length);
 	if (msg[0] == 0xf0) {
+		if (_ring) {
+			queueEvent(kEventSysex, 0, msg, length);
+			return;
+		}
+
 		Common::StackLock lock(_mutex);
 		_service.playSysex(msg, length);
 	} else {
@@ -256,6 +381,11 @@ void MidiDriver_MT32::sysEx(const byte *msg, uint16 length) {
 		};
 
 		if (msg[3] == SYSEX_CMD_DT1 || msg[3] == SYSEX_CMD_DAT) {
+			if (_ring) {
+				queueEvent(kEventWriteSysex, msg[1], msg + 4, length - 5);
+				return;
+			}
+
 			Common::StackLock lock(_mutex);
 			_service.writeSysex(msg[1], msg + 4, length - 5);
 		} else {
@@ -271,9 +401,15 @@ void MidiDriver_MT32::close() {
 
 	// Detach the player callback handler
 	setTimerCallback(NULL, NULL);
-	// Detach the mixer callback handler
-	_mixer->stopHandle(_mixerSoundHandle);
+	// Detach the mixer callback handler, then stop the render-ahead thread
+	if (_mixer)
+		_mixer->stopHandle(_mixerSoundHandle);
+	stopRenderThread();
 
+	closeSynth();
+}
+
+void MidiDriver_MT32::closeSynth() {
 	Common::StackLock lock(_mutex);
 	_service.closeSynth();
 	_service.freeContext();
@@ -281,11 +417,173 @@ void MidiDriver_MT32::close() {
 	_controlData = nullptr;
 	delete[] _pcmData;
 	_pcmData = nullptr;
+
+	freeQueuedEvents();
+	delete[] _ring;
+	_ring = nullptr;
 }
 
 void MidiDriver_MT32::generateSamples(int16 *data, int len) {
+	if (!_ring) {
+		Common::StackLock lock(_mutex);
+		_service.renderBit16s(data, len);
+		return;
+	}
+
+	uint32 readPos, available;
+	{
+		Common::StackLock lock(_ringMutex);
+		readPos = _ringRead;
+		available = _ringWrite - _ringRead;
+	}
+
+	if (available < (uint32)len) {
+		// The render-ahead thread fell behind, or there is none: render
+		// the missing frames right here, just as without render-ahead.
+		renderAhead(len);
+	}
+
+	while (len > 0) {
+		uint32 offset = readPos & _ringMask;
+		uint32 count = MIN<uint32>(len, _ringMask + 1 - offset);
+
+		memcpy(data, _ring + offset * 2, count * 2 * sizeof(int16));
+		data += count * 2;
+		readPos += count;
+		len -= count;
+	}
+
+	{
+		Common::StackLock lock(_ringMutex);
+		_ringRead = readPos;
+	}
+
+	if (_renderThread.isRunning()) {
+		Common::StackLock lock(_renderThreadMutex);
+		_renderThreadPending = true;
+		_renderThreadWakeUp.signal();
+	}
+}
+
+void MidiDriver_MT32::queueEvent(QueuedEventType type, uint32 msg, const byte *data, uint16 length) {
+	QueuedEvent event;
+	event.type = type;
+	event.msg = msg;
+	event.length = length;
+	event.data = nullptr;
+	if (length) {
+		event.data = new byte[length];
+		memcpy(event.data, data, length);
+	}
+
+	{
+		// Everything up to this point of the ring may already be rendered
+		Common::StackLock lock(_ringMutex);
+		event.timestamp = _ringRead + _renderAheadFrames;
+	}
+
+	Common::StackLock lock(_eventMutex);
+	_eventQueue.push(event);
+}
+
+void MidiDriver_MT32::freeQueuedEvents() {
+	Common::StackLock lock(_eventMutex);
+	while (!_eventQueue.empty())
+		delete[] _eventQueue.pop().data;
+}
+
+void MidiDriver_MT32::renderAhead(uint32 minFrames) {
 	Common::StackLock lock(_mutex);
-	_service.renderBit16s(data, len);
+
+	if (!_ring)
+		return;
+
+	for (;;) {
+		uint32 readPos;
+		{
+			Common::StackLock ringLock(_ringMutex);
+			readPos = _ringRead;
+		}
+
+		const uint32 end = readPos + MAX(_renderAheadFrames, minFrames);
+		uint32 limit = end;
+		if ((int32)(end - _ringWrite) <= 0)
+			break;
+
+		{
+			Common::StackLock eventLock(_eventMutex);
+			while (!_eventQueue.empty()) {
+				QueuedEvent &event = _eventQueue.front();
+
+				if (event.type == kEventWriteSysex) {
+					// Direct memory writes bypass MUNT's queue, so render
+					// up to their position first to keep the ordering.
+					if ((int32)(event.timestamp - _ringWrite) > 0) {
+						if ((int32)(event.timestamp - limit) < 0)
+							limit = event.timestamp;
+						break;
+					}
+					_service.writeSysex(event.msg, event.data, event.length);
+				} else {
+					const uint32 timestamp = _service.convertOutputToSynthTimestamp(event.timestamp);
+					mt32emu_return_code rc;
+
+					if (event.type == kEventShort)
+						rc = _service.playMsgAt(event.msg, timestamp);
+					else
+						rc = _service.playSysexAt(event.data, event.length, timestamp);
+
+					if (rc != MT32EMU_RC_OK) {
+						// The MIDI queue is full: play it now, slightly early
+						if (event.type == kEventShort)
+							_service.playMsgNow(event.msg);
+						else
+							_service.playSysexNow(event.data, event.length);
+					}
+				}
+
+				delete[] _eventQueue.pop().data;
+			}
+		}
+
+		uint32 frames = MIN<uint32>(limit - _ringWrite, kRenderChunkFrames);
+		uint32 offset = _ringWrite & _ringMask;
+		frames = MIN<uint32>(frames, _ringMask + 1 - offset);
+
+		if (frames)
+			_service.renderBit16s(_ring + offset * 2, frames);
+
+		Common::StackLock ringLock(_ringMutex);
+		_ringWrite += frames;
+	}
+}
+
+void MidiDriver_MT32::stopRenderThread() {
+	if (!_renderThread.isRunning())
+		return;
+
+	{
+		Common::StackLock lock(_renderThreadMutex);
+		_renderThreadQuit = true;
+		_renderThreadWakeUp.signal();
+	}
+	_renderThread.join();
+}
+
+void MidiDriver_MT32::renderThreadProc(void *param) {
+	MidiDriver_MT32 *driver = (MidiDriver_MT32 *)param;
+
+	for (;;) {
+		driver->renderAhead(0);
+
+		Common::StackLock lock(driver->_renderThreadMutex);
+		while (!driver->_renderThreadPending && !driver->_renderThreadQuit)
+			driver->_renderThreadWakeUp.wait(driver->_renderThreadMutex);
+
+		if (driver->_renderThreadQuit)
+			return;
+		driver->_renderThreadPending = false;
+	}
 }
 
 uint32 MidiDriver_MT32::property(int prop, uint32 param) {
@@ -434,6 +732,67 @@ void MidiDriver_ThreadedMT32::onTimer() {
 #endif
 
 
+namespace MT32Emu {
+
+bool benchmarkSynth(const Common::String &midiFile, BenchmarkResult &result) {
+	Common::FSNode node(midiFile);
+	Common::SeekableReadStream *stream = node.createReadStream();
+	if (!stream) {
+		warning("MT-32 benchmark: Could not open '%s'", midiFile.c_str());
+		return false;
+	}
+
+	uint32 size = stream->size();
+	byte *data = new byte[size];
+	stream->read(data, size);
+	delete stream;
+
+	// No mixer: the benchmark pulls the samples itself, without render-ahead
+	MidiDriver_MT32 driver(nullptr);
+	driver._reportHandler.setShowDialogs(false);
+	if (driver.openSynth() != 0) {
+		delete[] data;
+		return false;
+	}
+	driver.MidiDriver_Emulated::open();
+
+	MidiParser *parser = MidiParser::createParser_SMF();
+	if (!parser->loadMusic(data, size)) {
+		warning("MT-32 benchmark: '%s' is not a Standard MIDI File", midiFile.c_str());
+		delete parser;
+		delete[] data;
+		driver.close();
+		return false;
+	}
+
+	parser->setMidiDriver(&driver);
+	parser->setTimerRate(driver.getBaseTempo());
+	driver.setTimerCallback(parser, &MidiParser::timerCallback);
+
+	// Stop after an hour of audio, in case the file loops
+	const uint32 maxFrames = driver.getRate() * 3600;
+	int16 buffer[2 * 1024];
+	uint32 frames = 0;
+
+	const uint32 startTime = g_system->getMillis();
+	while (parser->isPlaying() && frames < maxFrames) {
+		driver.readBuffer(buffer, ARRAYSIZE(buffer));
+		frames += ARRAYSIZE(buffer) / 2;
+	}
+	result.elapsedMillis = g_system->getMillis() - startTime;
+	result.renderedFrames = frames;
+	result.sampleRate = driver.getRate();
+
+	parser->unloadMusic();
+	delete parser;
+	delete[] data;
+	driver.close();
+
+	return true;
+}
+
+} // End of namespace MT32Emu
+
 // Plugin interface
 
 class MT32EmuMusicPlugin : public MusicPluginObject {
@@ -0,0 +1,60 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef AUDIO_SOFTSYNTH_MT32_H
+#define AUDIO_SOFTSYNTH_MT32_H
+
+#include "common/scummsys.h"
+
+#ifdef USE_MT32EMU
+
+namespace Common {
+class String;
+}
+
+namespace MT32Emu {
+
+struct BenchmarkResult {
+	uint32 renderedFrames;
+	uint32 sampleRate;
+	uint32 elapsedMillis;
+};
+
+/**
+ * Renders a Standard MIDI File through the MT-32 emulator as fast as
+ * possible, without any audio output, and reports how long it took.
+ * The ROMs are looked up the same way as for regular playback.
+ *
+ * This needs an initialized backend for its clock, but not a screen:
+ * errors are reported without dialogs.
+ *
+ * @param midiFile	path of the MIDI file to render
+ * @param result	filled in with the benchmark figures
+ * @return true on success, false if the file or the ROMs could not be loaded
+ */
+bool benchmarkSynth(const Common::String &midiFile, BenchmarkResult &result);
+
+} // End of namespace MT32Emu
+
+#endif
+
+#endif
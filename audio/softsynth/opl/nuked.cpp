@@ -689,6 +689,56 @@ static void OPL3_SlotCalcFB(opl3_slot *slot)
     slot->prout = slot->out;
 }
 
+//
+// Advances a slot by one sample, skipping the work a silent slot does not
+// need. Most slots are silent most of the time (e.g. all of the second
+// register set in OPL2 mode). The shortcut produces exactly the same state
+// and output as the full envelope and waveform calculation. Samples are
+// still rendered one at a time, slot by slot, as before.
+//
+
+static inline void OPL3_SlotProcess(opl3_slot *slot)
+{
+    Bit16u phase;
+
+    OPL3_SlotCalcFB(slot);
+    if (slot->eg_rout == 0x1ff && slot->eg_gen == envelope_gen_num_release && !slot->key)
+    {
+        // Fully released: the envelope stays put, only the
+        // attenuation may change
+        slot->eg_out = slot->eg_rout + (slot->reg_tl << 2)
+                     + (slot->eg_ksl >> kslshift[slot->reg_ksl]) + *slot->trem;
+        slot->pg_reset = 0;
+    }
+    else
+    {
+        OPL3_EnvelopeCalc(slot);
+    }
+    OPL3_PhaseGenerate(slot);
+    if (slot->eg_out < 0x1ff)
+    {
+        OPL3_SlotGenerate(slot);
+        return;
+    }
+    // At this attenuation the exp lookup always yields 0, so only the
+    // sign of the waveform is left
+    phase = (Bit16u)(slot->pg_phase_out + *slot->mod) & 0x3ff;
+    switch (slot->reg_wf)
+    {
+    case 0:
+    case 6:
+    case 7:
+        slot->out = (phase & 0x200) ? -1 : 0;
+        break;
+    case 4:
+        slot->out = ((phase & 0x300) == 0x100) ? -1 : 0;
+        break;
+    default:
+        slot->out = 0;
+        break;
+    }
+}
+
 //
 // Channel
 //
@@ -1071,10 +1121,7 @@ void OPL3_Generate(opl3_chip *chip, Bit16s *buf)
 
     for (ii = 0; ii < 15; ii++)
     {
-        OPL3_SlotCalcFB(&chip->slot[ii]);
-        OPL3_EnvelopeCalc(&chip->slot[ii]);
-        OPL3_PhaseGenerate(&chip->slot[ii]);
-        OPL3_SlotGenerate(&chip->slot[ii]);
+        OPL3_SlotProcess(&chip->slot[ii]);
     }
 
     chip->mixbuff[0] = 0;
@@ -1090,20 +1137,14 @@ void OPL3_Generate(opl3_chip *chip, Bit16s *buf)
 
     for (ii = 15; ii < 18; ii++)
     {
-        OPL3_SlotCalcFB(&chip->slot[ii]);
-        OPL3_EnvelopeCalc(&chip->slot[ii]);
-        OPL3_PhaseGenerate(&chip->slot[ii]);
-        OPL3_SlotGenerate(&chip->slot[ii]);
+        OPL3_SlotProcess(&chip->slot[ii]);
     }
 
     buf[0] = OPL3_ClipSample(chip->mixbuff[0]);
 
     for (ii = 18; ii < 33; ii++)
     {
-        OPL3_SlotCalcFB(&chip->slot[ii]);
-        OPL3_EnvelopeCalc(&chip->slot[ii]);
-        OPL3_PhaseGenerate(&chip->slot[ii]);
-        OPL3_SlotGenerate(&chip->slot[ii]);
+        OPL3_SlotProcess(&chip->slot[ii]);
     }
 
     chip->mixbuff[1] = 0;
@@ -1119,10 +1160,7 @@ void OPL3_Generate(opl3_chip *chip, Bit16s *buf)
 
     for (ii = 33; ii < 36; ii++)
     {
-        OPL3_SlotCalcFB(&chip->slot[ii]);
-        OPL3_EnvelopeCalc(&chip->slot[ii]);
-        OPL3_PhaseGenerate(&chip->slot[ii]);
-        OPL3_SlotGenerate(&chip->slot[ii]);
+        OPL3_SlotProcess(&chip->slot[ii]);
     }
 
     if ((chip->timer & 0x3f) == 0x3f)
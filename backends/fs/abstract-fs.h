@@ -183,6 +183,14 @@ public:
 	 */
 	virtual Common::SeekableReadStream *createReadStream() = 0;
 
+	/**
+	 * Creates a SeekableReadStream instance which may map the file into
+	 * memory. Backends without memory mapping use createReadStream().
+	 *
+	 * @return pointer to the stream object, 0 in case of a failure
+	 */
+	virtual Common::SeekableReadStream *createMappedReadStream() { return createReadStream(); }
+
 	/**
 	 * Creates a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -198,6 +206,29 @@ public:
 	* @return true if the directory is created successfully
 	*/
 	virtual bool createDirectory() = 0;
+
+	/**
+	* Renames the file referred by this node, keeping it in the same
+	* directory. A file already using the new name is replaced.
+	*
+	* Backends which cannot do this atomically do not implement it.
+	*
+	* @return true if the file was renamed successfully
+	*/
+	virtual bool rename(const Common::String &newName) { return false; }
+
+	/**
+	* Deletes the file referred by this node.
+	*
+	* @return true if the file was deleted successfully
+	*/
+	virtual bool remove() { return false; }
+
+	/**
+	* Returns the time the file referred by this node was last modified,
+	* in seconds, or 0 if the backend does not know it.
+	*/
+	virtual uint32 getModificationTime() const { return 0; }
 };
 
 
@@ -96,6 +96,10 @@ Common::SeekableReadStream *ChRootFilesystemNode::createReadStream() {
 	return _realNode->createReadStream();
 }
 
+Common::SeekableReadStream *ChRootFilesystemNode::createMappedReadStream() {
+	return _realNode->createMappedReadStream();
+}
+
 Common::WriteStream *ChRootFilesystemNode::createWriteStream() {
 	return _realNode->createWriteStream();
 }
@@ -104,6 +108,18 @@ bool ChRootFilesystemNode::createDirectory() {
 	return _realNode->createDirectory();
 }
 
+bool ChRootFilesystemNode::rename(const Common::String &newName) {
+	return _realNode->rename(newName);
+}
+
+bool ChRootFilesystemNode::remove() {
+	return _realNode->remove();
+}
+
+uint32 ChRootFilesystemNode::getModificationTime() const {
+	return _realNode->getModificationTime();
+}
+
 Common::String ChRootFilesystemNode::addPathComponent(const Common::String &path, const Common::String &component) {
 	const char sep = '/';
 	if (path.lastChar() == sep && component.firstChar() == sep) {
@@ -48,8 +48,12 @@ public:
 	virtual AbstractFSNode *getParent() const;
 
 	virtual Common::SeekableReadStream *createReadStream();
+	virtual Common::SeekableReadStream *createMappedReadStream();
 	virtual Common::WriteStream *createWriteStream();
 	virtual bool createDirectory();
+	virtual bool rename(const Common::String &newName);
+	virtual bool remove();
+	virtual uint32 getModificationTime() const;
 
 private:
 	static Common::String addPathComponent(const Common::String &path, const Common::String &component);
@@ -34,6 +34,7 @@
 
 #include "backends/fs/posix/posix-fs.h"
 #include "backends/fs/posix/posix-iostream.h"
+#include "backends/fs/posix/posix-mmapstream.h"
 #include "common/algorithm.h"
 
 #include <sys/param.h>
@@ -315,6 +316,15 @@ Common::SeekableReadStream *POSIXFilesystemNode::createReadStream() {
 	return PosixIoStream::makeFromPath(getPath(), false);
 }
 
+Common::SeekableReadStream *POSIXFilesystemNode::createMappedReadStream() {
+#ifdef USE_MMAP
+	Common::SeekableReadStream *stream = PosixMemoryMappedReadStream::makeFromPath(getPath());
+	if (stream)
+		return stream;
+#endif
+	return createReadStream();
+}
+
 Common::WriteStream *POSIXFilesystemNode::createWriteStream() {
 	return PosixIoStream::makeFromPath(getPath(), true);
 }
@@ -326,6 +336,32 @@ bool POSIXFilesystemNode::createDirectory() {
 	return _isValid && _isDirectory;
 }
 
+bool POSIXFilesystemNode::rename(const Common::String &newName) {
+	const char *start = _path.c_str();
+	const char *end = start + _path.size();
+	while (end > start && *(end-1) != '/')
+		end--;
+
+	const Common::String newPath = Common::String(start, end) + newName;
+	return ::rename(_path.c_str(), newPath.c_str()) == 0;
+}
+
+bool POSIXFilesystemNode::remove() {
+	if (::remove(_path.c_str()) != 0)
+		return false;
+
+	setFlags();
+	return true;
+}
+
+uint32 POSIXFilesystemNode::getModificationTime() const {
+	struct stat st;
+	if (stat(_path.c_str(), &st) != 0)
+		return 0;
+
+	return (uint32)st.st_mtime;
+}
+
 namespace Posix {
 
 bool assureDirectoryExists(const Common::String &dir, const char *prefix) {
@@ -67,8 +67,12 @@ public:
 	virtual AbstractFSNode *getParent() const;
 
 	virtual Common::SeekableReadStream *createReadStream();
+	virtual Common::SeekableReadStream *createMappedReadStream();
 	virtual Common::WriteStream *createWriteStream();
 	virtual bool createDirectory();
+	virtual bool rename(const Common::String &newName);
+	virtual bool remove();
+	virtual uint32 getModificationTime() const;
 
 protected:
 	/**
@@ -0,0 +1,63 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef BACKENDS_FS_POSIX_POSIXMMAPSTREAM_H
+#define BACKENDS_FS_POSIX_POSIXMMAPSTREAM_H
+
+#include "common/memstream.h"
+#include "common/str.h"
+
+/**
+ * A read stream on a memory mapped file, only available where configure
+ * found a working mmap() (USE_MMAP).
+ *
+ * Reads are plain copies out of the mapping, and getMappedData() gives
+ * direct access to the file contents. A file which shrinks while it is
+ * mapped makes reads crash instead of failing, so this is only used for
+ * game data opened with File::openMapped(), never for save or cache files.
+ */
+class PosixMemoryMappedReadStream : public Common::MemoryReadStream {
+public:
+	enum {
+		/** Smaller files are read with stdio, mapping them is not worth it */
+		kMinMappedSize = 64 * 1024
+	};
+
+	/**
+	 * Given a path, map the file if it is a regular file of at least
+	 * kMinMappedSize bytes.
+	 *
+	 * @return the new stream, or 0 if the file was not mapped. The caller
+	 *         is expected to fall back to a stdio stream then.
+	 */
+	static PosixMemoryMappedReadStream *makeFromPath(const Common::String &path);
+
+	~PosixMemoryMappedReadStream();
+
+private:
+	PosixMemoryMappedReadStream(void *data, uint32 size);
+
+	void *_mapping;
+	uint32 _mappingSize;
+};
+
+#endif
@@ -245,4 +245,35 @@ bool WindowsFilesystemNode::createDirectory() {
 	return _isValid && _isDirectory;
 }
 
+bool WindowsFilesystemNode::rename(const Common::String &newName) {
+	const Common::String newPath = _path.substr(0, _path.size() - _displayName.size()) + newName;
+
+	// toUnicode() returns a static buffer, so convert one path at a time
+#ifndef UNICODE
+	return MoveFileEx(_path.c_str(), newPath.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+	TCHAR oldPath[MAX_PATH];
+	MultiByteToWideChar(CP_ACP, 0, _path.c_str(), _path.size() + 1, oldPath, MAX_PATH);
+	return MoveFileEx(oldPath, toUnicode(newPath.c_str()), MOVEFILE_REPLACE_EXISTING) != 0;
+#endif
+}
+
+bool WindowsFilesystemNode::remove() {
+	if (DeleteFile(toUnicode(_path.c_str())) == 0)
+		return false;
+
+	setFlags();
+	return true;
+}
+
+uint32 WindowsFilesystemNode::getModificationTime() const {
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	if (GetFileAttributesEx(toUnicode(_path.c_str()), GetFileExInfoStandard, &data) == 0)
+		return 0;
+
+	// Convert the 100ns ticks since 1601 to seconds since 1970
+	uint64 ticks = ((uint64)data.ftLastWriteTime.dwHighDateTime << 32) | data.ftLastWriteTime.dwLowDateTime;
+	return (uint32)(ticks / 10000000 - 11644473600ULL);
+}
+
 #endif //#ifdef WIN32
@@ -81,6 +81,9 @@ public:
 	virtual Common::SeekableReadStream *createReadStream();
 	virtual Common::WriteStream *createWriteStream();
 	virtual bool createDirectory();
+	virtual bool rename(const Common::String &newName);
+	virtual bool remove();
+	virtual uint32 getModificationTime() const;
 
 private:
 	/**
@@ -0,0 +1,123 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "backends/graphics/headless/headless-graphics.h"
+
+#include "common/rect.h"
+#include "common/util.h"
+
+HeadlessGraphicsManager::HeadlessGraphicsManager()
+	: _overlayVisible(false), _screenChangeID(0), _frameCount(0), _frameChecksum(0),
+	_frameListener(nullptr) {
+	memset(_palette, 0, sizeof(_palette));
+	// The launcher runs before any initSize() call
+	_overlay.create(320, 200, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+}
+
+HeadlessGraphicsManager::~HeadlessGraphicsManager() {
+	_screen.free();
+	_overlay.free();
+}
+
+void HeadlessGraphicsManager::initSize(uint width, uint height, const Graphics::PixelFormat *format) {
+	NullGraphicsManager::initSize(width, height, format);
+
+	const Graphics::PixelFormat screenFormat = format ? *format : Graphics::PixelFormat::createFormatCLUT8();
+	if (width != _screen.w || height != _screen.h || screenFormat != _screen.format) {
+		_screen.create(width, height, screenFormat);
+		++_screenChangeID;
+	}
+
+	// The launcher and the global main menu need at least 320x200
+	const uint overlayWidth = MAX<uint>(width, 320);
+	const uint overlayHeight = MAX<uint>(height, 200);
+	if (overlayWidth != _overlay.w || overlayHeight != _overlay.h) {
+		// create() resets the format before reading it
+		const Graphics::PixelFormat overlayFormat = _overlay.format;
+		_overlay.create(overlayWidth, overlayHeight, overlayFormat);
+	}
+}
+
+void HeadlessGraphicsManager::setPalette(const byte *colors, uint start, uint num) {
+	assert(start + num <= 256);
+	memcpy(_palette + start * 3, colors, num * 3);
+}
+
+void HeadlessGraphicsManager::grabPalette(byte *colors, uint start, uint num) const {
+	assert(start + num <= 256);
+	memcpy(colors, _palette + start * 3, num * 3);
+}
+
+void HeadlessGraphicsManager::copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) {
+	_screen.copyRectToSurface(buf, pitch, x, y, w, h);
+}
+
+void HeadlessGraphicsManager::fillScreen(uint32 col) {
+	_screen.fillRect(Common::Rect(_screen.w, _screen.h), col);
+}
+
+void HeadlessGraphicsManager::updateScreen() {
+	++_frameCount;
+	_frameChecksum = computeChecksum();
+
+	if (_frameListener)
+		_frameListener->frameRendered(_frameChecksum);
+}
+
+void HeadlessGraphicsManager::clearOverlay() {
+	_overlay.fillRect(Common::Rect(_overlay.w, _overlay.h), 0);
+}
+
+void HeadlessGraphicsManager::grabOverlay(void *buf, int pitch) const {
+	const byte *src = (const byte *)_overlay.getPixels();
+	byte *dst = (byte *)buf;
+	for (int y = 0; y < _overlay.h; ++y) {
+		memcpy(dst, src, _overlay.w * _overlay.format.bytesPerPixel);
+		src += _overlay.pitch;
+		dst += pitch;
+	}
+}
+
+void HeadlessGraphicsManager::copyRectToOverlay(const void *buf, int pitch, int x, int y, int w, int h) {
+	_overlay.copyRectToSurface(buf, pitch, x, y, w, h);
+}
+
+uint32 HeadlessGraphicsManager::computeChecksum() const {
+	// 32 bit FNV-1a over the visible surface, and the palette for CLUT8
+	// screens, since it changes the picture without touching the pixels
+	const Graphics::Surface &surface = _overlayVisible ? _overlay : _screen;
+	uint32 hash = 2166136261u;
+
+	const byte *row = (const byte *)surface.getPixels();
+	const uint rowSize = surface.w * surface.format.bytesPerPixel;
+	for (int y = 0; y < surface.h; ++y, row += surface.pitch) {
+		for (uint x = 0; x < rowSize; ++x)
+			hash = (hash ^ row[x]) * 16777619u;
+	}
+
+	if (!_overlayVisible && surface.format.bytesPerPixel == 1) {
+		for (uint i = 0; i < sizeof(_palette); ++i)
+			hash = (hash ^ _palette[i]) * 16777619u;
+	}
+
+	return hash;
+}
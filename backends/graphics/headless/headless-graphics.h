@@ -0,0 +1,95 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef BACKENDS_GRAPHICS_HEADLESS_H
+#define BACKENDS_GRAPHICS_HEADLESS_H
+
+#include "backends/graphics/null/null-graphics.h"
+#include "graphics/surface.h"
+
+/**
+ * A graphics manager that keeps the game screen, palette and overlay in
+ * memory without displaying them, so that engines behave as they would
+ * with a real display. Every updateScreen() computes a checksum of the
+ * visible game screen, which can be used to check that a run rendered
+ * the same frames as an earlier one.
+ */
+class HeadlessGraphicsManager : public NullGraphicsManager {
+public:
+	/**
+	 * Gets notified of every frame after its checksum has been computed.
+	 */
+	class FrameListener {
+	public:
+		virtual ~FrameListener() {}
+		virtual void frameRendered(uint32 checksum) = 0;
+	};
+
+	HeadlessGraphicsManager();
+	virtual ~HeadlessGraphicsManager();
+
+	Graphics::PixelFormat getScreenFormat() const override { return _screen.format; }
+	void initSize(uint width, uint height, const Graphics::PixelFormat *format = NULL) override;
+	int getScreenChangeID() const override { return _screenChangeID; }
+
+	int16 getHeight() const override { return _screen.h; }
+	int16 getWidth() const override { return _screen.w; }
+	void setPalette(const byte *colors, uint start, uint num) override;
+	void grabPalette(byte *colors, uint start, uint num) const override;
+	void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) override;
+	Graphics::Surface *lockScreen() override { return &_screen; }
+	void unlockScreen() override {}
+	void fillScreen(uint32 col) override;
+	void updateScreen() override;
+
+	void showOverlay() override { _overlayVisible = true; }
+	void hideOverlay() override { _overlayVisible = false; }
+	Graphics::PixelFormat getOverlayFormat() const override { return _overlay.format; }
+	void clearOverlay() override;
+	void grabOverlay(void *buf, int pitch) const override;
+	void copyRectToOverlay(const void *buf, int pitch, int x, int y, int w, int h) override;
+	int16 getOverlayHeight() const override { return _overlay.h; }
+	int16 getOverlayWidth() const override { return _overlay.w; }
+
+	/** The number of times updateScreen() has been called. */
+	uint32 getFrameCount() const { return _frameCount; }
+
+	/** The checksum of the screen computed by the last updateScreen(). */
+	uint32 getFrameChecksum() const { return _frameChecksum; }
+
+	void setFrameListener(FrameListener *listener) { _frameListener = listener; }
+
+private:
+	uint32 computeChecksum() const;
+
+	Graphics::Surface _screen;
+	Graphics::Surface _overlay;
+	byte _palette[256 * 3];
+	bool _overlayVisible;
+	int _screenChangeID;
+
+	uint32 _frameCount;
+	uint32 _frameChecksum;
+	FrameListener *_frameListener;
+};
+
+#endif
@@ -33,6 +33,7 @@
 #include "common/translation.h"
 #include "common/algorithm.h"
 #include "common/file.h"
+#include "common/profiler.h"
 #include "gui/debugger.h"
 #include "engines/engine.h"
 #ifdef USE_OSD
@@ -464,6 +465,8 @@ void OpenGLGraphicsManager::updateScreen() {
 		return;
 	}
 
+	PROFILE_ZONE("OpenGLGraphicsManager::updateScreen");
+
 #ifdef USE_OSD
 	if (_osdMessageChangeRequest) {
 		osdMessageUpdateSurface();
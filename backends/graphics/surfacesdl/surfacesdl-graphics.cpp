@@ -27,6 +27,7 @@
 #include "backends/events/sdl/sdl-events.h"
 #include "common/config-manager.h"
 #include "common/mutex.h"
+#include "common/profiler.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
 #include "common/util.h"
@@ -1138,6 +1139,8 @@ bool SurfaceSdlGraphicsManager::hotswapGFXMode() {
 void SurfaceSdlGraphicsManager::updateScreen() {
 	assert(_transactionMode == kTransactionNone);
 
+	PROFILE_ZONE("SurfaceSdlGraphicsManager::updateScreen");
+
 	Common::StackLock lock(_graphicsMutex);	// Lock the mutex until this function ends
 
 	internUpdateScreen();
@@ -27,6 +27,7 @@
 #include "gui/EventRecorder.h"
 
 #include "audio/mixer.h"
+#include "common/profiler.h"
 #include "common/timer.h"
 #include "graphics/pixelformat.h"
 
@@ -180,6 +181,9 @@ void ModularBackend::fillScreen(uint32 col) {
 }
 
 void ModularBackend::updateScreen() {
+	// Engines update the screen once per frame
+	PROFILE_FRAME();
+
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.preDrawOverlayGui();
 #endif
@@ -271,6 +275,41 @@ void ModularBackend::deleteMutex(MutexRef mutex) {
 	_mutexManager->deleteMutex(mutex);
 }
 
+OSystem::ThreadRef ModularBackend::createThread(ThreadProc proc, void *param) {
+	assert(_mutexManager);
+	return _mutexManager->createThread(proc, param);
+}
+
+void ModularBackend::joinThread(ThreadRef thread) {
+	assert(_mutexManager);
+	_mutexManager->joinThread(thread);
+}
+
+OSystem::ConditionRef ModularBackend::createCondition() {
+	assert(_mutexManager);
+	return _mutexManager->createCondition();
+}
+
+void ModularBackend::waitCondition(ConditionRef cond, MutexRef mutex) {
+	assert(_mutexManager);
+	_mutexManager->waitCondition(cond, mutex);
+}
+
+void ModularBackend::signalCondition(ConditionRef cond) {
+	assert(_mutexManager);
+	_mutexManager->signalCondition(cond);
+}
+
+void ModularBackend::broadcastCondition(ConditionRef cond) {
+	assert(_mutexManager);
+	_mutexManager->broadcastCondition(cond);
+}
+
+void ModularBackend::deleteCondition(ConditionRef cond) {
+	assert(_mutexManager);
+	_mutexManager->deleteCondition(cond);
+}
+
 Audio::Mixer *ModularBackend::getMixer() {
 	assert(_mixer);
 	return (Audio::Mixer *)_mixer;
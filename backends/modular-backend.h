@@ -125,6 +125,19 @@ public:
 
 	//@}
 
+	/** @name Thread handling */
+	//@{
+
+	virtual ThreadRef createThread(ThreadProc proc, void *param) override final;
+	virtual void joinThread(ThreadRef thread) override final;
+	virtual ConditionRef createCondition() override final;
+	virtual void waitCondition(ConditionRef cond, MutexRef mutex) override final;
+	virtual void signalCondition(ConditionRef cond) override final;
+	virtual void broadcastCondition(ConditionRef cond) override final;
+	virtual void deleteCondition(ConditionRef cond) override final;
+
+	//@}
+
 	/** @name Sound */
 	//@{
 
@@ -38,6 +38,16 @@ public:
 	virtual void lockMutex(OSystem::MutexRef mutex) = 0;
 	virtual void unlockMutex(OSystem::MutexRef mutex) = 0;
 	virtual void deleteMutex(OSystem::MutexRef mutex) = 0;
+
+	// Threads and conditions are optional, the defaults describe a
+	// backend without thread support.
+	virtual OSystem::ThreadRef createThread(OSystem::ThreadProc proc, void *param) { return 0; }
+	virtual void joinThread(OSystem::ThreadRef thread) {}
+	virtual OSystem::ConditionRef createCondition() { return 0; }
+	virtual void waitCondition(OSystem::ConditionRef cond, OSystem::MutexRef mutex) {}
+	virtual void signalCondition(OSystem::ConditionRef cond) {}
+	virtual void broadcastCondition(OSystem::ConditionRef cond) {}
+	virtual void deleteCondition(OSystem::ConditionRef cond) {}
 };
 
 #endif
@@ -67,4 +67,82 @@ void PthreadMutexManager::deleteMutex(OSystem::MutexRef mutex) {
 		delete m;
 }
 
+namespace {
+
+struct PthreadStart {
+	OSystem::ThreadProc proc;
+	void *param;
+};
+
+void *pthreadProc(void *data) {
+	PthreadStart start = *(PthreadStart *)data;
+	delete (PthreadStart *)data;
+
+	start.proc(start.param);
+	return nullptr;
+}
+
+} // End of anonymous namespace
+
+OSystem::ThreadRef PthreadMutexManager::createThread(OSystem::ThreadProc proc, void *param) {
+	PthreadStart *start = new PthreadStart;
+	start->proc = proc;
+	start->param = param;
+
+	pthread_t *thread = new pthread_t;
+
+	if (pthread_create(thread, nullptr, pthreadProc, start) != 0) {
+		warning("pthread_create() failed");
+		delete start;
+		delete thread;
+		return nullptr;
+	}
+
+	return (OSystem::ThreadRef)thread;
+}
+
+void PthreadMutexManager::joinThread(OSystem::ThreadRef thread) {
+	pthread_t *t = (pthread_t *)thread;
+
+	if (pthread_join(*t, nullptr) != 0)
+		warning("pthread_join() failed");
+	delete t;
+}
+
+OSystem::ConditionRef PthreadMutexManager::createCondition() {
+	pthread_cond_t *cond = new pthread_cond_t;
+
+	if (pthread_cond_init(cond, nullptr) != 0) {
+		warning("pthread_cond_init() failed");
+		delete cond;
+		return nullptr;
+	}
+
+	return (OSystem::ConditionRef)cond;
+}
+
+void PthreadMutexManager::waitCondition(OSystem::ConditionRef cond, OSystem::MutexRef mutex) {
+	if (pthread_cond_wait((pthread_cond_t *)cond, (pthread_mutex_t *)mutex) != 0)
+		warning("pthread_cond_wait() failed");
+}
+
+void PthreadMutexManager::signalCondition(OSystem::ConditionRef cond) {
+	if (pthread_cond_signal((pthread_cond_t *)cond) != 0)
+		warning("pthread_cond_signal() failed");
+}
+
+void PthreadMutexManager::broadcastCondition(OSystem::ConditionRef cond) {
+	if (pthread_cond_broadcast((pthread_cond_t *)cond) != 0)
+		warning("pthread_cond_broadcast() failed");
+}
+
+void PthreadMutexManager::deleteCondition(OSystem::ConditionRef cond) {
+	pthread_cond_t *c = (pthread_cond_t *)cond;
+
+	if (pthread_cond_destroy(c) != 0)
+		warning("pthread_cond_destroy() failed");
+	else
+		delete c;
+}
+
 #endif
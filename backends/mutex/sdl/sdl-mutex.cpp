@@ -27,6 +27,8 @@
 #include "backends/mutex/sdl/sdl-mutex.h"
 #include "backends/platform/sdl/sdl-sys.h"
 
+#include "common/textconsole.h"
+
 
 OSystem::MutexRef SdlMutexManager::createMutex() {
 	return (OSystem::MutexRef) SDL_CreateMutex();
@@ -44,4 +46,63 @@ void SdlMutexManager::deleteMutex(OSystem::MutexRef mutex) {
 	SDL_DestroyMutex((SDL_mutex *)mutex);
 }
 
+namespace {
+
+struct SdlThreadStart {
+	OSystem::ThreadProc proc;
+	void *param;
+};
+
+int SDLCALL sdlThreadProc(void *data) {
+	SdlThreadStart start = *(SdlThreadStart *)data;
+	delete (SdlThreadStart *)data;
+
+	start.proc(start.param);
+	return 0;
+}
+
+} // End of anonymous namespace
+
+OSystem::ThreadRef SdlMutexManager::createThread(OSystem::ThreadProc proc, void *param) {
+	SdlThreadStart *start = new SdlThreadStart;
+	start->proc = proc;
+	start->param = param;
+
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	SDL_Thread *thread = SDL_CreateThread(sdlThreadProc, "ScummVM worker", start);
+#else
+	SDL_Thread *thread = SDL_CreateThread(sdlThreadProc, start);
+#endif
+	if (!thread) {
+		warning("SDL_CreateThread() failed: %s", SDL_GetError());
+		delete start;
+	}
+
+	return (OSystem::ThreadRef)thread;
+}
+
+void SdlMutexManager::joinThread(OSystem::ThreadRef thread) {
+	SDL_WaitThread((SDL_Thread *)thread, nullptr);
+}
+
+OSystem::ConditionRef SdlMutexManager::createCondition() {
+	return (OSystem::ConditionRef)SDL_CreateCond();
+}
+
+void SdlMutexManager::waitCondition(OSystem::ConditionRef cond, OSystem::MutexRef mutex) {
+	SDL_CondWait((SDL_cond *)cond, (SDL_mutex *)mutex);
+}
+
+void SdlMutexManager::signalCondition(OSystem::ConditionRef cond) {
+	SDL_CondSignal((SDL_cond *)cond);
+}
+
+void SdlMutexManager::broadcastCondition(OSystem::ConditionRef cond) {
+	SDL_CondBroadcast((SDL_cond *)cond);
+}
+
+void SdlMutexManager::deleteCondition(OSystem::ConditionRef cond) {
+	SDL_DestroyCond((SDL_cond *)cond);
+}
+
 #endif
@@ -0,0 +1,244 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifdef POSIX
+#include <sys/time.h>
+#endif
+
+#define FORBIDDEN_SYMBOL_EXCEPTION_time_h
+
+#include "backends/platform/null/benchmark.h"
+#include "backends/timer/default/default-timer.h"
+#include "audio/mixer_intern.h"
+#include "common/algorithm.h"
+#include "common/config-manager.h"
+#include "common/debug.h"
+#include "common/random.h"
+#include "common/system.h"
+
+enum {
+	// The virtual clock advances in steps of this many milliseconds, so
+	// that timers and audio interleave with the game as they would in
+	// real time
+	kTimeStep = 10,
+	// The number of stereo samples mixed per mixer callback
+	kMixSamples = 1024
+};
+
+static uint64 getWallMicros() {
+#ifdef POSIX
+	timeval now;
+	gettimeofday(&now, 0);
+	return (uint64)now.tv_sec * 1000000 + now.tv_usec;
+#else
+	return (uint64)g_system->getMillis(true) * 1000;
+#endif
+}
+
+NullBenchmark *NullBenchmark::_activeReplay = nullptr;
+
+NullBenchmark::NullBenchmark(HeadlessGraphicsManager *graphicsManager, Audio::MixerImpl *mixer, DefaultTimerManager *timerManager)
+	: _graphicsManager(graphicsManager), _mixer(mixer), _timerManager(timerManager),
+	  _virtualMillis(0), _delayedSincePoll(false), _running(false), _quitSent(false), _frameLimit(0),
+	  _replay(nullptr), _replayStart(0), _replayEnd(0), _replayDone(true),
+	  _mixedSamples(0), _mixMicros(0),
+	  _startMicros(0), _lastFrameMicros(0), _lastChecksum(0), _combinedChecksum(2166136261u) {
+	_mixBuffer = new byte[kMixSamples * 4];
+	_graphicsManager->setFrameListener(this);
+}
+
+NullBenchmark::~NullBenchmark() {
+	_graphicsManager->setFrameListener(nullptr);
+
+	if (_activeReplay == this) {
+		Common::RandomSource::setSeedProvider(nullptr);
+		_activeReplay = nullptr;
+	}
+	delete _replay;
+	delete[] _mixBuffer;
+}
+
+bool NullBenchmark::openReplay(const Common::String &fileName) {
+	_replay = new Common::PlaybackFile();
+	if (!_replay->openRead(fileName)) {
+		delete _replay;
+		_replay = nullptr;
+		return false;
+	}
+
+	const Common::StringMap &settings = _replay->getHeader().settingsRecords;
+	for (Common::StringMap::const_iterator i = settings.begin(); i != settings.end(); ++i)
+		ConfMan.set(i->_key, i->_value, Common::ConfigManager::kTransientDomain);
+
+	_activeReplay = this;
+	Common::RandomSource::setSeedProvider(&provideRandomSeed);
+	return true;
+}
+
+bool NullBenchmark::provideRandomSeed(const Common::String &name, uint32 &seed) {
+	if (!_activeReplay || !_activeReplay->_replay->getHeader().randomSourceRecords.contains(name))
+		return false;
+
+	seed = _activeReplay->_replay->getHeader().randomSourceRecords[name];
+	return true;
+}
+
+void NullBenchmark::delayMillis(uint msecs) {
+	if (msecs)
+		_delayedSincePoll = true;
+
+	while (msecs) {
+		const uint step = MIN<uint>(msecs, kTimeStep);
+		_virtualMillis += step;
+		msecs -= step;
+
+		_timerManager->handler();
+		mixAudio();
+	}
+}
+
+void NullBenchmark::mixAudio() {
+	const uint64 target = (uint64)_virtualMillis * _mixer->getOutputRate() / 1000;
+
+	while (_mixedSamples < target) {
+		const uint samples = (uint)MIN<uint64>(target - _mixedSamples, kMixSamples);
+
+		const uint64 start = getWallMicros();
+		_mixer->mixCallback(_mixBuffer, samples * 4);
+		_mixMicros += getWallMicros() - start;
+		_mixedSamples += samples;
+	}
+}
+
+void NullBenchmark::readNextEvent() {
+	// Timer events only tell how long the recording lasted; the virtual
+	// clock replaces them
+	for (;;) {
+		_nextEvent = _replay->getNextEvent();
+		if (_nextEvent.recordedtype != Common::kRecorderEventTypeTimer)
+			break;
+		_replayEnd = MAX(_replayEnd, _nextEvent.time);
+	}
+
+	if (_nextEvent.type == Common::EVENT_INVALID)
+		_replayDone = true;
+}
+
+bool NullBenchmark::pollEvent(Common::Event &event) {
+	if (!_running)
+		return false;
+
+	const uint32 replayTime = _virtualMillis - _replayStart;
+
+	if (!_replayDone && replayTime >= _nextEvent.time) {
+		event = _nextEvent;
+		readNextEvent();
+		return true;
+	}
+
+	const bool replayFinished = _replay && _replayDone && replayTime >= _replayEnd;
+	const bool frameLimitReached = _frameLimit && (uint32)_frameMicros.size() + 1 >= _frameLimit;
+	if ((replayFinished || frameLimitReached) && !_quitSent) {
+		_quitSent = true;
+		event.type = Common::EVENT_QUIT;
+		return true;
+	}
+
+	// Keep the clock moving for engines that wait for it to advance
+	// without ever calling delayMillis()
+	if (!_delayedSincePoll)
+		delayMillis(1);
+	_delayedSincePoll = false;
+
+	return false;
+}
+
+void NullBenchmark::engineInit() {
+	_running = true;
+	_quitSent = false;
+	_replayStart = _virtualMillis;
+
+	_mixedSamples = (uint64)_virtualMillis * _mixer->getOutputRate() / 1000;
+	_mixMicros = 0;
+	_frameMicros.clear();
+	_lastChecksum = 0;
+	_combinedChecksum = 2166136261u;
+	_startMicros = getWallMicros();
+	_lastFrameMicros = 0;
+
+	if (_replay) {
+		_replayDone = false;
+		readNextEvent();
+	}
+}
+
+void NullBenchmark::engineDone() {
+	if (!_running)
+		return;
+
+	_running = false;
+	logReport();
+}
+
+void NullBenchmark::frameRendered(uint32 checksum) {
+	if (!_running)
+		return;
+
+	const uint64 now = getWallMicros();
+	if (_lastFrameMicros)
+		_frameMicros.push_back((uint32)(now - _lastFrameMicros));
+	_lastFrameMicros = now;
+
+	_lastChecksum = checksum;
+	for (int i = 0; i < 4; ++i)
+		_combinedChecksum = (_combinedChecksum ^ ((checksum >> (i * 8)) & 0xFF)) * 16777619u;
+
+	debug(1, "benchmark: frame %u at %u ms, checksum %08x", _graphicsManager->getFrameCount(), _virtualMillis - _replayStart, checksum);
+}
+
+void NullBenchmark::logReport() {
+	const double wallSeconds = (getWallMicros() - _startMicros) / 1000000.0;
+	const double virtualSeconds = (_virtualMillis - _replayStart) / 1000.0;
+	const uint32 frames = _frameMicros.size() + (_lastFrameMicros ? 1 : 0);
+
+	Common::String report = Common::String::format("benchmark: %u frames in %.2f s, %.2f s of game time, %.1f frames per second\n",
+	                                               frames, wallSeconds, virtualSeconds, wallSeconds > 0 ? frames / wallSeconds : 0.0);
+
+	if (!_frameMicros.empty()) {
+		Common::Array<uint32> sorted = _frameMicros;
+		Common::sort(sorted.begin(), sorted.end());
+		const uint last = sorted.size() - 1;
+		report += Common::String::format("benchmark: frame time p50 %.2f ms, p90 %.2f ms, p99 %.2f ms, max %.2f ms\n",
+		                                 sorted[last * 50 / 100] / 1000.0, sorted[last * 90 / 100] / 1000.0,
+		                                 sorted[last * 99 / 100] / 1000.0, sorted[last] / 1000.0);
+	}
+
+	const double audioSeconds = (double)_mixedSamples / _mixer->getOutputRate() - (double)_replayStart / 1000;
+	report += Common::String::format("benchmark: mixed %.2f s of audio in %.2f ms (%.3f%% of real time)\n",
+	                                 audioSeconds, _mixMicros / 1000.0,
+	                                 audioSeconds > 0 ? _mixMicros / (audioSeconds * 10000.0) : 0.0);
+
+	report += Common::String::format("benchmark: last screen checksum %08x, checksum of all frames %08x\n",
+	                                 _lastChecksum, _combinedChecksum);
+
+	g_system->logMessage(LogMessageType::kInfo, report.c_str());
+}
@@ -0,0 +1,125 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef BACKENDS_PLATFORM_NULL_BENCHMARK_H
+#define BACKENDS_PLATFORM_NULL_BENCHMARK_H
+
+#include "backends/graphics/headless/headless-graphics.h"
+#include "common/array.h"
+#include "common/recorderfile.h"
+#include "common/str.h"
+
+class DefaultTimerManager;
+
+namespace Audio {
+class MixerImpl;
+}
+
+/**
+ * The benchmark mode of the null backend.
+ *
+ * The backend runs on a virtual clock: delays advance the clock without
+ * sleeping, and the timers and the mixer are driven from it, so that a
+ * game runs as fast as the machine allows and the same input always
+ * gives the same output. Audio is mixed into a scratch buffer and thrown
+ * away.
+ *
+ * Optionally, the input events of a recording made with the event
+ * recorder are replayed at the times they were recorded. The recorded
+ * random seeds and settings are applied as well; save games stored in
+ * the recording are not.
+ *
+ * When the engine is done, a report with the frame time percentiles,
+ * the cost of mixing the audio and the screen checksums is logged.
+ */
+class NullBenchmark : public HeadlessGraphicsManager::FrameListener {
+public:
+	NullBenchmark(HeadlessGraphicsManager *graphicsManager, Audio::MixerImpl *mixer, DefaultTimerManager *timerManager);
+	~NullBenchmark();
+
+	/**
+	 * Open a recording to replay. Its settings are applied right away,
+	 * its events are replayed once the engine runs.
+	 */
+	bool openReplay(const Common::String &fileName);
+
+	/**
+	 * Quit after the given number of frames have been rendered, 0 for no
+	 * limit.
+	 */
+	void setFrameLimit(uint32 frames) { _frameLimit = frames; }
+
+	uint32 getMillis() const { return _virtualMillis; }
+
+	/**
+	 * Advance the virtual clock, running the timers and mixing the audio
+	 * for the time that has passed.
+	 */
+	void delayMillis(uint msecs);
+
+	/**
+	 * Get the next replayed event, or a quit event when the replay or the
+	 * frame limit has been reached.
+	 */
+	bool pollEvent(Common::Event &event);
+
+	void engineInit();
+	void engineDone();
+
+	void frameRendered(uint32 checksum) override;
+
+private:
+	void mixAudio();
+	void readNextEvent();
+	void logReport();
+	static bool provideRandomSeed(const Common::String &name, uint32 &seed);
+
+	HeadlessGraphicsManager *_graphicsManager;
+	Audio::MixerImpl *_mixer;
+	DefaultTimerManager *_timerManager;
+
+	uint32 _virtualMillis;
+	bool _delayedSincePoll;
+	bool _running;
+	bool _quitSent;
+	uint32 _frameLimit;
+
+	Common::PlaybackFile *_replay;
+	Common::RecorderEvent _nextEvent;
+	uint32 _replayStart;
+	uint32 _replayEnd;
+	bool _replayDone;
+
+	byte *_mixBuffer;
+	uint64 _mixedSamples;
+	uint64 _mixMicros;
+
+	uint64 _startMicros;
+	uint64 _lastFrameMicros;
+	Common::Array<uint32> _frameMicros;
+	uint32 _lastChecksum;
+	uint32 _combinedChecksum;
+
+	static NullBenchmark *_activeReplay;
+};
+
+#endif
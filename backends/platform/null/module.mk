@@ -1,6 +1,7 @@
 MODULE := backends/platform/null
 
 MODULE_OBJS := \
+	benchmark.o \
 	null.o
 
 # We don't use rules.mk but rather manually update OBJS and MODULE_DIRS.
@@ -46,7 +46,10 @@
 #include "backends/events/default/default-events.h"
 #include "backends/mutex/null/null-mutex.h"
 #include "backends/graphics/null/null-graphics.h"
+#include "backends/graphics/headless/headless-graphics.h"
+#include "backends/platform/null/benchmark.h"
 #include "audio/mixer_intern.h"
+#include "common/config-manager.h"
 #include "common/scummsys.h"
 #include "gui/debugger.h"
 
@@ -77,17 +80,22 @@ public:
 	virtual void delayMillis(uint msecs);
 	virtual void getTimeAndDate(TimeDate &t) const;
 
+	virtual void engineInit();
+	virtual void engineDone();
+
 	virtual void quit();
 
 	virtual void logMessage(LogMessageType::Type type, const char *message);
 
-#ifdef POSIX
 private:
+	NullBenchmark *_benchmark;
+
+#ifdef POSIX
 	timeval _startTime;
 #endif
 };
 
-OSystem_NULL::OSystem_NULL() {
+OSystem_NULL::OSystem_NULL() : _benchmark(nullptr) {
 	#if defined(__amigaos4__)
 		_fsFactory = new AmigaOSFilesystemFactory();
 	#elif defined(POSIX)
@@ -102,6 +110,7 @@ OSystem_NULL::OSystem_NULL() {
 }
 
 OSystem_NULL::~OSystem_NULL() {
+	delete _benchmark;
 }
 
 #ifdef POSIX
@@ -126,14 +135,33 @@ void OSystem_NULL::initBackend() {
 	_timerManager = new DefaultTimerManager();
 	_eventManager = new DefaultEventManager(this);
 	_savefileManager = new DefaultSaveFileManager();
-	_graphicsManager = new NullGraphicsManager();
-	_mixer = new Audio::MixerImpl(22050);
 
-	((Audio::MixerImpl *)_mixer)->setReady(false);
-
-	// Note that the mixer is useless this way; it needs to be hooked
-	// into the system somehow to be functional. Of course, can't do
-	// that in a NULL backend :).
+	const Common::String replay = ConfMan.get("benchmark_replay");
+	if (ConfMan.getBool("benchmark") || !replay.empty()) {
+		// In benchmark mode the screen is kept and checksummed, and the
+		// mixer is driven from the virtual clock of the benchmark
+		HeadlessGraphicsManager *graphicsManager = new HeadlessGraphicsManager();
+		_graphicsManager = graphicsManager;
+
+		const uint outputRate = ConfMan.hasKey("output_rate") ? ConfMan.getInt("output_rate") : 0;
+		Audio::MixerImpl *mixer = new Audio::MixerImpl(outputRate ? outputRate : 44100);
+		_mixer = mixer;
+		mixer->setReady(true);
+
+		_benchmark = new NullBenchmark(graphicsManager, mixer, (DefaultTimerManager *)_timerManager);
+		if (!replay.empty() && !_benchmark->openReplay(replay))
+			error("Could not open the recording '%s' to replay", replay.c_str());
+		_benchmark->setFrameLimit(ConfMan.getInt("benchmark_frames"));
+	} else {
+		_graphicsManager = new NullGraphicsManager();
+		_mixer = new Audio::MixerImpl(22050);
+
+		((Audio::MixerImpl *)_mixer)->setReady(false);
+
+		// Note that the mixer is useless this way; it needs to be hooked
+		// into the system somehow to be functional. Of course, can't do
+		// that in a NULL backend :).
+	}
 
 	ModularBackend::initBackend();
 }
@@ -141,6 +169,9 @@ void OSystem_NULL::initBackend() {
 bool OSystem_NULL::pollEvent(Common::Event &event) {
 	((DefaultTimerManager *)getTimerManager())->checkTimers();
 
+	if (_benchmark && _benchmark->pollEvent(event))
+		return true;
+
 #ifdef POSIX
 	if (intReceived) {
 		intReceived = false;
@@ -163,6 +194,9 @@ bool OSystem_NULL::pollEvent(Common::Event &event) {
 }
 
 uint32 OSystem_NULL::getMillis(bool skipRecord) {
+	if (_benchmark)
+		return _benchmark->getMillis();
+
 #ifdef POSIX
 	timeval curTime;
 
@@ -176,6 +210,11 @@ uint32 OSystem_NULL::getMillis(bool skipRecord) {
 }
 
 void OSystem_NULL::delayMillis(uint msecs) {
+	if (_benchmark) {
+		_benchmark->delayMillis(msecs);
+		return;
+	}
+
 #ifdef POSIX
 	usleep(msecs * 1000);
 #endif
@@ -193,6 +232,16 @@ void OSystem_NULL::getTimeAndDate(TimeDate &td) const {
 	td.tm_wday = t.tm_wday;
 }
 
+void OSystem_NULL::engineInit() {
+	if (_benchmark)
+		_benchmark->engineInit();
+}
+
+void OSystem_NULL::engineDone() {
+	if (_benchmark)
+		_benchmark->engineDone();
+}
+
 void OSystem_NULL::quit() {
 	exit(0);
 }
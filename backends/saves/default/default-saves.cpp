@@ -179,6 +179,19 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 	return result;
 }
 
+uint32 DefaultSaveFileManager::getModificationTime(const Common::String &filename) {
+	// Assure the savefile name cache is up-to-date.
+	assureCached(getSavePath());
+	if (getError().getCode() != Common::kNoError)
+		return 0;
+
+	SaveFileCache::const_iterator file = _saveFileCache.find(filename);
+	if (file == _saveFileCache.end())
+		return 0;
+
+	return file->_value.getModificationTime();
+}
+
 bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
@@ -44,6 +44,7 @@ public:
 	virtual Common::InSaveFile *openForLoading(const Common::String &filename);
 	virtual Common::OutSaveFile *openForSaving(const Common::String &filename, bool compress = true);
 	virtual bool removeSavefile(const Common::String &filename);
+	virtual uint32 getModificationTime(const Common::String &filename);
 
 #ifdef USE_LIBCURL
 
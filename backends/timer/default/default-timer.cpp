@@ -22,6 +22,7 @@
 
 #include "common/scummsys.h"
 #include "backends/timer/default/default-timer.h"
+#include "common/profiler.h"
 #include "common/util.h"
 #include "common/system.h"
 
@@ -31,92 +32,180 @@ struct TimerSlot {
 	Common::String id;
 	uint32 interval;	// in microseconds
 
-	uint32 nextFireTime;	// in milliseconds
-	uint32 nextFireTimeMicro;	// microseconds part of nextFire
+	uint64 nextFireTime;	// in microseconds
+	uint32 sequence;	// orders slots with the same fire time
+	uint heapIndex;
 
-	TimerSlot *next;
+	// Profiling, in microseconds
+	uint32 calls;
+	uint64 totalTime;
+	uint32 maxTime;
+	uint64 totalLateness;
+	uint32 maxLateness;
 
-	TimerSlot() : callback(nullptr), refCon(nullptr), interval(0), nextFireTime(0), nextFireTimeMicro(0), next(nullptr) {}
-};
-
-void insertPrioQueue(TimerSlot *head, TimerSlot *newSlot) {
-	// The head points to a fake anchor TimerSlot; this common
-	// trick allows us to get rid of many special cases.
+	TimerSlot() : callback(nullptr), refCon(nullptr), interval(0), nextFireTime(0), sequence(0), heapIndex(0) {
+		resetStats();
+	}
 
-	const uint32 nextFireTime = newSlot->nextFireTime;
-	TimerSlot *slot = head;
-	newSlot->next = 0;
+	void resetStats() {
+		calls = 0;
+		totalTime = 0;
+		maxTime = 0;
+		totalLateness = 0;
+		maxLateness = 0;
+	}
 
-	// Insert the new slot into the sorted list of already scheduled
-	// timers in such a way that the list stays sorted...
-	while (true) {
-		assert(slot);
-		if (slot->next == 0 || nextFireTime < slot->next->nextFireTime) {
-			newSlot->next = slot->next;
-			slot->next = newSlot;
-			return;
-		}
-		slot = slot->next;
+	bool firesBefore(const TimerSlot *other) const {
+		if (nextFireTime != other->nextFireTime)
+			return nextFireTime < other->nextFireTime;
+		return (int32)(sequence - other->sequence) < 0;
 	}
-}
+};
 
 
 DefaultTimerManager::DefaultTimerManager() :
-	_timerCallbackNext(0),
-	_head(0) {
-
-	_head = new TimerSlot();
+	_runningSlot(nullptr),
+	_clock(0),
+	_lastMillis(0),
+	_sequence(0),
+	_profiling(false),
+	_timerCallbackNext(0) {
+
+	_lastMillis = g_system->getMillis(true);
 }
 
 DefaultTimerManager::~DefaultTimerManager() {
 	Common::StackLock lock(_mutex);
 
-	TimerSlot *slot = _head;
-	while (slot) {
-		TimerSlot *next = slot->next;
-		delete slot;
-		slot = next;
+	for (uint i = 0; i < _heap.size(); ++i)
+		delete _heap[i];
+	_heap.clear();
+}
+
+uint64 DefaultTimerManager::updateClock(uint32 millis) {
+	// getMillis() wraps after 49 days. Extend it to 64 bits, ignoring
+	// small steps back in time.
+	uint32 elapsed = millis - _lastMillis;
+	if (elapsed < 0x80000000) {
+		_clock += elapsed;
+		_lastMillis = millis;
+	}
+	return _clock * 1000;
+}
+
+void DefaultTimerManager::siftUp(uint index) {
+	TimerSlot *slot = _heap[index];
+	while (index > 0) {
+		uint parent = (index - 1) / 2;
+		if (!slot->firesBefore(_heap[parent]))
+			break;
+		_heap[index] = _heap[parent];
+		_heap[index]->heapIndex = index;
+		index = parent;
+	}
+	_heap[index] = slot;
+	slot->heapIndex = index;
+}
+
+void DefaultTimerManager::siftDown(uint index) {
+	TimerSlot *slot = _heap[index];
+	const uint size = _heap.size();
+	while (true) {
+		uint child = index * 2 + 1;
+		if (child >= size)
+			break;
+		if (child + 1 < size && _heap[child + 1]->firesBefore(_heap[child]))
+			++child;
+		if (!_heap[child]->firesBefore(slot))
+			break;
+		_heap[index] = _heap[child];
+		_heap[index]->heapIndex = index;
+		index = child;
+	}
+	_heap[index] = slot;
+	slot->heapIndex = index;
+}
+
+void DefaultTimerManager::pushSlot(TimerSlot *slot) {
+	slot->sequence = _sequence++;
+	_heap.push_back(slot);
+	siftUp(_heap.size() - 1);
+}
+
+void DefaultTimerManager::removeSlot(uint index) {
+	TimerSlot *last = _heap.back();
+	_heap.pop_back();
+	if (index < _heap.size()) {
+		_heap[index] = last;
+		last->heapIndex = index;
+		siftUp(index);
+		siftDown(last->heapIndex);
 	}
-	_head = 0;
 }
 
 void DefaultTimerManager::handler() {
-	Common::StackLock lock(_mutex);
+	// Callbacks are invoked without holding _mutex, so they can install
+	// and remove timers and the main thread is not blocked by them.
+	// removeTimerProc() waits on _callbackMutex if the callback it
+	// removes is running.
+	Common::StackLock callbackLock(_callbackMutex);
 
-	uint32 curTime = g_system->getMillis(true);
+	PROFILE_THREAD_NAME("timer");
+	PROFILE_ZONE("DefaultTimerManager::handler");
 
-	// On slow systems this could still be run after destructor
-	if (!_head)
-		return;
+	_mutex.lock();
+	const uint64 curTime = updateClock(g_system->getMillis(true));
 
 	// Repeat as long as there is a TimerSlot that is scheduled to fire.
-	TimerSlot *slot = _head->next;
-	while (slot && slot->nextFireTime < curTime) {
-		// Remove the slot from the priority queue
-		_head->next = slot->next;
+	while (!_heap.empty() && _heap[0]->nextFireTime < curTime) {
+		TimerSlot *slot = _heap[0];
 
-		// Update the fire time and reinsert the TimerSlot into the priority
-		// queue.
+		// Update the fire time and move the TimerSlot to its new place in
+		// the heap. The fire time advances by exactly one interval, so the
+		// timer does not drift.
 		assert(slot->interval > 0);
-		slot->nextFireTime += (slot->interval / 1000);
-		slot->nextFireTimeMicro += (slot->interval % 1000);
-		if (slot->nextFireTimeMicro > 1000) {
-			slot->nextFireTime += slot->nextFireTimeMicro / 1000;
-			slot->nextFireTimeMicro %= 1000;
-		}
-		insertPrioQueue(_head, slot);
+		const uint64 scheduledTime = slot->nextFireTime;
+		slot->nextFireTime += slot->interval;
+		slot->sequence = _sequence++;
+		siftDown(0);
 
 		// Invoke the timer callback
 		assert(slot->callback);
-		slot->callback(slot->refCon);
+		TimerProc callback = slot->callback;
+		void *refCon = slot->refCon;
+		_runningSlot = slot;
+		_mutex.unlock();
+
+		PROFILE_ZONE("timer callback");
+		if (_profiling) {
+			// Most callbacks return within a millisecond
+			uint64 start = Common::Profiler::getMicros();
+			callback(refCon);
+			uint32 time = (uint32)(Common::Profiler::getMicros() - start);
+
+			_mutex.lock();
+			// removeTimerProc() clears _runningSlot when it deletes the slot
+			if (_runningSlot == slot) {
+				uint32 lateness = (uint32)(curTime - scheduledTime);
+				slot->calls++;
+				slot->totalTime += time;
+				slot->maxTime = MAX(slot->maxTime, time);
+				slot->totalLateness += lateness;
+				slot->maxLateness = MAX(slot->maxLateness, lateness);
+			}
+		} else {
+			callback(refCon);
+			_mutex.lock();
+		}
 
-		// Look at the next scheduled timer
-		slot = _head->next;
+		_runningSlot = nullptr;
 	}
+
+	_mutex.unlock();
 }
 
 void DefaultTimerManager::checkTimers(uint32 interval) {
-	uint32 curTime = g_system->getMillis();
+	uint32 curTime = g_system->getMillis(true);
 
 	// Timer checking & firing
 	if (curTime >= _timerCallbackNext) {
@@ -134,41 +223,39 @@ bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, v
 			error("Different callbacks are referred by same name (%s)", id.c_str());
 		}
 	}
-	TimerSlotMap::const_iterator i;
 
-	for (i = _callbacks.begin(); i != _callbacks.end(); ++i) {
-		if (i->_value == callback) {
-			error("Same callback added twice (old name: %s, new name: %s)", i->_key.c_str(), id.c_str());
-		}
+	TimerProcMap::const_iterator i = _callbackNames.find(callback);
+	if (i != _callbackNames.end()) {
+		error("Same callback added twice (old name: %s, new name: %s)", i->_value.c_str(), id.c_str());
 	}
 	_callbacks[id] = callback;
+	_callbackNames[callback] = id;
 
 	TimerSlot *slot = new TimerSlot;
 	slot->callback = callback;
 	slot->refCon = refCon;
 	slot->id = id;
 	slot->interval = interval;
-	slot->nextFireTime = g_system->getMillis() + interval / 1000;
-	slot->nextFireTimeMicro = interval % 1000;
-	slot->next = 0;
+	slot->nextFireTime = updateClock(g_system->getMillis(true)) + interval;
 
-	insertPrioQueue(_head, slot);
+	pushSlot(slot);
 
 	return true;
 }
 
 void DefaultTimerManager::removeTimerProc(TimerProc callback) {
-	Common::StackLock lock(_mutex);
+	_mutex.lock();
 
-	TimerSlot *slot = _head;
+	const bool running = (_runningSlot && _runningSlot->callback == callback);
 
-	while (slot->next) {
-		if (slot->next->callback == callback) {
-			TimerSlot *next = slot->next->next;
-			delete slot->next;
-			slot->next = next;
+	for (uint i = 0; i < _heap.size(); ) {
+		if (_heap[i]->callback == callback) {
+			if (_heap[i] == _runningSlot)
+				_runningSlot = nullptr;
+			delete _heap[i];
+			removeSlot(i);
 		} else {
-			slot = slot->next;
+			++i;
 		}
 	}
 
@@ -188,4 +275,42 @@ void DefaultTimerManager::removeTimerProc(TimerProc callback) {
 		if (i->_value == callback)
 			_callbacks.erase(i);
 	}
+	_callbackNames.erase(callback);
+	_mutex.unlock();
+
+	// Wait until the callback has returned, unless it is removing itself
+	// (the mutex is recursive in that case).
+	if (running) {
+		_callbackMutex.lock();
+		_callbackMutex.unlock();
+	}
+}
+
+void DefaultTimerManager::setProfiling(bool enable) {
+	Common::StackLock lock(_mutex);
+
+	if (enable && !_profiling) {
+		for (uint i = 0; i < _heap.size(); ++i)
+			_heap[i]->resetStats();
+	}
+	_profiling = enable;
+}
+
+bool DefaultTimerManager::getCallbackStats(Common::Array<CallbackStats> &stats) {
+	Common::StackLock lock(_mutex);
+
+	stats.clear();
+	for (uint i = 0; i < _heap.size(); ++i) {
+		const TimerSlot *slot = _heap[i];
+		CallbackStats entry;
+		entry.id = slot->id;
+		entry.interval = slot->interval;
+		entry.calls = slot->calls;
+		entry.totalTime = slot->totalTime;
+		entry.maxTime = slot->maxTime;
+		entry.totalLateness = slot->totalLateness;
+		entry.maxLateness = slot->maxLateness;
+		stats.push_back(entry);
+	}
+	return true;
 }
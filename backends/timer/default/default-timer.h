@@ -24,7 +24,9 @@
 #define BACKENDS_TIMER_DEFAULT_H
 
 #include "common/str.h"
+#include "common/array.h"
 #include "common/hash-str.h"
+#include "common/hash-ptr.h"
 #include "common/timer.h"
 #include "common/mutex.h"
 
@@ -33,19 +35,37 @@ struct TimerSlot;
 class DefaultTimerManager : public Common::TimerManager {
 private:
 	typedef Common::HashMap<Common::String, TimerProc, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> TimerSlotMap;
+	typedef Common::HashMap<TimerProc, Common::String> TimerProcMap;
 
-	Common::Mutex _mutex;
-	TimerSlot *_head;
+	Common::Mutex _mutex;           ///< Protects the scheduled timers and the statistics
+	Common::Mutex _callbackMutex;   ///< Held by handler() while invoking callbacks
+	Common::Array<TimerSlot *> _heap; ///< Binary min-heap of the scheduled timers, ordered by fire time
 	TimerSlotMap _callbacks;
+	TimerProcMap _callbackNames;
+	TimerSlot *_runningSlot;       ///< The timer whose callback is currently being invoked, if any
+
+	uint64 _clock;                  ///< Milliseconds since the timer manager was created, never wraps
+	uint32 _lastMillis;
+	uint32 _sequence;               ///< Keeps timers with the same fire time in installation order
+	bool _profiling;
 
 	uint32 _timerCallbackNext;
 
+	uint64 updateClock(uint32 millis);
+	void pushSlot(TimerSlot *slot);
+	void removeSlot(uint index);
+	void siftUp(uint index);
+	void siftDown(uint index);
+
 public:
 	DefaultTimerManager();
 	virtual ~DefaultTimerManager();
 	virtual bool installTimerProc(TimerProc proc, int32 interval, void *refCon, const Common::String &id);
 	virtual void removeTimerProc(TimerProc proc);
 
+	virtual void setProfiling(bool enable);
+	virtual bool getCallbackStats(Common::Array<CallbackStats> &stats);
+
 	/**
 	 * Timer callback, to be invoked at regular time intervals by the backend.
 	 */
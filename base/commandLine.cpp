@@ -32,6 +32,7 @@
 #include "base/plugins.h"
 #include "base/version.h"
 
+#include "common/archive.h"
 #include "common/config-manager.h"
 #include "common/fs.h"
 #include "common/rendermode.h"
@@ -42,6 +43,7 @@
 #include "gui/ThemeEngine.h"
 
 #include "audio/musicplugin.h"
+#include "audio/softsynth/mt32.h"
 
 #define DETECTOR_TESTING_HACK
 #define UPGRADE_ALL_TARGETS_HACK
@@ -105,6 +107,10 @@ static const char HELP_STRING[] =
 	"  --list-themes            Display list of all usable GUI themes\n"
 	"  -e, --music-driver=MODE  Select music driver (see README for details)\n"
 	"  --list-audio-devices     List all available audio devices\n"
+#ifdef USE_MT32EMU
+	"  --benchmark-mt32         Render the MIDI file given with --midi-file=FILE through\n"
+	"                           the MT-32 emulator and report its speed\n"
+#endif
 	"  -q, --language=LANG      Select language (en,de,fr,it,pt,es,jp,zh,kr,se,gb,\n"
 	"                           hb,ru,cz)\n"
 	"  -m, --music-volume=NUM   Set the music volume, 0-255 (default: 192)\n"
@@ -118,6 +124,10 @@ static const char HELP_STRING[] =
 	"  --debugflags=FLAGS       Enable engine specific debug flags\n"
 	"                           (separated by commas)\n"
 	"  --debug-channels-only    Show only the specified debug channels\n"
+	"  --memory-tracking        Track memory allocations per subsystem (see the\n"
+	"                           'memory' debugger command)\n"
+	"  --memory-tracking-interval=NUM\n"
+	"                           Log the tracked memory every NUM seconds\n"
 	"  -u, --dump-scripts       Enable script dumping if a directory called 'dumps'\n"
 	"                           exists in the current directory\n"
 	"\n"
@@ -156,6 +166,13 @@ static const char HELP_STRING[] =
 	"  --record-file-name=FILE  Specify record file name\n"
 	"  --disable-display        Disable any gfx output. Used for headless events\n"
 	"                           playback by Event Recorder\n"
+#endif
+#ifdef USE_NULL_DRIVER
+	"  --benchmark              Run the game on a virtual clock as fast as possible\n"
+	"                           and log frame times and screen checksums\n"
+	"  --benchmark-replay=FILE  Benchmark by replaying the events of a recording\n"
+	"                           made by the event recorder\n"
+	"  --benchmark-frames=NUM   Quit the benchmark after NUM frames\n"
 #endif
 	"\n"
 #if defined(ENABLE_SKY) || defined(ENABLE_QUEEN)
@@ -290,8 +307,15 @@ void registerDefaults() {
 	ConfMan.registerDefault("disable_sdl_parachute", false);
 
 	ConfMan.registerDefault("disable_display", false);
+	ConfMan.registerDefault("memory_tracking", false);
+	ConfMan.registerDefault("memory_tracking_interval", 0);
 	ConfMan.registerDefault("record_mode", "none");
 	ConfMan.registerDefault("record_file_name", "record.bin");
+#ifdef USE_NULL_DRIVER
+	ConfMan.registerDefault("benchmark", false);
+	ConfMan.registerDefault("benchmark_replay", "");
+	ConfMan.registerDefault("benchmark_frames", 0);
+#endif
 
 	ConfMan.registerDefault("gui_saveload_chooser", "grid");
 	ConfMan.registerDefault("gui_saveload_last_pos", "0");
@@ -565,12 +589,26 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 			DO_LONG_OPTION_BOOL("debug-channels-only")
 			END_OPTION
 
+			DO_LONG_OPTION_BOOL("memory-tracking")
+			END_OPTION
+
+			DO_LONG_OPTION_INT("memory-tracking-interval")
+			END_OPTION
+
 			DO_OPTION('e', "music-driver")
 			END_OPTION
 
 			DO_LONG_COMMAND("list-audio-devices")
 			END_COMMAND
 
+#ifdef USE_MT32EMU
+			DO_LONG_COMMAND("benchmark-mt32")
+			END_COMMAND
+
+			DO_LONG_OPTION("midi-file")
+			END_OPTION
+#endif
+
 			DO_LONG_OPTION_INT("output-rate")
 			END_OPTION
 
@@ -591,6 +629,17 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 			END_OPTION
 #endif
 
+#ifdef USE_NULL_DRIVER
+			DO_LONG_OPTION_BOOL("benchmark")
+			END_OPTION
+
+			DO_LONG_OPTION("benchmark-replay")
+			END_OPTION
+
+			DO_LONG_OPTION_INT("benchmark-frames")
+			END_OPTION
+#endif
+
 			DO_LONG_OPTION("opl-driver")
 			END_OPTION
 
@@ -966,6 +1015,31 @@ static void listAudioDevices() {
 	}
 }
 
+#ifdef USE_MT32EMU
+void benchmarkMT32(const Common::StringMap &settings, Common::Error &err) {
+	err = Common::kNoError;
+
+	const Common::String midiFile = settings.getVal("midi-file", Common::String());
+	const Common::String extraPath = settings.getVal("extrapath", Common::String());
+
+	// The ROMs are looked up in the extra path, as during regular playback
+	if (!extraPath.empty())
+		SearchMan.addDirectory(extraPath, extraPath);
+	else if (ConfMan.hasKey("extrapath"))
+		SearchMan.addDirectory("extrapath", ConfMan.get("extrapath"));
+
+	MT32Emu::BenchmarkResult result;
+	if (!MT32Emu::benchmarkSynth(midiFile, result)) {
+		err = Common::kUnknownError;
+		return;
+	}
+
+	double seconds = (double)result.renderedFrames / result.sampleRate;
+	printf("Rendered %.1f s of audio in %u ms (%.2fx real time)\n", seconds, result.elapsedMillis,
+		seconds * 1000.0 / MAX<uint32>(result.elapsedMillis, 1));
+}
+#endif
+
 /** Display all games in the given directory, or current directory if empty */
 static DetectedGames getGameList(const Common::FSNode &dir) {
 	Common::FSList files;
@@ -1323,6 +1397,13 @@ bool processSettings(Common::String &command, Common::StringMap &settings, Commo
 	} else if (command == "list-audio-devices") {
 		listAudioDevices();
 		return true;
+#ifdef USE_MT32EMU
+	} else if (command == "benchmark-mt32") {
+		// Run by benchmarkMT32() once the backend is initialized
+		if (settings["midi-file"].empty())
+			usage("--benchmark-mt32: Specify the MIDI file to render with --midi-file=FILE.");
+		return false;
+#endif
 	} else if (command == "version") {
 		printf("%s\n", gScummVMFullVersion);
 		printf("Features compiled in: %s\n", gScummVMFeatures);
@@ -55,6 +55,19 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
  */
 bool processSettings(Common::String &command, Common::StringMap &settings, Common::Error &err);
 
+#if defined(USE_MT32EMU) && !defined(DISABLE_COMMAND_LINE)
+/**
+ * Run the --benchmark-mt32 command: render the MIDI file given with
+ * --midi-file through the MT-32 emulator and report the real-time factor.
+ * This has to be called after the backend is initialized, but it does not
+ * need the screen to be set up.
+ *
+ * @param[in] settings	the settings as returned by parseCommandLine
+ * @param[out] err		indicates whether any error occurred, and which
+ */
+void benchmarkMT32(const Common::StringMap &settings, Common::Error &err);
+#endif
+
 } // End of namespace Base
 
 #endif
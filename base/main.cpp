@@ -44,10 +44,13 @@
 #include "common/events.h"
 #include "gui/EventRecorder.h"
 #include "common/fs.h"
+#include "common/memtrack.h"
+#include "common/profiler.h"
 #ifdef ENABLE_EVENTRECORDER
 #include "common/recorderfile.h"
 #endif
 #include "common/system.h"
+#include "common/taskpool.h"
 #include "common/textconsole.h"
 #include "common/tokenizer.h"
 #include "common/translation.h"
@@ -187,6 +190,13 @@ static Common::Error runGame(const Plugin *plugin, OSystem &system, const Common
 		// need to set this up before instance creation.
 		metaEngine.registerDefaultSettings(target);
 
+		// Start tracking before the engine is created, so that its setup
+		// is included in the report
+		if (ConfMan.getBool("memory_tracking")) {
+			Common::MemoryTracker::setEnabled(true);
+			Common::MemoryTracker::setLogInterval(ConfMan.getInt("memory_tracking_interval"));
+		}
+
 		err = metaEngine.createInstance(&system, &engine);
 	}
 
@@ -209,6 +219,7 @@ static Common::Error runGame(const Plugin *plugin, OSystem &system, const Common
 			ConfMan.removeGameDomain(target.c_str());
 		}
 
+		Common::MemoryTracker::setEnabled(false);
 		return err;
 	}
 
@@ -300,6 +311,11 @@ static Common::Error runGame(const Plugin *plugin, OSystem &system, const Common
 	// Free up memory
 	delete engine;
 
+	if (Common::MemoryTracker::isEnabled()) {
+		Common::MemoryTracker::logStats();
+		Common::MemoryTracker::setEnabled(false);
+	}
+
 	// We clear all debug levels again even though the engine should do it
 	DebugMan.clearAllDebugChannels();
 
@@ -383,6 +399,7 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 
 	// Verify that the backend has been initialized (i.e. g_system has been set).
 	assert(g_system);
+	PROFILE_THREAD_NAME("main");
 	OSystem &system = *g_system;
 
 	// Register config manager defaults
@@ -457,6 +474,16 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	// the command line params) was read.
 	system.initBackend();
 
+#if defined(USE_MT32EMU) && !defined(DISABLE_COMMAND_LINE)
+	// The MT-32 benchmark needs the clock of the backend, but no screen
+	if (command == "benchmark-mt32") {
+		Base::benchmarkMT32(settings, res);
+		if (res.getCode() != Common::kNoError)
+			warning("%s", res.getDesc().c_str());
+		return res.getCode();
+	}
+#endif
+
 	// If we received an invalid graphics mode parameter via command line
 	// we check this here. We can't do it until after the backend is inited,
 	// or there won't be a graphics manager to ask for the supported modes.
@@ -653,6 +680,8 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	Cloud::CloudManager::destroy();
 #endif
 #endif
+	// Queued tasks may run engine code, so finish them first
+	Common::TaskPool::destroy();
 	PluginManager::instance().unloadAllPlugins();
 	PluginManager::destroy();
 	GUI::GuiManager::destroy();
@@ -46,6 +46,15 @@ class ArchiveMember {
 public:
 	virtual ~ArchiveMember() { }
 	virtual SeekableReadStream *createReadStream() const = 0;
+
+	/**
+	 * Like createReadStream(), but the stream may be a memory mapping of
+	 * the file, whose getMappedData() avoids copying it. Only use this
+	 * for read-only game data: if the file shrinks while it is mapped,
+	 * reading it crashes instead of failing.
+	 */
+	virtual SeekableReadStream *createMappedReadStream() const { return createReadStream(); }
+
 	virtual String getName() const = 0;
 	virtual String getDisplayName() const { return getName(); }
 };
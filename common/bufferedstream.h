@@ -50,6 +50,24 @@ ReadStream *wrapBufferedReadStream(ReadStream *parentStream, uint32 bufSize, Dis
  */
 SeekableReadStream *wrapBufferedSeekableReadStream(SeekableReadStream *parentStream, uint32 bufSize, DisposeAfterUse::Flag disposeParentStream);
 
+/**
+ * Take an arbitrary SeekableReadStream and wrap it in a custom stream which
+ * reads ahead adaptively.
+ *
+ * Unlike the buffered stream, the read window starts small and grows up to
+ * maxWindow while the reads move forward (including small forward skips),
+ * and shrinks back on random access. The last few windows are kept, so
+ * seeking back into recently read data does not touch the parent stream.
+ *
+ * If asyncPrefetch is set, the window following a sequential read is
+ * filled on the shared TaskPool. The parent stream must then not be used
+ * by anything else while the wrapper exists.
+ *
+ * It is safe to call this with a NULL parameter (in this case, NULL is
+ * returned).
+ */
+SeekableReadStream *wrapReadAheadSeekableReadStream(SeekableReadStream *parentStream, uint32 maxWindow, DisposeAfterUse::Flag disposeParentStream, bool asyncPrefetch = false);
+
 /**
  * Take an arbitrary WriteStream and wrap it in a custom stream which
  * transparently provides buffering.
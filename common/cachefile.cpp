@@ -0,0 +1,469 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/cachefile.h"
+#include "common/array.h"
+#include "common/config-manager.h"
+#include "common/debug.h"
+#include "common/endian.h"
+#include "common/hash-str.h"
+#include "common/md5.h"
+#include "common/memstream.h"
+#include "common/stream.h"
+
+namespace Common {
+
+FSNode getCacheDirectory() {
+	FSNode dir;
+
+	if (ConfMan.hasKey("cachepath")) {
+		dir = FSNode(ConfMan.get("cachepath"));
+	} else {
+		if (!ConfMan.hasKey("savepath"))
+			return FSNode();
+
+		FSNode saveDir(ConfMan.get("savepath"));
+		if (!saveDir.isDirectory())
+			return FSNode();
+
+		dir = saveDir.getChild("cache");
+	}
+
+	if (!dir.exists() && !dir.createDirectory()) {
+		debug(2, "getCacheDirectory: Could not create '%s'", dir.getPath().c_str());
+		return FSNode();
+	}
+
+	if (!dir.isDirectory() || !dir.isWritable())
+		return FSNode();
+
+	return dir;
+}
+
+SeekableReadStream *openCacheFile(const String &name) {
+	FSNode dir = getCacheDirectory();
+	if (!dir.isDirectory())
+		return nullptr;
+
+	FSNode file = dir.getChild(name);
+	if (!file.exists() || file.isDirectory())
+		return nullptr;
+
+	SeekableReadStream *stream = file.createReadStream();
+	if (stream && stream->size() == 0) {
+		// Truncated by removeCacheFile() on backends which cannot delete files
+		delete stream;
+		return nullptr;
+	}
+
+	return stream;
+}
+
+/**
+ * Deletes a cache file. Backends which cannot delete files get it
+ * truncated instead, which openCacheFile() treats as missing.
+ */
+static void deleteFile(const FSNode &file) {
+	if (!file.exists() || file.remove())
+		return;
+
+	WriteStream *stream = file.createWriteStream();
+	if (stream) {
+		stream->finalize();
+		delete stream;
+	}
+}
+
+namespace {
+
+/**
+ * Writes a cache file under a temporary name, and moves it into place
+ * when finalized.
+ */
+class CacheFileWriteStream : public WriteStream {
+public:
+	CacheFileWriteStream(WriteStream *stream, const FSNode &dir, const String &name, const String &tempName)
+		: _stream(stream), _dir(dir), _name(name), _tempName(tempName), _failed(false) {}
+
+	~CacheFileWriteStream() override {
+		if (_stream) {
+			// Never finalized, drop what was written
+			delete _stream;
+			deleteFile(_dir.getChild(_tempName));
+		}
+	}
+
+	uint32 write(const void *dataPtr, uint32 dataSize) override {
+		return _stream ? _stream->write(dataPtr, dataSize) : 0;
+	}
+
+	bool flush() override { return _stream ? _stream->flush() : !_failed; }
+	bool err() const override { return _stream ? _stream->err() : _failed; }
+	void clearErr() override {}
+	int32 pos() const override { return _stream ? _stream->pos() : 0; }
+
+	void finalize() override {
+		if (!_stream)
+			return;
+
+		_stream->finalize();
+		_failed = _stream->err();
+		delete _stream;
+		_stream = nullptr;
+
+		if (!_failed)
+			_failed = !moveIntoPlace();
+		deleteFile(_dir.getChild(_tempName));
+	}
+
+private:
+	bool moveIntoPlace() {
+		FSNode temp = _dir.getChild(_tempName);
+		if (temp.rename(_name))
+			return true;
+
+		SeekableReadStream *in = temp.createReadStream();
+		WriteStream *out = _dir.getChild(_name).createWriteStream();
+		bool result = in && out;
+
+		byte buffer[4096];
+		while (result && !in->eos()) {
+			uint32 size = in->read(buffer, sizeof(buffer));
+			result = !in->err() && out->write(buffer, size) == size;
+		}
+
+		if (out) {
+			out->finalize();
+			result = result && !out->err();
+		}
+		delete in;
+		delete out;
+
+		if (!result)
+			deleteFile(_dir.getChild(_name));
+		return result;
+	}
+
+	WriteStream *_stream;
+	FSNode _dir;
+	String _name;
+	String _tempName;
+	bool _failed;
+};
+
+} // End of anonymous namespace
+
+WriteStream *createCacheFile(const String &name) {
+	FSNode dir = getCacheDirectory();
+	if (!dir.isDirectory())
+		return nullptr;
+
+	const String tempName = name + ".tmp";
+	WriteStream *stream = dir.getChild(tempName).createWriteStream();
+	if (!stream)
+		return nullptr;
+
+	return new CacheFileWriteStream(stream, dir, name, tempName);
+}
+
+void removeCacheFile(const String &name) {
+	FSNode dir = getCacheDirectory();
+	if (!dir.isDirectory())
+		return;
+
+	deleteFile(dir.getChild(name));
+}
+
+enum {
+	kArchiveMemberVersion = 3,
+	kMinCachedMemberSize = 16 * 1024,
+	kMemberIndexVersion = 1,
+	/** Uses of cached members recorded before the index is written anyway */
+	kMaxPendingMemberUses = 64,
+	/** Default for the "archive_cache_size" config key, in KB */
+	kDefaultMemberCacheBudget = 256 * 1024
+};
+
+static const char *const kMemberIndexName = "members.idx";
+
+static uint32 updateCRC32(uint32 crc, const byte *data, uint32 size) {
+	static uint32 table[256];
+	static bool tableInitialized = false;
+
+	if (!tableInitialized) {
+		for (uint32 i = 0; i < 256; ++i) {
+			uint32 c = i;
+			for (int j = 0; j < 8; ++j)
+				c = (c & 1) ? (0xEDB88320 ^ (c >> 1)) : (c >> 1);
+			table[i] = c;
+		}
+		tableInitialized = true;
+	}
+
+	crc ^= 0xFFFFFFFF;
+	for (uint32 i = 0; i < size; ++i)
+		crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+	return crc ^ 0xFFFFFFFF;
+}
+
+static String getArchiveMemberFileName(const String &archiveKey, const String &memberName, uint32 memberKey) {
+	String name = memberName;
+	name.toLowercase();
+	return String::format("member-%s-%08x-%08x.bin", archiveKey.c_str(), hashit(name.c_str()), memberKey);
+}
+
+namespace {
+
+/**
+ * The list of cached members with their size and the time they were last
+ * used, to keep the cache within its budget. The time is a counter which
+ * is increased on every use.
+ */
+struct MemberIndex {
+	struct Entry {
+		String fileName;
+		uint32 size;
+		uint32 lastUse;
+	};
+
+	uint32 useCounter;
+	Array<Entry> entries;
+	/** Uses recorded since the index was last written */
+	uint pendingUses;
+
+	MemberIndex() : useCounter(0), pendingUses(0) { load(); }
+
+	void load() {
+		SeekableReadStream *stream = openCacheFile(kMemberIndexName);
+		if (!stream)
+			return;
+
+		if (stream->readUint32BE() == MKTAG('X', 'M', 'B', 'I') && stream->readUint32LE() == kMemberIndexVersion) {
+			useCounter = stream->readUint32LE();
+			uint32 count = stream->readUint32LE();
+			while (count-- && !stream->eos() && !stream->err()) {
+				Entry entry;
+				entry.fileName = stream->readPascalString(false);
+				entry.size = stream->readUint32LE();
+				entry.lastUse = stream->readUint32LE();
+				if (!stream->eos() && !stream->err())
+					entries.push_back(entry);
+			}
+		}
+
+		delete stream;
+	}
+
+	void save() {
+		pendingUses = 0;
+
+		WriteStream *out = createCacheFile(kMemberIndexName);
+		if (!out)
+			return;
+
+		out->writeUint32BE(MKTAG('X', 'M', 'B', 'I'));
+		out->writeUint32LE(kMemberIndexVersion);
+		out->writeUint32LE(useCounter);
+		out->writeUint32LE(entries.size());
+		for (uint i = 0; i < entries.size(); ++i) {
+			out->writeByte(entries[i].fileName.size());
+			out->writeString(entries[i].fileName);
+			out->writeUint32LE(entries[i].size);
+			out->writeUint32LE(entries[i].lastUse);
+		}
+		out->finalize();
+		delete out;
+	}
+
+	int find(const String &fileName) const {
+		for (uint i = 0; i < entries.size(); ++i) {
+			if (entries[i].fileName == fileName)
+				return i;
+		}
+		return -1;
+	}
+
+	void touch(const String &fileName, uint32 size) {
+		int i = find(fileName);
+		if (i == -1) {
+			Entry entry;
+			entry.fileName = fileName;
+			entry.size = size;
+			entries.push_back(entry);
+			i = entries.size() - 1;
+		}
+		entries[i].lastUse = ++useCounter;
+	}
+
+	void remove(const String &fileName) {
+		int i = find(fileName);
+		if (i != -1)
+			entries.remove_at(i);
+	}
+
+	/** Drop the least recently used entries until the rest fit the budget. */
+	void prune(uint64 budget) {
+		uint64 total = 0;
+		for (uint i = 0; i < entries.size(); ++i)
+			total += entries[i].size;
+
+		while (total > budget && !entries.empty()) {
+			uint oldest = 0;
+			for (uint i = 1; i < entries.size(); ++i) {
+				if (entries[i].lastUse < entries[oldest].lastUse)
+					oldest = i;
+			}
+
+			debug(2, "Evicting archive member cache entry '%s'", entries[oldest].fileName.c_str());
+			total -= entries[oldest].size;
+			removeCacheFile(entries[oldest].fileName);
+			entries.remove_at(oldest);
+		}
+	}
+};
+
+/**
+ * The index is loaded on first use and kept until the archives using the
+ * cache are closed, see flushArchiveMemberCache(). Uses of cached members
+ * are only written out now and then, as the index is just a hint for
+ * evicting members.
+ */
+MemberIndex *g_memberIndex = nullptr;
+
+MemberIndex &getMemberIndex() {
+	if (!g_memberIndex)
+		g_memberIndex = new MemberIndex();
+	return *g_memberIndex;
+}
+
+uint64 getMemberCacheBudget() {
+	int budget = ConfMan.hasKey("archive_cache_size") ? ConfMan.getInt("archive_cache_size") : (int)kDefaultMemberCacheBudget;
+	return budget > 0 ? (uint64)budget * 1024 : 0;
+}
+
+} // End of anonymous namespace
+
+String computeArchiveCacheKey(SeekableReadStream &archive) {
+	int32 pos = archive.pos();
+	archive.seek(0);
+	String md5 = computeStreamMD5AsString(archive, 5000);
+	archive.seek(pos);
+
+	return String::format("%s-%d", md5.c_str(), archive.size());
+}
+
+uint32 computeArchiveMemberKey(const String &archiveKey, uint32 offset, uint32 compressedSize, uint32 storedChecksum) {
+	byte location[12];
+	WRITE_LE_UINT32(location, offset);
+	WRITE_LE_UINT32(location + 4, compressedSize);
+	WRITE_LE_UINT32(location + 8, storedChecksum);
+
+	uint32 key = updateCRC32(0, (const byte *)archiveKey.c_str(), archiveKey.size());
+	return updateCRC32(key, location, sizeof(location));
+}
+
+SeekableReadStream *openCachedArchiveMember(const String &archiveKey, const String &memberName, uint32 memberKey, uint32 size) {
+	if (size < kMinCachedMemberSize)
+		return nullptr;
+
+	String fileName = getArchiveMemberFileName(archiveKey, memberName, memberKey);
+	SeekableReadStream *stream = openCacheFile(fileName);
+	if (!stream)
+		return nullptr;
+
+	// Entries are moved into place once completely written, so checking the
+	// header and the length is enough to catch stale or truncated ones
+	bool valid = stream->readUint32BE() == MKTAG('X', 'M', 'B', 'R') &&
+	             stream->readUint32LE() == kArchiveMemberVersion &&
+	             stream->readUint32LE() == size &&
+	             stream->readUint32LE() == memberKey;
+	String storedName = stream->readPascalString(false);
+	valid = valid && !stream->err() && storedName.equalsIgnoreCase(memberName) &&
+	        stream->size() - stream->pos() == (int32)size;
+
+	byte *data = nullptr;
+	if (valid) {
+		data = (byte *)malloc(size);
+		valid = stream->read(data, size) == size;
+	}
+	delete stream;
+
+	MemberIndex &index = getMemberIndex();
+	if (!valid) {
+		debug(2, "openCachedArchiveMember: Dropping stale cache entry '%s' for '%s'", fileName.c_str(), memberName.c_str());
+		free(data);
+		removeCacheFile(fileName);
+		index.remove(fileName);
+		index.save();
+		return nullptr;
+	}
+
+	index.touch(fileName, size);
+	if (++index.pendingUses >= kMaxPendingMemberUses)
+		index.save();
+
+	return new MemoryReadStream(data, size, DisposeAfterUse::YES);
+}
+
+void cacheArchiveMember(const String &archiveKey, const String &memberName, uint32 memberKey, const byte *data, uint32 size) {
+	const uint64 budget = getMemberCacheBudget();
+	if (size < kMinCachedMemberSize || size > budget)
+		return;
+
+	String fileName = getArchiveMemberFileName(archiveKey, memberName, memberKey);
+	WriteStream *out = createCacheFile(fileName);
+	if (!out)
+		return;
+
+	out->writeUint32BE(MKTAG('X', 'M', 'B', 'R'));
+	out->writeUint32LE(kArchiveMemberVersion);
+	out->writeUint32LE(size);
+	out->writeUint32LE(memberKey);
+	out->writeByte(MIN<uint32>(memberName.size(), 255));
+	out->write(memberName.c_str(), MIN<uint32>(memberName.size(), 255));
+	out->write(data, size);
+	out->finalize();
+	bool failed = out->err();
+	delete out;
+
+	MemberIndex &index = getMemberIndex();
+	if (failed) {
+		removeCacheFile(fileName);
+		index.remove(fileName);
+	} else {
+		index.touch(fileName, size);
+		index.prune(budget);
+	}
+	index.save();
+}
+
+void flushArchiveMemberCache() {
+	if (!g_memberIndex)
+		return;
+
+	if (g_memberIndex->pendingUses)
+		g_memberIndex->save();
+	delete g_memberIndex;
+	g_memberIndex = nullptr;
+}
+
+} // End of namespace Common
@@ -0,0 +1,148 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_CACHEFILE_H
+#define COMMON_CACHEFILE_H
+
+#include "common/scummsys.h"
+#include "common/fs.h"
+
+namespace Common {
+
+class SeekableReadStream;
+class String;
+class WriteStream;
+
+/**
+ * Return the directory in which derived data (compiled themes, archive
+ * indices and the like) may be cached between runs.
+ *
+ * This is the directory set in the "cachepath" config key if there is
+ * one, otherwise a "cache" subdirectory of the global save path. The
+ * directory is created on demand.
+ *
+ * @return the cache directory, or an invalid node if none is available
+ */
+FSNode getCacheDirectory();
+
+/**
+ * Open a previously created cache file for reading.
+ *
+ * @param name	the name of the cache file
+ * @return a stream for the file, or 0 if it does not exist
+ */
+SeekableReadStream *openCacheFile(const String &name);
+
+/**
+ * Create (or overwrite) a cache file. The caller owns the stream.
+ *
+ * The data goes to a temporary file, which only replaces the cache file
+ * once finalize() succeeded, so a crash or a full disk never leaves an
+ * incomplete file behind. Backends that cannot rename files fall back to
+ * copying it into place, so readers should still validate the contents.
+ *
+ * @param name	the name of the cache file
+ * @return a stream for the file, or 0 if caching is not possible
+ */
+WriteStream *createCacheFile(const String &name);
+
+/**
+ * Delete a cache file, e.g. because it turned out to be stale or
+ * damaged. On backends which cannot delete files, the file is truncated
+ * instead; openCacheFile() treats empty files as missing.
+ * Does nothing if the file does not exist.
+ *
+ * @param name	the name of the cache file
+ */
+void removeCacheFile(const String &name);
+
+/**
+ * Compute a key identifying an archive file for the member cache below.
+ * It is made of the archive size and the MD5 of its first 5000 bytes, like
+ * the detection code uses, so it stays cheap for large archives. The
+ * stream position is preserved.
+ *
+ * Patched or localized archives may share the size and the header, so
+ * the cache also checks the identity of each member, see
+ * computeArchiveMemberKey().
+ *
+ * @param archive	the archive file
+ * @return the key
+ */
+String computeArchiveCacheKey(SeekableReadStream &archive);
+
+/**
+ * Compute a key identifying the compressed data of an archive member from
+ * where it is stored and the checksum the archive stores for it. It is
+ * cheap to compute, the member data is not read.
+ *
+ * @param archiveKey		the key returned by computeArchiveCacheKey()
+ * @param offset			the offset of the compressed data
+ * @param compressedSize	the size of the compressed data
+ * @param storedChecksum	the checksum stored in the archive for the
+ *							member, in whatever form the archive uses
+ * @return the key
+ */
+uint32 computeArchiveMemberKey(const String &archiveKey, uint32 offset, uint32 compressedSize, uint32 storedChecksum);
+
+/**
+ * Open the decompressed data of an archive member stored by
+ * cacheArchiveMember(). The entry is only used if its header matches the
+ * member key, name and size, stale or truncated entries are removed.
+ *
+ * Members smaller than 16 KB are never cached; decompressing
+ * them is cheaper than opening a file.
+ *
+ * @param archiveKey	the key returned by computeArchiveCacheKey()
+ * @param memberName	the name of the member in the archive
+ * @param memberKey		the key returned by computeArchiveMemberKey()
+ * @param size			the uncompressed size of the member
+ * @return a stream on the member data, or 0 if it is not cached
+ */
+SeekableReadStream *openCachedArchiveMember(const String &archiveKey, const String &memberName, uint32 memberKey, uint32 size);
+
+/**
+ * Store the decompressed data of an archive member in the cache, so that
+ * the next openCachedArchiveMember() call finds it.
+ *
+ * The cached members are kept within the budget set by the
+ * "archive_cache_size" config key, in KB (256 MB by default). The least
+ * recently used members are removed to make room.
+ *
+ * @param archiveKey	the key returned by computeArchiveCacheKey()
+ * @param memberName	the name of the member in the archive
+ * @param memberKey		the key returned by computeArchiveMemberKey()
+ * @param data			the decompressed data
+ * @param size			the uncompressed size of the member
+ */
+void cacheArchiveMember(const String &archiveKey, const String &memberName, uint32 memberKey, const byte *data, uint32 size);
+
+/**
+ * Write out which cached members were used recently, and release the
+ * memory used to track them. Archives using the member cache call this
+ * when they are closed.
+ */
+void flushArchiveMemberCache();
+
+} // End of namespace Common
+
+#endif
@@ -59,6 +59,26 @@ bool File::open(const String &filename, Archive &archive) {
 	return open(stream, filename);
 }
 
+bool File::openMapped(const String &filename) {
+	return openMapped(filename, SearchMan);
+}
+
+bool File::openMapped(const String &filename, Archive &archive) {
+	assert(!filename.empty());
+	assert(!_handle);
+
+	SeekableReadStream *stream = nullptr;
+
+	if (archive.hasFile(filename)) {
+		ArchiveMemberPtr member = archive.getMember(filename);
+		if (member)
+			stream = member->createMappedReadStream();
+		debug(8, "Opening mapped: %s", filename.c_str());
+	}
+
+	return open(stream, filename);
+}
+
 bool File::open(const FSNode &node) {
 	assert(!_handle);
 
@@ -138,6 +158,11 @@ bool File::seek(int32 offs, int whence) {
 	return _handle->seek(offs, whence);
 }
 
+const byte *File::getMappedData() const {
+	assert(_handle);
+	return _handle->getMappedData();
+}
+
 uint32 File::read(void *ptr, uint32 len) {
 	assert(_handle);
 	return _handle->read(ptr, len);
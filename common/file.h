@@ -87,6 +87,23 @@ public:
 	 */
 	virtual bool open(const FSNode &node);
 
+	/**
+	 * Try to open the file with the given filename like open(), but map
+	 * it into memory where the backend supports it, so getMappedData()
+	 * gives access to its contents without copying.
+	 *
+	 * Only use this for read-only game data, like large archives. If the
+	 * file shrinks while it is mapped, reading it crashes instead of
+	 * failing, so never use it for save or cache files.
+	 * @note Must not be called if this file already is open (i.e. if isOpen returns true).
+	 *
+	 * @param	filename	the name of the file to open
+	 * @param	archive		the archive in which to search for the file
+	 * @return	true if file was opened successfully, false otherwise
+	 */
+	bool openMapped(const String &filename, Archive &archive);
+	bool openMapped(const String &filename);
+
 	/**
 	 * Try to 'open' the given stream. That is, we just wrap around it, and if stream
 	 * is a NULL pointer, we gracefully treat this as if opening failed.
@@ -125,6 +142,7 @@ public:
 	int32 size() const override;	// implement abstract SeekableReadStream method
 	bool seek(int32 offs, int whence = SEEK_SET) override;	// implement abstract SeekableReadStream method
 	uint32 read(void *dataPtr, uint32 dataSize) override;	// implement abstract SeekableReadStream method
+	const byte *getMappedData() const override;
 };
 
 
@@ -0,0 +1,128 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/framearena.h"
+#include "common/memtrack.h"
+#include "common/textconsole.h"
+
+namespace Common {
+
+enum {
+	kArenaAlignment = 8
+};
+
+FrameArena::FrameArena(size_t chunkSize) : _chunkSize(chunkSize), _currentChunk(0), _offset(0), _frameDepth(0),
+	_allocations(0), _bytes(0), _lastFrameAllocations(0), _lastFrameBytes(0), _peakFrameBytes(0),
+	_frameCount(0), _chunkAllocations(0) {
+}
+
+FrameArena::~FrameArena() {
+	for (uint i = 0; i < _chunks.size(); ++i) {
+		MemoryTracker::trackFree(_chunks[i].start);
+		free(_chunks[i].start);
+	}
+}
+
+void *FrameArena::allocate(size_t size) {
+	size = (size + kArenaAlignment - 1) & ~(size_t)(kArenaAlignment - 1);
+
+	_allocations++;
+	_bytes += size;
+
+	if (_currentChunk < _chunks.size() && _offset + size <= _chunks[_currentChunk].size) {
+		void *ptr = _chunks[_currentChunk].start + _offset;
+		_offset += size;
+		return ptr;
+	}
+
+	return allocateFromNewChunk(size);
+}
+
+void *FrameArena::allocateFromNewChunk(size_t size) {
+	// Move on to the next chunk that is large enough, skipping the
+	// remainder of the current one
+	if (!_chunks.empty()) {
+		for (++_currentChunk; _currentChunk < _chunks.size(); ++_currentChunk) {
+			if (_chunks[_currentChunk].size >= size)
+				break;
+		}
+	}
+
+	if (_currentChunk >= _chunks.size()) {
+		Chunk chunk;
+		chunk.size = MAX(size, _chunkSize);
+		chunk.start = (byte *)malloc(chunk.size);
+		if (!chunk.start)
+			error("FrameArena: Out of memory allocating %u bytes", (uint)chunk.size);
+		MemoryTracker::trackAlloc(chunk.start, chunk.size);
+
+		_chunks.push_back(chunk);
+		_currentChunk = _chunks.size() - 1;
+		_chunkAllocations++;
+	}
+
+	_offset = size;
+	return _chunks[_currentChunk].start;
+}
+
+bool FrameArena::owns(const void *ptr) const {
+	const byte *p = (const byte *)ptr;
+	for (uint i = 0; i < _chunks.size(); ++i) {
+		if (p >= _chunks[i].start && p < _chunks[i].start + _chunks[i].size)
+			return true;
+	}
+
+	return false;
+}
+
+void FrameArena::beginFrame() {
+	_frameDepth++;
+}
+
+void FrameArena::endFrame() {
+	assert(_frameDepth > 0);
+
+	if (--_frameDepth == 0) {
+		_lastFrameAllocations = _allocations;
+		_lastFrameBytes = _bytes;
+		_peakFrameBytes = MAX(_peakFrameBytes, _bytes);
+		_frameCount++;
+		reset();
+	}
+}
+
+void FrameArena::reset() {
+	_currentChunk = 0;
+	_offset = 0;
+	_allocations = 0;
+	_bytes = 0;
+}
+
+size_t FrameArena::getCapacity() const {
+	size_t capacity = 0;
+	for (uint i = 0; i < _chunks.size(); ++i)
+		capacity += _chunks[i].size;
+
+	return capacity;
+}
+
+} // End of namespace Common
@@ -0,0 +1,151 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_FRAMEARENA_H
+#define COMMON_FRAMEARENA_H
+
+#include "common/scummsys.h"
+#include "common/array.h"
+#include "common/noncopyable.h"
+
+namespace Common {
+
+/**
+ * A bump allocator for short-lived scratch memory, like the temporary
+ * lists an engine builds while drawing a frame.
+ *
+ * Allocating only advances a pointer in the current memory chunk, and
+ * nothing is freed individually: all allocations are released at once
+ * when the frame ends. The chunks are kept for the next frame, so once
+ * the arena has grown to the size of a typical frame no more heap
+ * allocations are made.
+ *
+ * The destructors of objects placed in the arena are not called, so
+ * only use it for objects that do not own other resources.
+ */
+class FrameArena : NonCopyable {
+public:
+	/**
+	 * Create an arena.
+	 * @param chunkSize		the size of the memory chunks requested from the heap
+	 */
+	explicit FrameArena(size_t chunkSize = 64 * 1024);
+	~FrameArena();
+
+	/**
+	 * Allocate memory for the current frame. The memory is suitably
+	 * aligned for any type and stays valid until the frame ends.
+	 */
+	void *allocate(size_t size);
+
+	/**
+	 * Allocate uninitialized memory for an array of count objects.
+	 */
+	template<class T>
+	T *allocateArray(size_t count) {
+		return (T *)allocate(count * sizeof(T));
+	}
+
+	/**
+	 * Check whether the given pointer was returned by this arena.
+	 */
+	bool owns(const void *ptr) const;
+
+	/**
+	 * Mark the start of a frame. Frames may be nested; the memory is only
+	 * released when the outermost frame ends.
+	 */
+	void beginFrame();
+
+	/**
+	 * Mark the end of a frame. When this ends the outermost frame, the
+	 * frame statistics are updated and all memory is released.
+	 */
+	void endFrame();
+
+	/**
+	 * Release all memory allocated from the arena, regardless of frames.
+	 */
+	void reset();
+
+	/**
+	 * Helper that calls beginFrame() on construction and endFrame() on
+	 * destruction. Declare it before the objects that use the arena, so
+	 * that it is destroyed after them.
+	 */
+	class FrameScope : NonCopyable {
+		FrameArena &_arena;
+	public:
+		explicit FrameScope(FrameArena &arena) : _arena(arena) { _arena.beginFrame(); }
+		~FrameScope() { _arena.endFrame(); }
+	};
+
+	/** The number of allocations made in the last completed frame. */
+	uint32 getLastFrameAllocations() const { return _lastFrameAllocations; }
+	/** The number of bytes allocated in the last completed frame. */
+	uint32 getLastFrameBytes() const { return _lastFrameBytes; }
+	/** The largest number of bytes allocated in a single frame. */
+	uint32 getPeakFrameBytes() const { return _peakFrameBytes; }
+	/** The number of frames completed so far. */
+	uint32 getFrameCount() const { return _frameCount; }
+	/** The number of chunks requested from the heap so far. */
+	uint32 getChunkAllocations() const { return _chunkAllocations; }
+	/** The memory currently held by the arena. */
+	size_t getCapacity() const;
+
+private:
+	struct Chunk {
+		byte *start;
+		size_t size;
+	};
+
+	void *allocateFromNewChunk(size_t size);
+
+	const size_t _chunkSize;
+	Array<Chunk> _chunks;
+	uint _currentChunk;
+	size_t _offset;
+	uint _frameDepth;
+
+	uint32 _allocations;
+	uint32 _bytes;
+	uint32 _lastFrameAllocations;
+	uint32 _lastFrameBytes;
+	uint32 _peakFrameBytes;
+	uint32 _frameCount;
+	uint32 _chunkAllocations;
+};
+
+} // End of namespace Common
+
+/**
+ * A placement new operator allocating from a FrameArena.
+ */
+inline void *operator new(size_t nbytes, Common::FrameArena &arena) {
+	return arena.allocate(nbytes);
+}
+
+inline void operator delete(void *p, Common::FrameArena &arena) {
+	// The memory is released at the end of the frame
+}
+
+#endif
@@ -140,6 +140,21 @@ SeekableReadStream *FSNode::createReadStream() const {
 	return _realNode->createReadStream();
 }
 
+SeekableReadStream *FSNode::createMappedReadStream() const {
+	if (_realNode == nullptr)
+		return nullptr;
+
+	if (!_realNode->exists()) {
+		warning("FSNode::createMappedReadStream: '%s' does not exist", getName().c_str());
+		return nullptr;
+	} else if (_realNode->isDirectory()) {
+		warning("FSNode::createMappedReadStream: '%s' is a directory", getName().c_str());
+		return nullptr;
+	}
+
+	return _realNode->createMappedReadStream();
+}
+
 WriteStream *FSNode::createWriteStream() const {
 	if (_realNode == nullptr)
 		return nullptr;
@@ -168,6 +183,27 @@ bool FSNode::createDirectory() const {
 	return _realNode->createDirectory();
 }
 
+bool FSNode::rename(const String &newName) const {
+	if (_realNode == nullptr || !_realNode->exists() || _realNode->isDirectory())
+		return false;
+
+	return _realNode->rename(newName);
+}
+
+bool FSNode::remove() const {
+	if (_realNode == nullptr || !_realNode->exists() || _realNode->isDirectory())
+		return false;
+
+	return _realNode->remove();
+}
+
+uint32 FSNode::getModificationTime() const {
+	if (_realNode == nullptr || !_realNode->exists())
+		return 0;
+
+	return _realNode->getModificationTime();
+}
+
 FSDirectory::FSDirectory(const FSNode &node, int depth, bool flat, bool ignoreClashes)
   : _node(node), _cached(false), _depth(depth), _flat(flat), _ignoreClashes(ignoreClashes) {
 }
@@ -222,6 +222,14 @@ public:
 	 */
 	virtual SeekableReadStream *createReadStream() const;
 
+	/**
+	 * Like createReadStream(), but the stream may map the file into
+	 * memory where the backend supports it, see ArchiveMember.
+	 *
+	 * @return pointer to the stream object, 0 in case of a failure
+	 */
+	virtual SeekableReadStream *createMappedReadStream() const;
+
 	/**
 	 * Creates a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -239,6 +247,34 @@ public:
 	 * @return true if the directory was created, false otherwise.
 	 */
 	bool createDirectory() const;
+
+	/**
+	 * Renames the file referred by this node, keeping it in the same
+	 * directory. A file already using the new name is replaced, so this
+	 * can be used to move a completely written file into place. This
+	 * node keeps referring to the old name.
+	 *
+	 * @return true if the file was renamed, false if it does not exist or
+	 *         the backend does not support renaming files.
+	 */
+	bool rename(const String &newName) const;
+
+	/**
+	 * Deletes the file referred by this node.
+	 *
+	 * @return true if the file was deleted, false if it does not exist or
+	 *         the backend does not support deleting files.
+	 */
+	bool remove() const;
+
+	/**
+	 * Returns the time the file referred by this node was last modified,
+	 * in seconds since an arbitrary, backend specific epoch. This is only
+	 * meant to tell whether a file changed.
+	 *
+	 * @return the modification time, or 0 if it is unknown.
+	 */
+	uint32 getModificationTime() const;
 };
 
 /**
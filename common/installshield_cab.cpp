@@ -44,6 +44,7 @@
 // SOFTWARE.
 
 #include "common/archive.h"
+#include "common/cachefile.h"
 #include "common/debug.h"
 #include "common/hash-str.h"
 #include "common/installshield_cab.h"
@@ -68,6 +69,7 @@ private:
 		uint32 uncompressedSize;
 		uint32 compressedSize;
 		uint32 offset;
+		uint32 checksum;
 		uint16 flags;
 	};
 
@@ -75,10 +77,12 @@ private:
 	FileMap _map;
 	Common::SeekableReadStream *_stream;
 	DisposeAfterUse::Flag _disposeAfterUse;
+	String _cacheKey;
 };
 
 InstallShieldCabinet::~InstallShieldCabinet() {
 	_map.clear();
+	flushArchiveMemberCache();
 
 	if (_disposeAfterUse == DisposeAfterUse::YES)
 		delete _stream;
@@ -141,6 +145,8 @@ InstallShieldCabinet::InstallShieldCabinet(SeekableReadStream *stream, DisposeAf
 		entry.compressedSize = _stream->readUint32LE();
 		_stream->skip(20);
 		entry.offset = _stream->readUint32LE();
+		// The start of the MD5 of the uncompressed data
+		entry.checksum = _stream->readUint32LE();
 
 		// Then let's get the string
 		_stream->seek(cabDescriptorOffset + fileTableOffset + nameOffset);
@@ -155,6 +161,8 @@ InstallShieldCabinet::InstallShieldCabinet(SeekableReadStream *stream, DisposeAf
 	}
 
 	delete[] fileTableOffsets;
+
+	_cacheKey = computeArchiveCacheKey(*_stream);
 }
 
 bool InstallShieldCabinet::hasFile(const String &name) const {
@@ -183,6 +191,11 @@ SeekableReadStream *InstallShieldCabinet::createReadStreamForMember(const String
 	if (!(entry.flags & 0x04)) // Not compressed
 		return _stream->readStream(entry.uncompressedSize);
 
+	const uint32 memberKey = computeArchiveMemberKey(_cacheKey, entry.offset, entry.compressedSize, entry.checksum);
+	SeekableReadStream *cached = openCachedArchiveMember(_cacheKey, name, memberKey, entry.uncompressedSize);
+	if (cached)
+		return cached;
+
 #ifdef USE_ZLIB
 	byte *src = (byte *)malloc(entry.compressedSize);
 	byte *dst = (byte *)malloc(entry.uncompressedSize);
@@ -198,6 +211,8 @@ SeekableReadStream *InstallShieldCabinet::createReadStreamForMember(const String
 		return nullptr;
 	}
 
+	cacheArchiveMember(_cacheKey, name, memberKey, dst, entry.uncompressedSize);
+
 	return new MemoryReadStream(dst, entry.uncompressedSize, DisposeAfterUse::YES);
 #else
 	warning("zlib required to extract compressed CAB file '%s'", name.c_str());
@@ -34,6 +34,7 @@
 #include "lstring.h"
 #include "ltable.h"
 #include "ltm.h"
+#include "lundump.h"
 #include "lvm.h"
 #include "lzio.h"
 #include "common/textconsole.h"
@@ -510,6 +511,7 @@ struct SParser {  /* data to `f_parser' */
   ZIO *z;
   Mbuffer buff;  /* buffer to be used by the scanner */
   const char *name;
+  int binary;  /* load a precompiled chunk instead of source */
 };
 
 static void f_parser (lua_State *L, void *ud) {
@@ -519,9 +521,13 @@ static void f_parser (lua_State *L, void *ud) {
   struct SParser *p = cast(struct SParser *, ud);
   int c = luaZ_lookahead(p->z);
   luaC_checkGC(L);
-  if (c == LUA_SIGNATURE[0])
-	  error("Handling of precompiled LUA scripts has been removed in ScummVM");
-  tf = luaY_parser(L, p->z, &p->buff, p->name);
+  if (p->binary)
+    tf = luaU_undump(L, p->z, &p->buff, p->name);
+  else {
+    if (c == LUA_SIGNATURE[0])
+      error("Handling of precompiled LUA scripts has been removed in ScummVM");
+    tf = luaY_parser(L, p->z, &p->buff, p->name);
+  }
   cl = luaF_newLclosure(L, tf->nups, hvalue(gt(L)));
   cl->l.p = tf;
   for (i = 0; i < tf->nups; i++)  /* initialize eventual upvalues */
@@ -531,10 +537,11 @@ static void f_parser (lua_State *L, void *ud) {
 }
 
 
-int luaD_protectedparser (lua_State *L, ZIO *z, const char *name) {
+int luaD_protectedparser (lua_State *L, ZIO *z, const char *name,
+                          int binary) {
   struct SParser p;
   int status;
-  p.z = z; p.name = name;
+  p.z = z; p.name = name; p.binary = binary;
   luaZ_initbuffer(L, &p.buff);
   status = luaD_pcall(L, f_parser, &p, savestack(L, L->top), L->errfunc);
   luaZ_freebuffer(L, &p.buff);
@@ -204,6 +204,11 @@ LUA_API int   (lua_pcall) (lua_State *L, int nargs, int nresults, int errfunc);
 LUA_API int   (lua_cpcall) (lua_State *L, lua_CFunction func, void *ud);
 LUA_API int   (lua_load) (lua_State *L, lua_Reader reader, void *dt,
                                         const char *chunkname);
+/* ScummVM: load a precompiled chunk. Bytecode cannot be loaded safely
+   from untrusted sources, so only use this for chunks ScummVM dumped
+   itself; lua_load refuses them */
+LUA_API int   (lua_loadbinary) (lua_State *L, lua_Reader reader, void *dt,
+                                              const char *chunkname);
 
 LUA_API int (lua_dump) (lua_State *L, lua_Writer writer, void *data);
 
@@ -0,0 +1,162 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "lua_chunkcache.h"
+
+#include "common/cachefile.h"
+#include "common/debug.h"
+#include "common/hash-str.h"
+#include "common/md5.h"
+#include "common/memstream.h"
+
+#include "lauxlib.h"
+
+namespace Lua {
+
+enum {
+	kChunkCacheVersion = 1
+};
+
+struct ChunkReader {
+	const char *data;
+	size_t size;
+};
+
+static const char *readChunk(lua_State *L, void *data, size_t *size) {
+	ChunkReader *reader = (ChunkReader *)data;
+	if (reader->size == 0)
+		return nullptr;
+	*size = reader->size;
+	reader->size = 0;
+	return reader->data;
+}
+
+static int writeChunk(lua_State *L, const void *p, size_t size, void *data) {
+	Common::WriteStream *stream = (Common::WriteStream *)data;
+	return stream->write(p, size) == size ? 0 : 1;
+}
+
+/**
+ * Load the bytecode for a source from a cache file. The bytecode is only
+ * used if the file belongs to the same chunk and source, and has not been
+ * damaged. This is the only place that loads bytecode; the generic loaders
+ * still refuse it.
+ */
+static bool loadCachedChunk(lua_State *L, Common::SeekableReadStream &stream, const uint8 sourceDigest[16], size_t size, const char *name) {
+	uint8 digest[16];
+
+	if (stream.readUint32BE() != MKTAG('L', 'U', 'A', 'C') || stream.readUint32LE() != kChunkCacheVersion ||
+			stream.readUint32LE() != size)
+		return false;
+
+	if (stream.read(digest, 16) != 16 || memcmp(digest, sourceDigest, 16))
+		return false;
+
+	uint16 nameLength = stream.readUint16LE();
+	Common::String storedName;
+	for (uint16 i = 0; i < nameLength; i++)
+		storedName += (char)stream.readByte();
+	if (storedName != name)
+		return false;
+
+	uint32 bytecodeSize = stream.readUint32LE();
+	if (stream.read(digest, 16) != 16 || stream.err() || stream.size() - stream.pos() != (int32)bytecodeSize)
+		return false;
+
+	char *bytecode = new char[bytecodeSize];
+	stream.read(bytecode, bytecodeSize);
+
+	uint8 bytecodeDigest[16];
+	Common::MemoryReadStream bytecodeStream((const byte *)bytecode, bytecodeSize);
+	computeStreamMD5(bytecodeStream, bytecodeDigest);
+
+	bool result = false;
+	if (!memcmp(digest, bytecodeDigest, 16)) {
+		ChunkReader reader = { bytecode, bytecodeSize };
+		result = lua_loadbinary(L, readChunk, &reader, name) == 0;
+		if (!result)
+			lua_pop(L, 1);	// Remove the error message
+	}
+
+	delete[] bytecode;
+	return result;
+}
+
+int loadBufferCached(lua_State *L, const char *buff, size_t size, const char *name) {
+	uint8 sourceDigest[16];
+	Common::MemoryReadStream source((const byte *)buff, size);
+	computeStreamMD5(source, sourceDigest);
+
+	Common::String cacheName = "lua-";
+	for (int i = 0; i < 16; i++)
+		cacheName += Common::String::format("%02x", sourceDigest[i]);
+	cacheName += Common::String::format("-%08x.luac", Common::hashit(name));
+
+	Common::SeekableReadStream *cacheFile = Common::openCacheFile(cacheName);
+	if (cacheFile) {
+		bool result = loadCachedChunk(L, *cacheFile, sourceDigest, size, name);
+		delete cacheFile;
+
+		if (result)
+			return 0;
+
+		debug(2, "loadBufferCached: Dropping stale bytecode of '%s'", name);
+		Common::removeCacheFile(cacheName);
+	}
+
+	int status = luaL_loadbuffer(L, buff, size, name);
+	if (status != 0)
+		return status;
+
+	Common::MemoryWriteStreamDynamic bytecode(DisposeAfterUse::YES);
+	if (lua_dump(L, writeChunk, &bytecode) != 0)
+		return 0;
+
+	Common::WriteStream *out = Common::createCacheFile(cacheName);
+	if (!out)
+		return 0;
+
+	uint8 bytecodeDigest[16];
+	Common::MemoryReadStream bytecodeStream(bytecode.getData(), bytecode.size());
+	computeStreamMD5(bytecodeStream, bytecodeDigest);
+
+	uint16 nameLength = strlen(name);
+	out->writeUint32BE(MKTAG('L', 'U', 'A', 'C'));
+	out->writeUint32LE(kChunkCacheVersion);
+	out->writeUint32LE(size);
+	out->write(sourceDigest, 16);
+	out->writeUint16LE(nameLength);
+	out->write(name, nameLength);
+	out->writeUint32LE(bytecode.size());
+	out->write(bytecodeDigest, 16);
+	out->write(bytecode.getData(), bytecode.size());
+	out->finalize();
+	bool failed = out->err();
+	delete out;
+
+	if (failed)
+		Common::removeCacheFile(cacheName);
+
+	return 0;
+}
+
+} // End of namespace Lua
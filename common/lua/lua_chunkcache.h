@@ -0,0 +1,48 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef LUA_CHUNKCACHE_H
+#define LUA_CHUNKCACHE_H
+
+#include "lua.h"
+
+namespace Lua {
+
+/**
+ * Load a chunk like luaL_loadbuffer(), keeping its compiled bytecode in
+ * the cache directory. When the cache holds bytecode for the same source
+ * and chunk name, that is loaded instead of running the parser.
+ *
+ * Only use this for scripts that are loaded again on every start, like
+ * the scripts of a game; each distinct source gets its own cache file.
+ *
+ * @param L		the Lua state
+ * @param buff	the chunk source
+ * @param size	the size of the source
+ * @param name	the chunk name
+ * @return 0 on success, or the luaL_loadbuffer() error code
+ */
+int loadBufferCached(lua_State *L, const char *buff, size_t size, const char *name);
+
+} // End of namespace Lua
+
+#endif
@@ -21,6 +21,7 @@
  */
 
 #include "common/memorypool.h"
+#include "common/memtrack.h"
 #include "common/util.h"
 
 namespace Common {
@@ -55,8 +56,10 @@ MemoryPool::~MemoryPool() {
 		warning("Memory leak found in pool");
 #endif
 
-	for (size_t i = 0; i < _pages.size(); ++i)
+	for (size_t i = 0; i < _pages.size(); ++i) {
+		MemoryTracker::trackFree(_pages[i].start);
 		::free(_pages[i].start);
+	}
 }
 
 void MemoryPool::allocPage() {
@@ -68,6 +71,7 @@ void MemoryPool::allocPage() {
 
 	page.start = ::malloc(page.numChunks * _chunkSize);
 	assert(page.start);
+	MemoryTracker::trackAlloc(page.start, page.numChunks * _chunkSize);
 	_pages.push_back(page);
 
 
@@ -152,6 +156,7 @@ void MemoryPool::freeUnusedPages() {
 					iter2 = *(void ***)iter2;
 			}
 
+			MemoryTracker::trackFree(_pages[i].start);
 			::free(_pages[i].start);
 			++freedPagesCount;
 			_pages[i].start = nullptr;
@@ -71,6 +71,8 @@ public:
 	int32 size() const { return _size; }
 
 	bool seek(int32 offs, int whence = SEEK_SET);
+
+	const byte *getMappedData() const { return _ptrOrig; }
 };
 
 
@@ -89,6 +91,8 @@ public:
 	bool seek(int32 offs, int whence = SEEK_SET) { return MemoryReadStream::seek(offs, whence); }
 
 	bool skip(uint32 offset) { return MemoryReadStream::seek(offset, SEEK_CUR); }
+
+	const byte *getMappedData() const { return MemoryReadStream::getMappedData(); }
 };
 
 /**
@@ -0,0 +1,226 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/memtrack.h"
+#include "common/algorithm.h"
+#include "common/debug.h"
+#include "common/hashmap.h"
+#include "common/hash-ptr.h"
+#include "common/mutex.h"
+#include "common/str.h"
+#include "common/system.h"
+#include "common/timer.h"
+
+namespace Common {
+
+bool MemoryTracker::_enabled = false;
+MemoryTracker::Tag MemoryTracker::_currentTag = MemoryTracker::kUntagged;
+
+namespace {
+
+struct Block {
+	size_t size;
+	MemoryTracker::Tag tag;
+};
+
+typedef HashMap<const void *, Block> BlockMap;
+
+MemoryTracker::TagStats tags[MemoryTracker::kMaxTags];
+int numTags = 0;
+BlockMap *blocks = nullptr;
+Mutex *mutex = nullptr;
+uint logInterval = 0;
+
+// Set while the tracker updates its own block map, which allocates from
+// a memory pool and would otherwise be tracked recursively
+bool insideTracker = false;
+
+void clearTags() {
+	memset(tags, 0, sizeof(tags));
+	strlcpy(tags[MemoryTracker::kUntagged].name, "untagged", MemoryTracker::kMaxTagNameLength);
+	numTags = 1;
+}
+
+bool compareLiveBytes(const MemoryTracker::TagStats &a, const MemoryTracker::TagStats &b) {
+	return a.liveBytes > b.liveBytes;
+}
+
+} // End of anonymous namespace
+
+void MemoryTracker::setEnabled(bool enabled) {
+	if (enabled == _enabled)
+		return;
+
+	// Without a backend there are no other threads to guard against
+	if (!mutex && g_system)
+		mutex = new Mutex();
+
+	if (enabled) {
+		clearTags();
+		blocks = new BlockMap();
+		_currentTag = kUntagged;
+		_enabled = true;
+	} else {
+		setLogInterval(0);
+
+		if (mutex)
+			mutex->lock();
+		_enabled = false;
+		delete blocks;
+		blocks = nullptr;
+		if (mutex)
+			mutex->unlock();
+	}
+}
+
+MemoryTracker::Tag MemoryTracker::getTag(const char *name) {
+	for (int i = 0; i < numTags; ++i) {
+		if (!strncmp(tags[i].name, name, kMaxTagNameLength - 1))
+			return i;
+	}
+
+	if (numTags == kMaxTags)
+		return kUntagged;
+
+	// Registering is rare; only take the lock now and look again, another
+	// thread may have added the same name meanwhile
+	if (mutex)
+		mutex->lock();
+	Tag tag = kUntagged;
+	for (int i = 0; i < numTags; ++i) {
+		if (!strncmp(tags[i].name, name, kMaxTagNameLength - 1))
+			tag = i;
+	}
+	if (tag == kUntagged && numTags < kMaxTags) {
+		tag = numTags;
+		memset(&tags[tag], 0, sizeof(TagStats));
+		strlcpy(tags[tag].name, name, kMaxTagNameLength);
+		++numTags;
+	}
+	if (mutex)
+		mutex->unlock();
+	return tag;
+}
+
+void MemoryTracker::recordAlloc(const void *ptr, size_t size) {
+	if (mutex)
+		mutex->lock();
+
+	if (!insideTracker && blocks) {
+		insideTracker = true;
+
+		Block block;
+		block.size = size;
+		block.tag = _currentTag;
+		(*blocks)[ptr] = block;
+
+		TagStats &stats = tags[block.tag];
+		stats.liveBytes += size;
+		stats.peakBytes = MAX(stats.peakBytes, stats.liveBytes);
+		++stats.liveBlocks;
+		++stats.allocations;
+
+		insideTracker = false;
+	}
+
+	if (mutex)
+		mutex->unlock();
+}
+
+void MemoryTracker::recordFree(const void *ptr) {
+	if (mutex)
+		mutex->lock();
+
+	if (!insideTracker && blocks) {
+		insideTracker = true;
+
+		BlockMap::iterator i = blocks->find(ptr);
+		if (i != blocks->end()) {
+			TagStats &stats = tags[i->_value.tag];
+			stats.liveBytes -= i->_value.size;
+			--stats.liveBlocks;
+			blocks->erase(i);
+		}
+
+		insideTracker = false;
+	}
+
+	if (mutex)
+		mutex->unlock();
+}
+
+void MemoryTracker::getStats(Array<TagStats> &stats) {
+	stats.clear();
+	if (!_enabled)
+		return;
+
+	if (mutex)
+		mutex->lock();
+	for (int i = 0; i < numTags; ++i) {
+		if (tags[i].allocations)
+			stats.push_back(tags[i]);
+	}
+	if (mutex)
+		mutex->unlock();
+
+	sort(stats.begin(), stats.end(), compareLiveBytes);
+}
+
+void MemoryTracker::resetPeaks() {
+	if (mutex)
+		mutex->lock();
+	for (int i = 0; i < numTags; ++i)
+		tags[i].peakBytes = tags[i].liveBytes;
+	if (mutex)
+		mutex->unlock();
+}
+
+void MemoryTracker::logStats() {
+	Array<TagStats> stats;
+	getStats(stats);
+
+	size_t total = 0;
+	for (uint i = 0; i < stats.size(); ++i) {
+		debug("memory: %-24s %9u KB live, %9u KB peak, %7u blocks", stats[i].name,
+		      (uint)(stats[i].liveBytes / 1024), (uint)(stats[i].peakBytes / 1024), stats[i].liveBlocks);
+		total += stats[i].liveBytes;
+	}
+	debug("memory: %u KB live in total", (uint)(total / 1024));
+}
+
+void MemoryTracker::logTimerProc(void *refCon) {
+	logStats();
+}
+
+void MemoryTracker::setLogInterval(uint seconds) {
+	if (seconds == logInterval || !g_system)
+		return;
+
+	TimerManager *timerManager = g_system->getTimerManager();
+	if (logInterval)
+		timerManager->removeTimerProc(&logTimerProc);
+	logInterval = seconds;
+	if (logInterval)
+		timerManager->installTimerProc(&logTimerProc, logInterval * 1000000, nullptr, "memoryTracker");
+}
+
+} // End of namespace Common
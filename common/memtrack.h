@@ -0,0 +1,154 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_MEMTRACK_H
+#define COMMON_MEMTRACK_H
+
+#include "common/scummsys.h"
+#include "common/array.h"
+#include "common/noncopyable.h"
+
+namespace Common {
+
+/**
+ * Optional accounting of the memory handed out by the larger allocators:
+ * memory pools, frame arenas, surfaces and the engine resource managers.
+ *
+ * Every tracked allocation is charged to the tag that is current when it
+ * is made. Tags are selected with a MemoryTagScope, so a subsystem only
+ * needs to wrap its loading code in a scope to have everything allocated
+ * below it reported under its own name.
+ *
+ * The current tag is shared by all threads, so allocations made by other
+ * threads while a scope is active are charged to that scope's tag.
+ *
+ * Tracking is off by default. While it is off, trackAlloc() and
+ * trackFree() only test a flag. Memory allocated while tracking was off
+ * is not counted when it is freed later.
+ */
+class MemoryTracker {
+public:
+	typedef int Tag;
+
+	enum {
+		/** Memory allocated outside of any MemoryTagScope. */
+		kUntagged = 0,
+		kMaxTags = 64,
+		kMaxTagNameLength = 32
+	};
+
+	struct TagStats {
+		char name[kMaxTagNameLength];
+		/** The bytes currently allocated. */
+		size_t liveBytes;
+		/** The largest value liveBytes has reached. */
+		size_t peakBytes;
+		/** The number of blocks currently allocated. */
+		uint32 liveBlocks;
+		/** The total number of allocations made. */
+		uint32 allocations;
+	};
+
+	static bool isEnabled() { return _enabled; }
+
+	/**
+	 * Switch tracking on or off. Switching it off discards all statistics.
+	 */
+	static void setEnabled(bool enabled);
+
+	/**
+	 * Return the tag with the given name, registering it if necessary.
+	 * When all tags are used up, kUntagged is returned.
+	 */
+	static Tag getTag(const char *name);
+
+	/** The tag new allocations are charged to. */
+	static Tag getCurrentTag() { return _currentTag; }
+
+	/**
+	 * Record an allocation of size bytes at ptr.
+	 */
+	static void trackAlloc(const void *ptr, size_t size) {
+		if (_enabled && ptr)
+			recordAlloc(ptr, size);
+	}
+
+	/**
+	 * Record that the block at ptr was freed.
+	 */
+	static void trackFree(const void *ptr) {
+		if (_enabled && ptr)
+			recordFree(ptr);
+	}
+
+	/**
+	 * Get the statistics of all tags that have been used, sorted by the
+	 * number of live bytes.
+	 */
+	static void getStats(Array<TagStats> &stats);
+
+	/**
+	 * Set the peaks of all tags back to their current live bytes.
+	 */
+	static void resetPeaks();
+
+	/**
+	 * Print the statistics of all tags to the debug log.
+	 */
+	static void logStats();
+
+	/**
+	 * Log the statistics periodically.
+	 * @param seconds	the interval between two reports, 0 to stop
+	 */
+	static void setLogInterval(uint seconds);
+
+private:
+	friend class MemoryTagScope;
+
+	static void recordAlloc(const void *ptr, size_t size);
+	static void recordFree(const void *ptr);
+	static void logTimerProc(void *refCon);
+
+	static bool _enabled;
+	static Tag _currentTag;
+};
+
+/**
+ * Charges all tracked allocations made during its lifetime to a tag.
+ * Scopes may be nested; the previous tag is restored on destruction.
+ */
+class MemoryTagScope : NonCopyable {
+	MemoryTracker::Tag _previousTag;
+public:
+	explicit MemoryTagScope(const char *name) : _previousTag(MemoryTracker::_currentTag) {
+		if (MemoryTracker::_enabled)
+			MemoryTracker::_currentTag = MemoryTracker::getTag(name);
+	}
+	~MemoryTagScope() {
+		MemoryTracker::_currentTag = _previousTag;
+	}
+};
+
+} // End of namespace Common
+
+#endif
@@ -3,6 +3,7 @@ MODULE := common
 MODULE_OBJS := \
 	achievements.o \
 	archive.o \
+	cachefile.o \
 	config-manager.o \
 	coroutines.o \
 	dcl.o \
@@ -10,6 +11,7 @@ MODULE_OBJS := \
 	error.o \
 	events.o \
 	file.o \
+	framearena.o \
 	fs.o \
 	gui_options.o \
 	hashmap.o \
@@ -21,10 +23,12 @@ MODULE_OBJS := \
 	localization.o \
 	macresman.o \
 	memorypool.o \
+	memtrack.o \
 	md5.o \
 	mutex.o \
 	osd_message_queue.o \
 	platform.o \
+	profiler.o \
 	quicktime.o \
 	random.o \
 	rational.o \
@@ -33,7 +37,9 @@ MODULE_OBJS := \
 	str-enc.o \
 	stream.o \
 	system.o \
+	taskpool.o \
 	textconsole.o \
+	thread.o \
 	tokenizer.o \
 	translation.o \
 	unarj.o \
@@ -60,6 +66,12 @@ MODULE_OBJS += \
 	recorderfile.o
 endif
 
+# The null backend replays recordings in its benchmark mode
+ifeq ($(BACKEND),null)
+MODULE_OBJS += \
+	recorderfile.o
+endif
+
 ifdef USE_UPDATES
 MODULE_OBJS += \
 	updates.o
@@ -74,6 +86,7 @@ MODULE_OBJS += \
 	lua/lcode.o \
 	lua/ldblib.o \
 	lua/ldebug.o \
+	lua/ldump.o \
 	lua/ldo.o \
 	lua/lfunc.o \
 	lua/lgc.o \
@@ -93,9 +106,11 @@ MODULE_OBJS += \
 	lua/ltable.o \
 	lua/ltablib.o \
 	lua/ltm.o \
+	lua/lua_chunkcache.o \
 	lua/lua_persist.o \
 	lua/lua_persistence_util.o \
 	lua/lua_unpersist.o \
+	lua/lundump.o \
 	lua/lvm.o \
 	lua/lzio.o \
 	lua/scummvm_file.o
@@ -57,6 +57,7 @@ public:
  */
 class Mutex {
 	friend class StackLock;
+	friend class ConditionVariable;
 
 	MutexRef _mutex;
 
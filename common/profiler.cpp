@@ -0,0 +1,297 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// The clocks and thread local storage are platform specific
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "common/profiler.h"
+#include "common/system.h"
+
+#if defined(WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif defined(POSIX)
+#include <time.h>
+#endif
+
+#ifdef USE_ZONE_PROFILER
+
+#include "common/mutex.h"
+#include "common/str.h"
+#include "common/stream.h"
+
+#ifdef _MSC_VER
+#define PROFILER_THREAD_LOCAL __declspec(thread)
+#else
+#define PROFILER_THREAD_LOCAL __thread
+#endif
+
+namespace Common {
+
+bool Profiler::_capturing = false;
+
+namespace {
+
+struct ZoneEvent {
+	const char *name;
+	uint32 start;
+	uint32 duration;
+};
+
+/**
+ * The events of one thread. Only the owning thread writes to it; the
+ * buffers are never freed, since a thread may still be using its buffer
+ * when the capture stops.
+ */
+struct ThreadBuffer {
+	ZoneEvent events[Profiler::kEventsPerThread];
+	uint32 count;
+	uint32 generation;
+
+	uint depth;
+	const char *zoneNames[Profiler::kMaxDepth];
+	uint64 zoneStarts[Profiler::kMaxDepth];
+	uint64 frameStart;
+
+	const char *name;
+	uint id;
+	ThreadBuffer *next;
+};
+
+ThreadBuffer *threadBuffers = nullptr;
+uint numThreadBuffers = 0;
+Mutex *bufferMutex = nullptr;
+
+// Frame zones are told apart from the others by this name, and exported
+// on a track of their own
+const char frameZoneName[] = "Frame";
+const uint frameTrackId = 0;
+
+// Incremented by every capture; a buffer from an older capture is
+// emptied by its thread when it records the next event
+uint32 captureGeneration = 0;
+uint64 captureStart = 0;
+
+PROFILER_THREAD_LOCAL ThreadBuffer *threadBuffer = nullptr;
+PROFILER_THREAD_LOCAL const char *threadName = nullptr;
+
+ThreadBuffer *getThreadBuffer() {
+	ThreadBuffer *buffer = threadBuffer;
+	if (!buffer) {
+		buffer = new ThreadBuffer();
+		buffer->generation = captureGeneration;
+		buffer->name = threadName;
+
+		StackLock lock(*bufferMutex);
+		buffer->id = ++numThreadBuffers;
+		buffer->next = threadBuffers;
+		threadBuffers = buffer;
+		threadBuffer = buffer;
+	}
+
+	if (buffer->generation != captureGeneration) {
+		buffer->count = 0;
+		buffer->generation = captureGeneration;
+	}
+
+	return buffer;
+}
+
+void recordEvent(ThreadBuffer *buffer, const char *name, uint64 start, uint64 end) {
+	ZoneEvent &event = buffer->events[buffer->count % Profiler::kEventsPerThread];
+	event.name = name;
+	event.start = (uint32)(start - captureStart);
+	event.duration = (uint32)(end - start);
+	++buffer->count;
+}
+
+void writeEscaped(WriteStream &stream, const char *str) {
+	for (; *str; ++str) {
+		const byte c = *str;
+		if (c < 0x20) {
+			// JSON does not allow control characters in strings
+			stream.writeString(String::format("\\u%04x", c));
+			continue;
+		}
+		if (c == '"' || c == '\\')
+			stream.writeByte('\\');
+		stream.writeByte(c);
+	}
+}
+
+} // End of anonymous namespace
+
+void Profiler::startCapture() {
+	if (!bufferMutex)
+		bufferMutex = new Mutex();
+
+	StackLock lock(*bufferMutex);
+	++captureGeneration;
+	captureStart = getMicros();
+	_capturing = true;
+}
+
+void Profiler::stopCapture() {
+	_capturing = false;
+}
+
+bool Profiler::beginZone(const char *name) {
+	if (!_capturing)
+		return false;
+
+	ThreadBuffer *buffer = getThreadBuffer();
+	if (buffer->depth == kMaxDepth)
+		return false;
+
+	buffer->zoneNames[buffer->depth] = name;
+	buffer->zoneStarts[buffer->depth] = getMicros();
+	++buffer->depth;
+	return true;
+}
+
+void Profiler::endZone() {
+	const uint64 end = getMicros();
+
+	ThreadBuffer *buffer = threadBuffer;
+	if (!buffer || !buffer->depth)
+		return;
+
+	--buffer->depth;
+	const uint64 start = buffer->zoneStarts[buffer->depth];
+
+	if (buffer->generation != captureGeneration) {
+		buffer->count = 0;
+		buffer->generation = captureGeneration;
+	}
+
+	// Zones entered before the current capture started are dropped
+	if (start < captureStart)
+		return;
+
+	recordEvent(buffer, buffer->zoneNames[buffer->depth], start, end);
+}
+
+void Profiler::markFrame() {
+	if (!_capturing)
+		return;
+
+	ThreadBuffer *buffer = getThreadBuffer();
+	const uint64 now = getMicros();
+	const uint64 start = buffer->frameStart;
+	buffer->frameStart = now;
+
+	// The first frame of a capture starts at its first mark
+	if (start < captureStart)
+		return;
+
+	recordEvent(buffer, frameZoneName, start, now);
+}
+
+void Profiler::setThreadName(const char *name) {
+	if (threadName)
+		return;
+
+	threadName = name;
+	if (threadBuffer)
+		threadBuffer->name = name;
+}
+
+uint32 Profiler::getEventCount() {
+	if (!bufferMutex)
+		return 0;
+
+	StackLock lock(*bufferMutex);
+	uint32 count = 0;
+	for (ThreadBuffer *buffer = threadBuffers; buffer; buffer = buffer->next) {
+		if (buffer->generation == captureGeneration)
+			count += buffer->count;
+	}
+	return count;
+}
+
+bool Profiler::exportChromeTrace(WriteStream &stream, uint32 *eventCount) {
+	if (eventCount)
+		*eventCount = 0;
+	if (!bufferMutex)
+		return false;
+
+	StackLock lock(*bufferMutex);
+
+	// The frame track is named first, so every other event follows a comma
+	stream.writeString(String::format("{\"traceEvents\":[\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"Frames\"}}",
+	                                  frameTrackId));
+	for (ThreadBuffer *buffer = threadBuffers; buffer; buffer = buffer->next) {
+		if (buffer->generation != captureGeneration || !buffer->count)
+			continue;
+
+		if (buffer->name) {
+			stream.writeString(String::format(",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"", buffer->id));
+			writeEscaped(stream, buffer->name);
+			stream.writeString("\"}}");
+		}
+
+		// Only the last kEventsPerThread events are still in the buffer
+		const uint32 count = buffer->count;
+		const uint32 oldest = count > (uint32)kEventsPerThread ? count - kEventsPerThread : 0;
+		for (uint32 i = oldest; i < count; ++i) {
+			const ZoneEvent &event = buffer->events[i % kEventsPerThread];
+			const uint tid = event.name == frameZoneName ? frameTrackId : buffer->id;
+			stream.writeString(",\n{\"name\":\"");
+			writeEscaped(stream, event.name);
+			stream.writeString(String::format("\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%u,\"dur\":%u}",
+			                                  tid, event.start, event.duration));
+		}
+
+		if (eventCount)
+			*eventCount += count - oldest;
+	}
+	stream.writeString("\n]}\n");
+
+	return !stream.err();
+}
+
+} // End of namespace Common
+
+#endif
+
+namespace Common {
+
+uint64 Profiler::getMicros() {
+#if defined(WIN32)
+	static LARGE_INTEGER frequency = { { 0, 0 } };
+	if (!frequency.QuadPart)
+		QueryPerformanceFrequency(&frequency);
+
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+	return (uint64)(counter.QuadPart / frequency.QuadPart) * 1000000 +
+	       (uint64)(counter.QuadPart % frequency.QuadPart) * 1000000 / frequency.QuadPart;
+#elif defined(POSIX) && defined(CLOCK_MONOTONIC)
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#else
+	return (uint64)g_system->getMillis(true) * 1000;
+#endif
+}
+
+} // End of namespace Common
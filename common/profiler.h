@@ -0,0 +1,180 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_PROFILER_H
+#define COMMON_PROFILER_H
+
+#include "common/scummsys.h"
+
+#ifdef USE_ZONE_PROFILER
+
+#include "common/noncopyable.h"
+
+namespace Common {
+
+class WriteStream;
+
+/**
+ * A low overhead profiler for code zones, enabled with the configure
+ * option --enable-zone-profiler.
+ *
+ * Zones are marked with the PROFILE_ZONE macro. While a capture is
+ * running, every zone that ends is recorded with its start time and
+ * duration into a ring buffer belonging to the calling thread, so that
+ * threads never contend for a lock while recording. When a buffer is
+ * full, the oldest events are overwritten.
+ *
+ * The recorded events can be exported in the JSON format understood by
+ * the trace viewers of Chrome (chrome://tracing) and Perfetto. Zones
+ * nest naturally in these viewers, giving a hierarchical view of each
+ * frame.
+ */
+class Profiler {
+public:
+	enum {
+		/** The number of events kept per thread. */
+		kEventsPerThread = 64 * 1024,
+		/** The deepest zone nesting recorded; deeper zones are ignored. */
+		kMaxDepth = 64
+	};
+
+	static bool isCapturing() { return _capturing; }
+
+	/**
+	 * Discard all recorded events and start recording.
+	 */
+	static void startCapture();
+
+	/**
+	 * Stop recording. Zones already entered are still recorded when they
+	 * end.
+	 */
+	static void stopCapture();
+
+	/**
+	 * Enter a zone. The name must be a string literal, it is only stored
+	 * as a pointer.
+	 * @return true if the zone is recorded and endZone() must be called
+	 */
+	static bool beginZone(const char *name);
+
+	/**
+	 * Leave the zone entered last by the calling thread.
+	 */
+	static void endZone();
+
+	/**
+	 * Mark the end of a frame and the start of the next one. The time
+	 * between two marks of the same thread is recorded as a "Frame" zone,
+	 * which is shown on a separate "Frames" track of the trace, since it
+	 * does not nest with the zones of the calling thread.
+	 */
+	static void markFrame();
+
+	/**
+	 * Name the calling thread in the trace. This may be called before a
+	 * capture starts, and does nothing if the thread has already been
+	 * named. The name must be a string literal.
+	 */
+	static void setThreadName(const char *name);
+
+	/**
+	 * The number of events recorded since the capture started, including
+	 * those that have been overwritten.
+	 */
+	static uint32 getEventCount();
+
+	/**
+	 * Write the recorded events as a Chrome trace. Stop the capture first,
+	 * otherwise the events of other threads may change while they are
+	 * being written.
+	 *
+	 * @param eventCount	if not null, receives the number of events written,
+	 *						which excludes those that have been overwritten
+	 */
+	static bool exportChromeTrace(WriteStream &stream, uint32 *eventCount = nullptr);
+
+	/**
+	 * A monotonic clock with microsecond resolution, if the platform has
+	 * one.
+	 */
+	static uint64 getMicros();
+
+private:
+	static bool _capturing;
+};
+
+/**
+ * Records the time between its construction and destruction as a zone.
+ */
+class ProfileZone : NonCopyable {
+	bool _active;
+public:
+	explicit ProfileZone(const char *name) : _active(Profiler::beginZone(name)) {}
+	~ProfileZone() {
+		if (_active)
+			Profiler::endZone();
+	}
+};
+
+} // End of namespace Common
+
+#define PROFILE_ZONE_NAME2(line) profileZone ## line
+#define PROFILE_ZONE_NAME(line) PROFILE_ZONE_NAME2(line)
+
+/**
+ * Profile the rest of the current block as a zone with the given name.
+ */
+#define PROFILE_ZONE(name) Common::ProfileZone PROFILE_ZONE_NAME(__LINE__)(name)
+
+/**
+ * Mark the end of the current frame, see Profiler::markFrame().
+ */
+#define PROFILE_FRAME() Common::Profiler::markFrame()
+
+/**
+ * Name the calling thread in the profiler's traces.
+ */
+#define PROFILE_THREAD_NAME(name) Common::Profiler::setThreadName(name)
+
+#else
+
+namespace Common {
+
+class Profiler {
+public:
+	/**
+	 * A monotonic clock with microsecond resolution, if the platform has
+	 * one. It is available without the zone profiler too.
+	 */
+	static uint64 getMicros();
+};
+
+} // End of namespace Common
+
+#define PROFILE_ZONE(name) do {} while (0)
+#define PROFILE_FRAME() do {} while (0)
+#define PROFILE_THREAD_NAME(name) do {} while (0)
+
+#endif
+
+#endif
@@ -27,6 +27,8 @@
 
 namespace Common {
 
+RandomSource::SeedProvider RandomSource::_seedProvider = nullptr;
+
 RandomSource::RandomSource(const String &name) {
 	// Use system time as RNG seed. Normally not a good idea, if you are using
 	// a RNG for security purposes, but good enough for our purposes.
@@ -35,10 +37,17 @@ RandomSource::RandomSource(const String &name) {
 #ifdef ENABLE_EVENTRECORDER
 	setSeed(g_eventRec.getRandomSeed(name));
 #else
-	setSeed(g_system->getMillis());
+	uint32 seed;
+	if (!_seedProvider || !_seedProvider(name, seed))
+		seed = g_system->getMillis();
+	setSeed(seed);
 #endif
 }
 
+void RandomSource::setSeedProvider(SeedProvider provider) {
+	_seedProvider = provider;
+}
+
 void RandomSource::setSeed(uint32 seed) {
 	_randSeed = seed;
 }
@@ -34,9 +34,19 @@ class String;
  * cryptographic purposes, it serves our purposes just fine.
  */
 class RandomSource {
+public:
+	/**
+	 * A function providing the seed for the randomness source with the
+	 * given name, for example to replay a recorded session.
+	 * @return false if it has no seed for that name
+	 */
+	typedef bool (*SeedProvider)(const String &name, uint32 &seed);
+
 private:
 	uint32 _randSeed;
 
+	static SeedProvider _seedProvider;
+
 public:
 	/**
 	 * Construct a new randomness source with the specific name.
@@ -46,6 +56,13 @@ public:
 	 */
 	RandomSource(const String &name);
 
+	/**
+	 * Set the function asked for the seed of new randomness sources,
+	 * or nullptr to seed them from the system time again. Builds with
+	 * the event recorder ignore it, the recorder provides the seeds.
+	 */
+	static void setSeedProvider(SeedProvider provider);
+
 	void setSeed(uint32 seed);
 
 	uint32 getSeed() const {
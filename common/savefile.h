@@ -201,6 +201,17 @@ public:
 	 */
 	virtual StringArray listSavefiles(const String &pattern) = 0;
 
+	/**
+	 * Returns the time the given savefile was last modified, in seconds
+	 * since an arbitrary epoch. This is only meant to tell whether the
+	 * savefile changed, without opening it.
+	 *
+	 * @param name  The name of the savefile.
+	 * @return the modification time, or 0 if the file does not exist or
+	 *         its modification time is unknown.
+	 */
+	virtual uint32 getModificationTime(const String &name) { return 0; }
+
 	/**
 	 * Refreshes the save files list (because some new files could've been added)
 	 * and remembers the "locked" files list. These files could not be used
@@ -25,6 +25,7 @@
 #include "common/memstream.h"
 #include "common/substream.h"
 #include "common/str.h"
+#include "common/taskpool.h"
 
 namespace Common {
 
@@ -463,6 +464,288 @@ SeekableReadStream *wrapBufferedSeekableReadStream(SeekableReadStream *parentStr
 
 namespace {
 
+/**
+ * Wrapper class which reads ahead in any given SeekableReadStream, with a
+ * window adapting to the access pattern.
+ * @see wrapReadAheadSeekableReadStream
+ */
+class ReadAheadSeekableReadStream : public SeekableReadStream {
+protected:
+	enum {
+		kBlockCount = 3,
+		kMinWindow = 4096
+	};
+
+	struct Block {
+		int32 start;
+		uint32 size;
+		uint32 lastUse;
+		byte *data;
+	};
+
+	DisposablePtr<SeekableReadStream> _parentStream;
+	int32 _parentPos;
+	int32 _size;
+	int32 _pos;
+	bool _eos;
+
+	Block _blocks[kBlockCount];
+	uint32 _useCounter;
+	uint32 _minWindow;
+	uint32 _maxWindow;
+	uint32 _window;
+	int32 _lastReadEnd;
+
+	// While a prefetch is running, its block and the parent stream belong
+	// to the task. Everything else is only touched by the reading thread.
+	bool _async;
+	int _prefetchBlock;
+	uint32 _prefetchSize;
+	Future<void> _prefetch;
+
+	int findBlock(int32 pos) const;
+	int leastRecentBlock() const;
+	uint32 readParent(int32 start, byte *dst, uint32 size);
+	int fillBlock(int32 start);
+
+	void startPrefetch(int32 start);
+	void runPrefetch();
+	void finishPrefetch();
+
+public:
+	ReadAheadSeekableReadStream(SeekableReadStream *parentStream, uint32 maxWindow, DisposeAfterUse::Flag disposeParentStream, bool asyncPrefetch);
+	virtual ~ReadAheadSeekableReadStream();
+
+	virtual bool eos() const { return _eos; }
+	virtual bool err() const;
+	virtual void clearErr();
+
+	virtual int32 pos() const { return _pos; }
+	virtual int32 size() const { return _size; }
+
+	virtual bool seek(int32 offset, int whence = SEEK_SET);
+	virtual uint32 read(void *dataPtr, uint32 dataSize);
+};
+
+ReadAheadSeekableReadStream::ReadAheadSeekableReadStream(SeekableReadStream *parentStream, uint32 maxWindow, DisposeAfterUse::Flag disposeParentStream, bool asyncPrefetch)
+	: _parentStream(parentStream, disposeParentStream),
+	_useCounter(0),
+	_minWindow(MIN<uint32>(kMinWindow, maxWindow)),
+	_maxWindow(maxWindow),
+	_lastReadEnd(-1),
+	_async(asyncPrefetch),
+	_prefetchBlock(-1),
+	_prefetchSize(0) {
+
+	assert(parentStream && maxWindow > 0);
+	_parentPos = _parentStream->pos();
+	_size = _parentStream->size();
+	_pos = _parentPos;
+	_eos = false;
+	_window = _minWindow;
+
+	for (int i = 0; i < kBlockCount; ++i) {
+		_blocks[i].start = 0;
+		_blocks[i].size = 0;
+		_blocks[i].lastUse = 0;
+		_blocks[i].data = nullptr;
+	}
+}
+
+ReadAheadSeekableReadStream::~ReadAheadSeekableReadStream() {
+	finishPrefetch();
+	for (int i = 0; i < kBlockCount; ++i)
+		delete[] _blocks[i].data;
+}
+
+int ReadAheadSeekableReadStream::findBlock(int32 pos) const {
+	for (int i = 0; i < kBlockCount; ++i) {
+		if (i != _prefetchBlock && pos >= _blocks[i].start && pos < _blocks[i].start + (int32)_blocks[i].size)
+			return i;
+	}
+	return -1;
+}
+
+int ReadAheadSeekableReadStream::leastRecentBlock() const {
+	int oldest = -1;
+	for (int i = 0; i < kBlockCount; ++i) {
+		if (i != _prefetchBlock && (oldest == -1 || _blocks[i].lastUse < _blocks[oldest].lastUse))
+			oldest = i;
+	}
+	return oldest;
+}
+
+uint32 ReadAheadSeekableReadStream::readParent(int32 start, byte *dst, uint32 size) {
+	if (_parentPos != start) {
+		_parentStream->seek(start);
+		_parentPos = start;
+	}
+
+	uint32 n = _parentStream->read(dst, size);
+	_parentPos += n;
+	return n;
+}
+
+int ReadAheadSeekableReadStream::fillBlock(int32 start) {
+	// Reads continuing after the previous one, or skipping ahead by less
+	// than the window, are served better by a larger window. Anything else
+	// is random access and only needs a small one.
+	if (_lastReadEnd >= 0 && start >= _lastReadEnd && start - _lastReadEnd < (int32)_window)
+		_window = MIN(_window * 2, _maxWindow);
+	else
+		_window = _minWindow;
+
+	int index = leastRecentBlock();
+	Block &block = _blocks[index];
+	if (!block.data)
+		block.data = new byte[_maxWindow];
+
+	block.start = start;
+	block.size = readParent(start, block.data, MIN<uint32>(_window, _size - start));
+	block.lastUse = ++_useCounter;
+	_lastReadEnd = start + block.size;
+
+	if (_async && _window == _maxWindow)
+		startPrefetch(_lastReadEnd);
+
+	return index;
+}
+
+void ReadAheadSeekableReadStream::startPrefetch(int32 start) {
+	if (start >= _size || findBlock(start) != -1)
+		return;
+
+	int index = leastRecentBlock();
+	Block &block = _blocks[index];
+	if (!block.data)
+		block.data = new byte[_maxWindow];
+
+	block.start = start;
+	block.size = 0;
+	_prefetchBlock = index;
+	_prefetchSize = MIN<uint32>(_maxWindow, _size - start);
+	_prefetch = TaskMan.submit(new Functor0Mem<void, ReadAheadSeekableReadStream>(this, &ReadAheadSeekableReadStream::runPrefetch));
+}
+
+void ReadAheadSeekableReadStream::runPrefetch() {
+	Block &block = _blocks[_prefetchBlock];
+	_prefetchSize = readParent(block.start, block.data, _prefetchSize);
+}
+
+void ReadAheadSeekableReadStream::finishPrefetch() {
+	if (_prefetchBlock == -1)
+		return;
+
+	_prefetch.wait();
+	_prefetch = Future<void>();
+
+	Block &block = _blocks[_prefetchBlock];
+	block.size = _prefetchSize;
+	block.lastUse = ++_useCounter;
+	_lastReadEnd = block.start + block.size;
+	_prefetchBlock = -1;
+}
+
+bool ReadAheadSeekableReadStream::err() const {
+	// A running prefetch owns the parent stream until it is done
+	if (_prefetchBlock != -1)
+		_prefetch.wait();
+	return _parentStream->err();
+}
+
+void ReadAheadSeekableReadStream::clearErr() {
+	finishPrefetch();
+	_eos = false;
+	_parentStream->clearErr();
+}
+
+bool ReadAheadSeekableReadStream::seek(int32 offset, int whence) {
+	int32 newPos = offset;
+	switch (whence) {
+	case SEEK_CUR:
+		newPos += _pos;
+		break;
+	case SEEK_END:
+		newPos += _size;
+		break;
+	default:
+		break;
+	}
+
+	if (newPos < 0 || newPos > _size)
+		return false;
+
+	// Only move the logical position, the parent is positioned on demand
+	_pos = newPos;
+	_eos = false;
+	return true;
+}
+
+uint32 ReadAheadSeekableReadStream::read(void *dataPtr, uint32 dataSize) {
+	byte *dst = (byte *)dataPtr;
+	uint32 alreadyRead = 0;
+
+	while (dataSize > 0) {
+		if (_pos >= _size) {
+			_eos = true;
+			break;
+		}
+
+		int index = findBlock(_pos);
+		if (index == -1 && _prefetchBlock != -1) {
+			finishPrefetch();
+			index = findBlock(_pos);
+			// Keep one window ahead while the prefetches are being used
+			if (index != -1)
+				startPrefetch(_lastReadEnd);
+		}
+
+		if (index == -1 && dataSize >= _maxWindow) {
+			// Large reads do not benefit from caching, read them directly
+			finishPrefetch();
+			uint32 n = readParent(_pos, dst, dataSize);
+			_lastReadEnd = _pos + n;
+			_pos += n;
+			alreadyRead += n;
+			if (n < dataSize)
+				_eos = true;
+			break;
+		}
+
+		if (index == -1) {
+			index = fillBlock(_pos);
+			if (_blocks[index].size == 0) {
+				_eos = true;
+				break;
+			}
+		}
+
+		Block &block = _blocks[index];
+		block.lastUse = ++_useCounter;
+		uint32 offset = _pos - block.start;
+		uint32 n = MIN(dataSize, block.size - offset);
+		memcpy(dst, block.data + offset, n);
+		dst += n;
+		_pos += n;
+		alreadyRead += n;
+		dataSize -= n;
+	}
+
+	return alreadyRead;
+}
+
+} // End of anonymous namespace
+
+SeekableReadStream *wrapReadAheadSeekableReadStream(SeekableReadStream *parentStream, uint32 maxWindow, DisposeAfterUse::Flag disposeParentStream, bool asyncPrefetch) {
+	if (parentStream)
+		return new ReadAheadSeekableReadStream(parentStream, maxWindow, disposeParentStream, asyncPrefetch);
+	return nullptr;
+}
+
+#pragma mark -
+
+namespace {
+
 /**
  * Wrapper class which adds buffering to any WriteStream.
  */
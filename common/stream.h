@@ -610,6 +610,17 @@ public:
 	 */
 	virtual bool skip(uint32 offset) { return seek(offset, SEEK_CUR); }
 
+	/**
+	 * Return a pointer to the whole contents of the stream if they are
+	 * accessible in memory without copying, e.g. because the stream wraps
+	 * a memory buffer or a memory mapped file. size() bytes can be read
+	 * from it, independently of the current position. The pointer stays
+	 * valid until the stream is destroyed and must not be written to.
+	 *
+	 * @return the pointer, or 0 if the stream does not provide one
+	 */
+	virtual const byte *getMappedData() const { return nullptr; }
+
 	/**
 	 * Reads at most one less than the number of characters specified
 	 * by bufSize from the and stores them in the string buf. Reading
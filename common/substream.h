@@ -77,6 +77,11 @@ public:
 	virtual int32 size() const { return _end - _begin; }
 
 	virtual bool seek(int32 offset, int whence = SEEK_SET);
+
+	virtual const byte *getMappedData() const {
+		const byte *data = _parentStream->getMappedData();
+		return data ? data + _begin : nullptr;
+	}
 };
 
 /**
@@ -100,6 +105,8 @@ public:
 	virtual bool seek(int32 offset, int whence = SEEK_SET) { return SeekableSubReadStream::seek(offset, whence); }
 	void hexdump(int len, int bytesPerLine = 16, int startOffset = 0) { SeekableSubReadStream::hexdump(len, bytesPerLine, startOffset); }
 	bool skip(uint32 offset) { return SeekableSubReadStream::seek(offset, SEEK_CUR); }
+
+	const byte *getMappedData() const { return SeekableSubReadStream::getMappedData(); }
 };
 
 /**
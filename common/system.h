@@ -1233,6 +1233,77 @@ public:
 
 	//@}
 
+	/**
+	 * @name Thread handling
+	 * Optional support for worker threads, used by Common::Thread,
+	 * Common::ConditionVariable and Common::TaskPool. Code running on
+	 * such a thread must not call into the graphics, event or sound parts
+	 * of the OSystem API; it may only use mutexes and the methods below.
+	 *
+	 * Backends without thread support keep the default implementations:
+	 * createThread() fails, and conditions are no-ops. Callers have to
+	 * fall back to doing the work on the calling thread in that case.
+	 */
+	//@{
+
+	typedef struct OpaqueThread *ThreadRef;
+	typedef struct OpaqueCondition *ConditionRef;
+	typedef void (*ThreadProc)(void *param);
+
+	/**
+	 * Start a new thread running the given procedure.
+	 * @param proc	the procedure to run.
+	 * @param param	the parameter passed to the procedure.
+	 * @return the new thread, or 0 if threads are not supported or an
+	 *         error occurred.
+	 */
+	virtual ThreadRef createThread(ThreadProc proc, void *param) { return 0; }
+
+	/**
+	 * Wait for the given thread to finish and free its resources.
+	 * Every thread created by createThread() has to be joined exactly once.
+	 * @param thread	the thread to join.
+	 */
+	virtual void joinThread(ThreadRef thread) {}
+
+	/**
+	 * Create a new condition variable.
+	 * @return the newly created condition, or 0 if an error occurred or
+	 *         threads are not supported.
+	 */
+	virtual ConditionRef createCondition() { return 0; }
+
+	/**
+	 * Atomically unlock the given mutex and wait for the condition to be
+	 * signalled, then lock the mutex again. The mutex has to be locked
+	 * exactly once by the calling thread. Like with POSIX conditions,
+	 * spurious wake ups are possible, so the caller must check its
+	 * predicate in a loop.
+	 * @param cond	the condition to wait for.
+	 * @param mutex	the mutex protecting the predicate.
+	 */
+	virtual void waitCondition(ConditionRef cond, MutexRef mutex) {}
+
+	/**
+	 * Wake up one thread waiting for the given condition.
+	 * @param cond	the condition to signal.
+	 */
+	virtual void signalCondition(ConditionRef cond) {}
+
+	/**
+	 * Wake up all threads waiting for the given condition.
+	 * @param cond	the condition to signal.
+	 */
+	virtual void broadcastCondition(ConditionRef cond) {}
+
+	/**
+	 * Delete the given condition. No thread may be waiting for it.
+	 * @param cond	the condition to delete.
+	 */
+	virtual void deleteCondition(ConditionRef cond) {}
+
+	//@}
+
 
 
 	/** @name Sound */
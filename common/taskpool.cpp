@@ -0,0 +1,250 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/taskpool.h"
+
+namespace Common {
+
+DECLARE_SINGLETON(TaskPool);
+
+void TaskBase::retain() {
+	StackLock lock(_mutex);
+	++_refCount;
+}
+
+void TaskBase::release() {
+	_mutex.lock();
+	bool unused = --_refCount == 0;
+	_mutex.unlock();
+
+	if (unused)
+		delete this;
+}
+
+bool TaskBase::isDone() {
+	StackLock lock(_mutex);
+	return _done;
+}
+
+void TaskBase::setDone() {
+	StackLock lock(_mutex);
+	_done = true;
+}
+
+
+#pragma mark -
+
+
+FutureBase::FutureBase(TaskPool *pool, TaskBase *task) : _pool(pool), _task(task) {
+	_task->retain();
+}
+
+FutureBase::FutureBase(const FutureBase &future) : _pool(future._pool), _task(future._task) {
+	if (_task)
+		_task->retain();
+}
+
+FutureBase::~FutureBase() {
+	if (_task)
+		_task->release();
+}
+
+FutureBase &FutureBase::operator=(const FutureBase &future) {
+	if (future._task)
+		future._task->retain();
+	if (_task)
+		_task->release();
+	_pool = future._pool;
+	_task = future._task;
+	return *this;
+}
+
+bool FutureBase::isReady() const {
+	assert(_task);
+	return _task->isDone();
+}
+
+void FutureBase::wait() const {
+	assert(_task);
+	// Unfinished tasks keep their pool alive
+	if (!_task->isDone())
+		_pool->wait(_task);
+}
+
+
+#pragma mark -
+
+
+TaskPool::TaskPool(uint threadCount) : _threadCount(0), _nextQueue(0), _pendingCount(0), _activeCount(0), _shutdown(false) {
+	// All queues have to exist before the first worker starts stealing
+	for (uint i = 0; i < threadCount; ++i)
+		_workers.push_back(new Worker(this, i));
+
+	// The workers wait for _threadCount to be final before they start
+	StackLock lock(_mutex);
+	for (uint i = 0; i < threadCount; ++i) {
+		if (!_workers[i]->thread.start(workerProc, _workers[i]))
+			break;
+		++_threadCount;
+	}
+}
+
+TaskPool::~TaskPool() {
+	_mutex.lock();
+	_shutdown = true;
+	_workCond.broadcast();
+	_mutex.unlock();
+
+	// Workers run the queued tasks before they stop. They may still steal
+	// from each other until then, so no queue is freed before all joined.
+	for (uint i = 0; i < _workers.size(); ++i)
+		_workers[i]->thread.join();
+	for (uint i = 0; i < _workers.size(); ++i)
+		delete _workers[i];
+}
+
+void TaskPool::workerProc(void *param) {
+	Worker *worker = (Worker *)param;
+	worker->pool->workerLoop(worker->index);
+}
+
+void TaskPool::workerLoop(uint index) {
+	_mutex.lock();
+	_mutex.unlock();
+
+	for (;;) {
+		TaskBase *task = takeTask(index);
+		if (task) {
+			runTask(task);
+			continue;
+		}
+
+		StackLock lock(_mutex);
+		while (_pendingCount == 0 && !_shutdown)
+			_workCond.wait(_mutex);
+		if (_pendingCount == 0)
+			return;
+	}
+}
+
+void TaskPool::schedule(TaskBase *task) {
+	task->retain();
+
+	if (_threadCount == 0) {
+		_mutex.lock();
+		++_activeCount;
+		_mutex.unlock();
+		runTask(task);
+		return;
+	}
+
+	StackLock lock(_mutex);
+	Worker *worker = _workers[_nextQueue];
+	_nextQueue = (_nextQueue + 1) % _threadCount;
+
+	worker->mutex.lock();
+	worker->queue.push_back(task);
+	worker->mutex.unlock();
+
+	++_pendingCount;
+	++_activeCount;
+	_workCond.signal();
+}
+
+TaskBase *TaskPool::takeTask(uint index) {
+	TaskBase *task = nullptr;
+
+	if (index < _threadCount) {
+		Worker *worker = _workers[index];
+		worker->mutex.lock();
+		if (!worker->queue.empty()) {
+			task = worker->queue.back();
+			worker->queue.pop_back();
+		}
+		worker->mutex.unlock();
+	}
+
+	for (uint i = 0; !task && i < _threadCount; ++i) {
+		Worker *victim = _workers[(index + 1 + i) % _threadCount];
+		victim->mutex.lock();
+		if (!victim->queue.empty()) {
+			task = victim->queue.front();
+			victim->queue.pop_front();
+		}
+		victim->mutex.unlock();
+	}
+
+	if (task) {
+		StackLock lock(_mutex);
+		--_pendingCount;
+	}
+
+	return task;
+}
+
+void TaskPool::runTask(TaskBase *task) {
+	task->run();
+	task->setDone();
+
+	// Waiters check the task with _mutex held, so they cannot miss this
+	_mutex.lock();
+	--_activeCount;
+	_doneCond.broadcast();
+	_mutex.unlock();
+
+	task->release();
+}
+
+void TaskPool::wait(TaskBase *task) {
+	for (;;) {
+		if (task->isDone())
+			return;
+
+		TaskBase *other = takeTask(_threadCount);
+		if (other) {
+			runTask(other);
+			continue;
+		}
+
+		StackLock lock(_mutex);
+		while (!task->isDone() && _pendingCount == 0)
+			_doneCond.wait(_mutex);
+	}
+}
+
+void TaskPool::waitAll() {
+	for (;;) {
+		TaskBase *task = takeTask(_threadCount);
+		if (task) {
+			runTask(task);
+			continue;
+		}
+
+		StackLock lock(_mutex);
+		if (_activeCount == 0)
+			return;
+		while (_activeCount != 0 && _pendingCount == 0)
+			_doneCond.wait(_mutex);
+	}
+}
+
+} // End of namespace Common
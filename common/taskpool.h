@@ -0,0 +1,224 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_TASKPOOL_H
+#define COMMON_TASKPOOL_H
+
+#include "common/scummsys.h"
+#include "common/array.h"
+#include "common/func.h"
+#include "common/list.h"
+#include "common/mutex.h"
+#include "common/ptr.h"
+#include "common/singleton.h"
+#include "common/thread.h"
+
+namespace Common {
+
+class TaskPool;
+
+/**
+ * Base class of the work items run by a TaskPool. It is the state shared
+ * by the pool and the futures of the task, so it has its own mutex and is
+ * deleted when neither refers to it anymore.
+ */
+class TaskBase : NonCopyable {
+	friend class TaskPool;
+	friend class FutureBase;
+
+	Mutex _mutex;
+	int  _refCount;
+	bool _done;
+
+	void retain();
+	void release();
+	bool isDone();
+	void setDone();
+
+public:
+	TaskBase() : _refCount(0), _done(false) {}
+	virtual ~TaskBase() {}
+
+	virtual void run() = 0;
+};
+
+/**
+ * A task calling a functor and keeping its result.
+ */
+template<class T>
+class FunctorTask : public TaskBase {
+	ScopedPtr<Functor0<T> > _func;
+	T _result;
+
+public:
+	explicit FunctorTask(Functor0<T> *func) : _func(func), _result() {}
+
+	virtual void run() { _result = (*_func)(); }
+	const T &getResult() const { return _result; }
+};
+
+template<>
+class FunctorTask<void> : public TaskBase {
+	ScopedPtr<Functor0<void> > _func;
+
+public:
+	explicit FunctorTask(Functor0<void> *func) : _func(func) {}
+
+	virtual void run() { (*_func)(); }
+};
+
+/**
+ * A reference to a submitted task, which can be used to wait for it.
+ * The task is deleted once it is finished and no future refers to it.
+ *
+ * A future may outlive its pool, since the pool finishes all tasks before
+ * it is destroyed. Its result stays available then.
+ */
+class FutureBase {
+protected:
+	TaskPool *_pool;
+	TaskBase *_task;
+
+public:
+	FutureBase() : _pool(nullptr), _task(nullptr) {}
+	FutureBase(TaskPool *pool, TaskBase *task);
+	FutureBase(const FutureBase &future);
+	~FutureBase();
+
+	FutureBase &operator=(const FutureBase &future);
+
+	bool isValid() const { return _task != nullptr; }
+
+	/** Check whether the task has finished, without waiting. */
+	bool isReady() const;
+
+	/**
+	 * Wait for the task to finish. While waiting, the calling thread runs
+	 * other queued tasks, so tasks may wait for the tasks they submitted.
+	 */
+	void wait() const;
+};
+
+template<class T>
+class Future : public FutureBase {
+public:
+	Future() {}
+	Future(TaskPool *pool, FunctorTask<T> *task) : FutureBase(pool, task) {}
+
+	/** Wait for the task and return its result. */
+	const T &get() const {
+		wait();
+		return static_cast<FunctorTask<T> *>(_task)->getResult();
+	}
+};
+
+template<>
+class Future<void> : public FutureBase {
+public:
+	Future() {}
+	Future(TaskPool *pool, FunctorTask<void> *task) : FutureBase(pool, task) {}
+
+	void get() const { wait(); }
+};
+
+/**
+ * A pool of worker threads running submitted tasks.
+ *
+ * Every worker has its own queue. Submitted tasks are distributed over the
+ * queues, a worker takes the newest task of its own queue and steals the
+ * oldest task of another queue when its own one is empty. Threads waiting
+ * for a future help by running queued tasks too.
+ *
+ * If the backend does not support threads, no worker is started and
+ * tasks are run when they are submitted.
+ *
+ * Tasks must not use the graphics, event or sound parts of OSystem.
+ */
+class TaskPool : public Singleton<TaskPool> {
+public:
+	enum {
+		kDefaultThreadCount = 3
+	};
+
+	explicit TaskPool(uint threadCount = kDefaultThreadCount);
+	~TaskPool();
+
+	/** Return the number of worker threads actually running. */
+	uint getThreadCount() const { return _threadCount; }
+
+	/**
+	 * Queue a functor to be called on a worker thread.
+	 * The pool takes ownership of the functor.
+	 */
+	template<class T>
+	Future<T> submit(Functor0<T> *func) {
+		FunctorTask<T> *task = new FunctorTask<T>(func);
+		Future<T> future(this, task);
+		schedule(task);
+		return future;
+	}
+
+	/** Wait for all submitted tasks to finish. */
+	void waitAll();
+
+private:
+	friend class FutureBase;
+
+	struct Worker {
+		TaskPool *pool;
+		uint index;
+		Thread thread;
+		Mutex mutex;
+		List<TaskBase *> queue;
+
+		Worker(TaskPool *p, uint i) : pool(p), index(i) {}
+	};
+
+	Array<Worker *> _workers;
+	uint _threadCount;
+	uint _nextQueue;
+
+	// Protects the counters and the shutdown flag. Never taken while a
+	// worker queue mutex or the mutex of a task is held.
+	Mutex _mutex;
+	ConditionVariable _workCond;
+	ConditionVariable _doneCond;
+	uint _pendingCount;
+	uint _activeCount;
+	bool _shutdown;
+
+	static void workerProc(void *param);
+	void workerLoop(uint index);
+
+	void schedule(TaskBase *task);
+	TaskBase *takeTask(uint index);
+	void runTask(TaskBase *task);
+
+	void wait(TaskBase *task);
+};
+
+} // End of namespace Common
+
+/** Shortcut for accessing the shared task pool. */
+#define TaskMan Common::TaskPool::instance()
+
+#endif
@@ -0,0 +1,106 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/thread.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+
+namespace Common {
+
+Thread::Thread() : _thread(nullptr) {
+}
+
+Thread::~Thread() {
+	join();
+}
+
+bool Thread::start(OSystem::ThreadProc proc, void *param) {
+	assert(g_system);
+	assert(!_thread);
+	_thread = g_system->createThread(proc, param);
+	return _thread != nullptr;
+}
+
+void Thread::join() {
+	if (_thread) {
+		g_system->joinThread(_thread);
+		_thread = nullptr;
+	}
+}
+
+
+#pragma mark -
+
+
+ConditionVariable::ConditionVariable() {
+	assert(g_system);
+	_cond = g_system->createCondition();
+}
+
+ConditionVariable::~ConditionVariable() {
+	g_system->deleteCondition(_cond);
+}
+
+void ConditionVariable::wait(Mutex &mutex) {
+	g_system->waitCondition(_cond, mutex._mutex);
+}
+
+void ConditionVariable::signal() {
+	g_system->signalCondition(_cond);
+}
+
+void ConditionVariable::broadcast() {
+	g_system->broadcastCondition(_cond);
+}
+
+
+#pragma mark -
+
+
+Semaphore::Semaphore(uint count) : _count(count) {
+}
+
+void Semaphore::acquire() {
+	StackLock lock(_mutex);
+	while (_count == 0) {
+		if (!_cond.canWait())
+			error("Semaphore::acquire: Waiting without thread support would never end");
+		_cond.wait(_mutex);
+	}
+	--_count;
+}
+
+bool Semaphore::tryAcquire() {
+	StackLock lock(_mutex);
+	if (_count == 0)
+		return false;
+	--_count;
+	return true;
+}
+
+void Semaphore::release() {
+	StackLock lock(_mutex);
+	++_count;
+	_cond.signal();
+}
+
+} // End of namespace Common
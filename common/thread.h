@@ -0,0 +1,113 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_THREAD_H
+#define COMMON_THREAD_H
+
+#include "common/scummsys.h"
+#include "common/mutex.h"
+#include "common/noncopyable.h"
+#include "common/system.h"
+
+namespace Common {
+
+/**
+ * Wrapper class around the OSystem thread functions.
+ * The thread is joined when the object is destroyed.
+ */
+class Thread : NonCopyable {
+	OSystem::ThreadRef _thread;
+
+public:
+	Thread();
+	~Thread();
+
+	/**
+	 * Start running the given procedure on a new thread.
+	 * @return false if the backend does not support threads or the
+	 *         thread could not be created. In that case, the caller is
+	 *         expected to do the work itself.
+	 */
+	bool start(OSystem::ThreadProc proc, void *param);
+
+	/** Wait for the thread to finish. Does nothing if it is not running. */
+	void join();
+
+	bool isRunning() const { return _thread != nullptr; }
+};
+
+/**
+ * Wrapper class around the OSystem condition functions.
+ */
+class ConditionVariable : NonCopyable {
+	OSystem::ConditionRef _cond;
+
+public:
+	ConditionVariable();
+	~ConditionVariable();
+
+	/**
+	 * Wait until the condition is signalled. The mutex has to be locked
+	 * exactly once by the calling thread. Wake ups can be spurious.
+	 */
+	void wait(Mutex &mutex);
+	void signal();
+	void broadcast();
+
+	/**
+	 * Whether wait() can block. Without thread support, conditions are
+	 * no-ops and wait() returns immediately.
+	 */
+	bool canWait() const { return _cond != nullptr; }
+};
+
+/**
+ * A counting semaphore built on a mutex and a condition.
+ */
+class Semaphore : NonCopyable {
+	Mutex _mutex;
+	ConditionVariable _cond;
+	uint _count;
+
+public:
+	explicit Semaphore(uint count = 0);
+
+	/**
+	 * Decrement the count, waiting for it to become positive first.
+	 * Without thread support, nothing could release it while waiting, so
+	 * the count must already be positive; waiting is an error then.
+	 */
+	void acquire();
+
+	/**
+	 * Decrement the count if it is positive.
+	 * @return false if the count was zero.
+	 */
+	bool tryAcquire();
+
+	/** Increment the count and wake up one waiting thread. */
+	void release();
+};
+
+} // End of namespace Common
+
+#endif
@@ -24,6 +24,7 @@
 #define COMMON_TIMER_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/str.h"
 #include "common/noncopyable.h"
 
@@ -55,6 +56,37 @@ public:
 	 * and no instance of this callback will be running anymore.
 	 */
 	virtual void removeTimerProc(TimerProc proc) = 0;
+
+	/**
+	 * Statistics collected for an installed timer callback while profiling
+	 * is enabled. All times are in microseconds.
+	 */
+	struct CallbackStats {
+		String id;            ///< the id the callback was installed with
+		int32 interval;       ///< the interval of the callback (in microseconds)
+		uint32 calls;         ///< number of invocations
+		uint64 totalTime;     ///< total time spent in the callback (in microseconds)
+		uint32 maxTime;       ///< longest single invocation (in microseconds)
+		uint64 totalLateness; ///< total delay between the scheduled and the actual invocation times (in microseconds)
+		uint32 maxLateness;   ///< longest delay between the scheduled and the actual invocation time (in microseconds)
+
+		CallbackStats() : interval(0), calls(0), totalTime(0), maxTime(0), totalLateness(0), maxLateness(0) {}
+	};
+
+	/**
+	 * Enable or disable collecting statistics about the timer callbacks.
+	 * Enabling profiling resets the statistics collected so far.
+	 * Timer managers which do not support profiling ignore this.
+	 */
+	virtual void setProfiling(bool enable) {}
+
+	/**
+	 * Retrieve the statistics collected for the installed timer callbacks.
+	 *
+	 * @param stats	filled with one entry per installed callback
+	 * @return	false if the timer manager does not support profiling
+	 */
+	virtual bool getCallbackStats(Array<CallbackStats> &stats) { return false; }
 };
 
 } // End of namespace Common
@@ -25,9 +25,39 @@
 #include "common/fs.h"
 #include "common/memstream.h"
 #include "common/system.h"
+#include "common/endian.h"
 
 namespace Common {
 
+namespace {
+
+// Events of the compiled key stream, see setCompileStream()
+enum CompiledEvent {
+	kCompiledEnd = 0,
+	kCompiledKey = 1,
+	kCompiledClosedKey = 2,
+	kCompiledKeyClosure = 3
+};
+
+const uint32 kCompiledTag = MKTAG('C', 'X', 'M', 'L');
+
+void writeCompiledString(WriteStream *stream, const String &str) {
+	stream->writeUint16LE(str.size());
+	stream->write(str.c_str(), str.size());
+}
+
+String readCompiledString(SeekableReadStream *stream) {
+	uint16 size = stream->readUint16LE();
+	String str;
+
+	while (size-- && !stream->eos())
+		str += (char)stream->readByte();
+
+	return str;
+}
+
+} // End of anonymous namespace
+
 XMLParser::~XMLParser() {
 	while (!_activeKey.empty())
 		freeNode(_activeKey.pop());
@@ -80,6 +110,13 @@ void XMLParser::close() {
 bool XMLParser::parserError(const String &errStr) {
 	_state = kParserError;
 
+	if (_stream == nullptr) {
+		// Replaying compiled data, there is no text to point at
+		Common::String errorMessage = Common::String::format("\n  Compiled data:\n\nParser error: %s\n\n", errStr.c_str());
+		g_system->logMessage(LogMessageType::kError, errorMessage.c_str());
+		return false;
+	}
+
 	const int startPosition = _stream->pos();
 	int currentPosition = startPosition;
 	int lineCount = 1;
@@ -159,6 +196,9 @@ bool XMLParser::parseActiveKey(bool closed) {
 
 	ParserNode *key = _activeKey.top();
 
+	if (_compileStream)
+		compileKey(key, closed);
+
 	if (key->name == "xml" && key->header == true) {
 		assert(closed);
 		return parseXMLHeader(key) && closeKey();
@@ -313,6 +353,11 @@ bool XMLParser::parse() {
 
 	cleanup();
 
+	if (_compileStream) {
+		_compileStream->writeUint32BE(kCompiledTag);
+		_compileStream->writeUint16LE(kCompiledVersion);
+	}
+
 	bool activeClosure = false;
 	bool activeHeader = false;
 	bool selfClosure;
@@ -387,6 +432,9 @@ bool XMLParser::parse() {
 
 		case kParserNeedPropertyName:
 			if (activeClosure) {
+				if (_compileStream)
+					_compileStream->writeByte(kCompiledKeyClosure);
+
 				if (!closeKey()) {
 					parserError("Missing data when closing key '" + _activeKey.top()->name + "'.");
 					break;
@@ -459,6 +507,94 @@ bool XMLParser::parse() {
 	if (_state != kParserNeedKey || !_activeKey.empty())
 		return parserError("Unexpected end of file.");
 
+	if (_compileStream)
+		_compileStream->writeByte(kCompiledEnd);
+
+	return true;
+}
+
+void XMLParser::compileKey(const ParserNode *node, bool closed) {
+	_compileStream->writeByte(closed ? kCompiledClosedKey : kCompiledKey);
+	_compileStream->writeByte(node->header ? 1 : 0);
+	writeCompiledString(_compileStream, node->name);
+
+	_compileStream->writeUint16LE(node->values.size());
+	for (StringMap::const_iterator i = node->values.begin(); i != node->values.end(); ++i) {
+		writeCompiledString(_compileStream, i->_key);
+		writeCompiledString(_compileStream, i->_value);
+	}
+}
+
+bool XMLParser::parseCompiled(SeekableReadStream *stream) {
+	if (stream == nullptr || _stream != nullptr)
+		return false;
+
+	stream->seek(0, SEEK_SET);
+
+	if (stream->readUint32BE() != kCompiledTag || stream->readUint16LE() != kCompiledVersion)
+		return false;
+
+	if (_XMLkeys == nullptr)
+		buildLayout();
+
+	while (!_activeKey.empty())
+		freeNode(_activeKey.pop());
+
+	cleanup();
+
+	_state = kParserNeedKey;
+
+	while (_state != kParserError) {
+		byte event = stream->readByte();
+
+		if (stream->eos() || stream->err())
+			return parserError("Unexpected end of file.");
+
+		if (event == kCompiledEnd)
+			break;
+
+		if (event == kCompiledKeyClosure) {
+			if (_activeKey.empty())
+				return parserError("Unexpected closure.");
+
+			const String name = _activeKey.top()->name;
+			if (!closeKey())
+				return parserError("Missing data when closing key '" + name + "'.");
+
+			continue;
+		}
+
+		if (event != kCompiledKey && event != kCompiledClosedKey)
+			return parserError("Invalid compiled data.");
+
+		ParserNode *node = allocNode();
+		node->header = stream->readByte() != 0;
+		node->name = readCompiledString(stream);
+		node->ignore = false;
+		node->depth = _activeKey.size();
+		node->layout = nullptr;
+
+		uint16 valueCount = stream->readUint16LE();
+		while (valueCount--) {
+			String key = readCompiledString(stream);
+			node->values[key] = readCompiledString(stream);
+		}
+
+		_activeKey.push(node);
+
+		if (stream->eos() || stream->err())
+			return parserError("Unexpected end of file.");
+
+		if (!parseActiveKey(event == kCompiledClosedKey))
+			return false;
+	}
+
+	if (_state == kParserError)
+		return false;
+
+	if (!_activeKey.empty())
+		return parserError("Unexpected end of file.");
+
 	return true;
 }
 
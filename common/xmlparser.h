@@ -37,6 +37,7 @@
 namespace Common {
 
 class SeekableReadStream;
+class WriteStream;
 
 #define MAX_XML_DEPTH 8
 
@@ -92,7 +93,7 @@ public:
 	/**
 	 * Parser constructor.
 	 */
-	XMLParser() : _XMLkeys(nullptr), _stream(nullptr) {}
+	XMLParser() : _XMLkeys(nullptr), _stream(nullptr), _compileStream(nullptr) {}
 
 	virtual ~XMLParser();
 
@@ -187,6 +188,26 @@ public:
 	 */
 	bool parse();
 
+	/** Version of the compiled format written by setCompileStream(). */
+	static const uint16 kCompiledVersion = 1;
+
+	/**
+	 * Sets a stream the next parse() records the parsed keys to. The
+	 * recording can be fed to parseCompiled() later on, which replays it
+	 * through the very same callbacks without any text processing.
+	 *
+	 * The stream is not owned by the parser. Pass 0 to stop recording.
+	 * The recording is only complete if parse() returned true.
+	 */
+	void setCompileStream(WriteStream *stream) { _compileStream = stream; }
+
+	/**
+	 * Replays a recording made with setCompileStream(). No data stream
+	 * must be loaded while doing so.
+	 * Returns true if successful; the stream is not owned by the parser.
+	 */
+	bool parseCompiled(SeekableReadStream *stream);
+
 	/**
 	 * Returns the active node being parsed (the one on top of
 	 * the node stack).
@@ -327,6 +348,9 @@ protected:
 
 	bool parseXMLHeader(ParserNode *node);
 
+	/** Records a parsed key to the compile stream. */
+	void compileKey(const ParserNode *node, bool closed);
+
 	/**
 	 * Overload if your parser needs to support parsing the same file
 	 * several times, so you can clean up the internal state of the
@@ -339,6 +363,7 @@ protected:
 private:
 	char _char;
 	SeekableReadStream *_stream;
+	WriteStream *_compileStream;
 	String _fileName;
 
 	ParserState _state; /** Internal state of the parser */
@@ -22,6 +22,7 @@
 
 #include "bladerunner/audio_cache.h"
 
+#include "common/memtrack.h"
 #include "common/stream.h"
 
 namespace BladeRunner {
@@ -33,6 +34,7 @@ AudioCache::AudioCache() :
 
 AudioCache::~AudioCache() {
 	for (uint i = 0; i != _cacheItems.size(); ++i) {
+		Common::MemoryTracker::trackFree(_cacheItems[i].data);
 		free(_cacheItems[i].data);
 	}
 }
@@ -63,6 +65,7 @@ bool AudioCache::dropOldest() {
 	}
 
 	memset(_cacheItems[oldest].data, 0x00, _cacheItems[oldest].size);
+	Common::MemoryTracker::trackFree(_cacheItems[oldest].data);
 	free(_cacheItems[oldest].data);
 	_totalSize -= _cacheItems[oldest].size;
 	_cacheItems.remove_at(oldest);
@@ -89,6 +92,9 @@ void  AudioCache::storeByHash(int32 hash, Common::SeekableReadStream *stream) {
 	byte *data = (byte *)malloc(size);
 	stream->read(data, size);
 
+	Common::MemoryTagScope tagScope("bladerunner.audiocache");
+	Common::MemoryTracker::trackAlloc(data, size);
+
 	cacheItem item = {
 		hash,
 		0,
@@ -43,6 +43,8 @@
 #include "bladerunner/settings.h"
 #include "bladerunner/set.h"
 #include "bladerunner/set_effects.h"
+#include "bladerunner/slice_animations.h"
+#include "bladerunner/slice_renderer.h"
 #include "bladerunner/text_resource.h"
 #include "bladerunner/time.h"
 #include "bladerunner/vector.h"
@@ -138,6 +140,8 @@ Debugger::Debugger(BladeRunnerEngine *vm) : GUI::Debugger() {
 #else
 	registerCmd("effect", WRAP_METHOD(Debugger, cmdEffect));
 #endif // BLADERUNNER_ORIGINAL_BUGS
+	registerCmd("slicebench", WRAP_METHOD(Debugger, cmdSliceBenchmark));
+	registerCmd("vqastats", WRAP_METHOD(Debugger, cmdVqaStats));
 }
 
 Debugger::~Debugger() {
@@ -1840,6 +1844,118 @@ bool Debugger::cmdDifficulty(int argc, const char **argv) {
 	}
 	return true;
 }
+
+/**
+* Render all the frames of some slice animations at McCoy's position,
+* into a copy of the current frame and z-buffer, and report the time spent.
+*/
+bool Debugger::cmdSliceBenchmark(int argc, const char **argv) {
+	if (argc < 2) {
+		debugPrintf("Render all frames of the specified slice animations at McCoy's position and report the frame rate.\n");
+		debugPrintf("Usage: %s <iterations> [<animationId> ...]\n", argv[0]);
+		debugPrintf("Without animation ids, the animations of the actors in the current set are rendered.\n");
+		return true;
+	}
+
+	int iterations = MAX(atoi(argv[1]), 1);
+
+	Common::Array<int> animations;
+	for (int i = 2; i < argc; ++i) {
+		int animationId = atoi(argv[i]);
+		if (animationId < 0 || animationId >= (int)_vm->_sliceAnimations->getAnimationCount()) {
+			debugPrintf("Invalid animation id %d\n", animationId);
+			return true;
+		}
+		animations.push_back(animationId);
+	}
+
+	if (animations.empty()) {
+		for (int i = 0; i < (int)_vm->_gameInfo->getActorCount(); ++i) {
+			Actor *actor = _vm->_actors[i];
+			if (actor->getSetId() == _vm->_scene->getSetId() && actor->getAnimationId() >= 0) {
+				animations.push_back(actor->getAnimationId());
+			}
+		}
+	}
+
+	if (animations.empty()) {
+		debugPrintf("No animation to render\n");
+		return true;
+	}
+
+	Vector3 actorPosition = _vm->_playerActor->getXYZ();
+	Vector3 position(actorPosition.x, -actorPosition.z, actorPosition.y + 2.0f);
+	float facing = M_PI - _vm->_playerActor->getFacing() * (M_PI / 512.0f);
+
+	Graphics::Surface surface;
+	surface.copyFrom(_vm->_surfaceFront);
+	uint16 *zbuffer = new uint16[640 * 480];
+
+	uint32 frames = 0;
+	uint32 time = 0;
+	for (uint i = 0; i < animations.size(); ++i) {
+		int frameCount = _vm->_sliceAnimations->getFrameCount(animations[i]);
+
+		// Load the animation pages before measuring
+		for (int frame = 0; frame < frameCount; ++frame) {
+			_vm->_sliceAnimations->getFramePtr(animations[i], frame);
+		}
+
+		for (int iteration = 0; iteration < iterations; ++iteration) {
+			for (int frame = 0; frame < frameCount; ++frame) {
+				memcpy(zbuffer, _vm->_zbuffer->getData(), 640 * 480 * sizeof(uint16));
+
+				uint32 start = _vm->_system->getMillis(true);
+				_vm->_sliceRenderer->drawInWorld(animations[i], frame, position, facing, 1.0f, surface, zbuffer);
+				time += _vm->_system->getMillis(true) - start;
+				++frames;
+			}
+		}
+	}
+
+	delete[] zbuffer;
+	surface.free();
+
+	debugPrintf("Rendered %d frames of %d animations in %d ms", frames, animations.size(), time);
+	if (time > 0) {
+		debugPrintf(" (%d frames per second)", frames * 1000 / time);
+	}
+	debugPrintf("\n");
+	return true;
+}
+
+/**
+* Show the decoding statistics of the current scene's VQA.
+*/
+bool Debugger::cmdVqaStats(int argc, const char **argv) {
+	if (argc > 2 || (argc == 2 && scumm_stricmp(argv[1], "reset"))) {
+		debugPrintf("Show the read and decode timings of the current scene's VQA.\n");
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	if (_vm->_scene->_vqaPlayer == nullptr) {
+		debugPrintf("No scene VQA is loaded\n");
+		return true;
+	}
+
+	VQADecoder &decoder = _vm->_scene->_vqaPlayer->_decoder;
+	if (argc == 2) {
+		decoder.resetStats();
+		debugPrintf("VQA statistics reset\n");
+		return true;
+	}
+
+	const VQADecoder::Stats &stats = decoder.getStats();
+	debugPrintf("Frames read:     %d (%d prefetched, %d from file)\n", stats.framesRead, stats.prefetchHits, stats.prefetchMisses);
+	debugPrintf("Codebook stalls: %d\n", stats.codebookStalls);
+	debugPrintf("Read:            %d ms\n", stats.readTime);
+	debugPrintf("Prefetch:        %d ms\n", stats.prefetchTime);
+	debugPrintf("Video decode:    %d ms\n", stats.videoTime);
+	debugPrintf("Z-buffer decode: %d ms\n", stats.zbufferTime);
+	return true;
+}
+
 #if BLADERUNNER_ORIGINAL_BUGS
 #else
 bool Debugger::cmdEffect(int argc, const char **argv) {
@@ -120,6 +120,8 @@ public:
 #endif // BLADERUNNER_ORIGINAL_BUGS
 	bool cmdList(int argc, const char **argv);
 	bool cmdVk(int argc, const char **argv);
+	bool cmdSliceBenchmark(int argc, const char **argv);
+	bool cmdVqaStats(int argc, const char **argv);
 
 	Common::String getDifficultyDescription(int difficultyValue);
 	void drawDebuggerOverlay();
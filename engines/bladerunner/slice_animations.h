@@ -110,6 +110,7 @@ public:
 	Palette &getPalette(int i) { return _palettes[i]; };
 	void    *getFramePtr(uint32 animation, uint32 frame);
 
+	uint  getAnimationCount() const { return _animations.size(); }
 	int   getFrameCount(int animation) const { return _animations[animation].frameCount; }
 	float getFPS(int animation) const { return _animations[animation].fps; }
 
@@ -538,6 +538,17 @@ void SliceRenderer::drawOnScreen(int animationId, int animationFrame, int screen
 	}
 }
 
+// Draws the pixels of a slice polygon span which pass the z-buffer test
+template<typename T>
+static inline void drawSliceSpan(uint16 *zbufferLine, T *dstLine, int x, int xEnd, uint16 z, uint32 color) {
+	for (; x < xEnd; ++x) {
+		if (z < zbufferLine[x]) {
+			zbufferLine[x] = z;
+			dstLine[x] = (T)color;
+		}
+	}
+}
+
 void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface &surface, uint16 *zbufferLine) {
 	if (slice < 0 || (uint32)slice >= _frameSliceCount) {
 		return;
@@ -554,6 +565,8 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 	uint32 polyCount = READ_LE_UINT32(p);
 	p += 4;
 
+	void *dstLine = surface.getBasePtr(0, CLIP(y, 0, surface.h - 1));
+
 	while (polyCount--) {
 		uint32 vertexCount = READ_LE_UINT32(p);
 		p += 4;
@@ -587,11 +600,28 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 						outColor = _pixelFormat.RGBToColor(CLIP(color.r * bladeToScummVmConstant, 0, 255), CLIP(color.g * bladeToScummVmConstant, 0, 255), CLIP(color.b * bladeToScummVmConstant, 0, 255));
 					}
 
-					for (int x = previousVertexX; x != vertexX; ++x) {
+					int spanEnd = MIN<int>(vertexX, surface.w);
+
+					switch (surface.format.bytesPerPixel) {
+					case 1:
+						drawSliceSpan<uint8>(zbufferLine, (uint8 *)dstLine, previousVertexX, spanEnd, vertexZ, outColor);
+						break;
+					case 2:
+						drawSliceSpan<uint16>(zbufferLine, (uint16 *)dstLine, previousVertexX, spanEnd, vertexZ, outColor);
+						break;
+					case 4:
+						drawSliceSpan<uint32>(zbufferLine, (uint32 *)dstLine, previousVertexX, spanEnd, vertexZ, outColor);
+						break;
+					default:
+						break;
+					}
+
+					// Pixels past the right edge of a narrower surface are clipped to its last column
+					for (int x = MAX(previousVertexX, spanEnd); x < vertexX; ++x) {
 						if (vertexZ < zbufferLine[x]) {
 							zbufferLine[x] = (uint16)vertexZ;
 
-							void *dstPtr = surface.getBasePtr(CLIP(x, 0, surface.w - 1), CLIP(y, 0, surface.h - 1));
+							void *dstPtr = surface.getBasePtr(surface.w - 1, CLIP(y, 0, surface.h - 1));
 							drawPixel(surface, dstPtr, outColor);
 						}
 					}
@@ -36,6 +36,7 @@
 #include "common/array.h"
 #include "common/util.h"
 #include "common/memstream.h"
+#include "common/system.h"
 
 namespace BladeRunner {
 
@@ -137,6 +138,7 @@ VQADecoder::VQADecoder() {
 	_header.unk5         = 0;
 	_readingFrame        = -1;
 	_decodingFrame       = -1;
+	_prefetchFrame       = -1;
 }
 
 VQADecoder::~VQADecoder() {
@@ -197,12 +199,16 @@ bool VQADecoder::loadStream(Common::SeekableReadStream *s) {
 }
 
 void VQADecoder::decodeVideoFrame(Graphics::Surface *surface, int frame, bool forceDraw) {
+	uint32 startTime = g_system->getMillis(true);
 	_decodingFrame = frame;
 	_videoTrack->decodeVideoFrame(surface, forceDraw);
+	_stats.videoTime += g_system->getMillis(true) - startTime;
 }
 
 void VQADecoder::decodeZBuffer(ZBuffer *zbuffer) {
+	uint32 startTime = g_system->getMillis(true);
 	_videoTrack->decodeZBuffer(zbuffer);
+	_stats.zbufferTime += g_system->getMillis(true) - startTime;
 }
 
 Audio::SeekableAudioStream *VQADecoder::decodeAudioFrame() {
@@ -221,34 +227,34 @@ void VQADecoder::decodeLights(Lights *lights) {
 	_videoTrack->decodeLights(lights);
 }
 
-void VQADecoder::readPacket(uint readFlags) {
+void VQADecoder::readPacket(Common::SeekableReadStream *s, uint readFlags) {
 	IFFChunkHeader chd;
 
-	if (remain(_s) < 8) {
-		warning("VQADecoder::readPacket(): remain: %d", remain(_s));
-		assert(remain(_s) < 8);
+	if (remain(s) < 8) {
+		warning("VQADecoder::readPacket(): remain: %d", remain(s));
+		assert(remain(s) < 8);
 	}
 
 	do {
-		if (!readIFFChunkHeader(_s, &chd)) {
+		if (!readIFFChunkHeader(s, &chd)) {
 			error("VQADecoder::readPacket(): Error reading chunk header");
 		}
 
 		bool rc = false;
 		// Video track
 		switch (chd.id) {
-		case kAESC: rc = ((readFlags & kVQAReadCustom) == 0) ? _s->skip(roundup(chd.size)) : _videoTrack->readAESC(_s, chd.size); break;
-		case kLITE: rc = ((readFlags & kVQAReadCustom) == 0) ? _s->skip(roundup(chd.size)) : _videoTrack->readLITE(_s, chd.size); break;
-		case kVIEW: rc = ((readFlags & kVQAReadCustom) == 0) ? _s->skip(roundup(chd.size)) : _videoTrack->readVIEW(_s, chd.size); break;
-		case kVQFL: rc = ((readFlags & kVQAReadVideo ) == 0) ? _s->skip(roundup(chd.size)) : _videoTrack->readVQFL(_s, chd.size, readFlags); break;
-		case kVQFR: rc = ((readFlags & kVQAReadVideo ) == 0) ? _s->skip(roundup(chd.size)) : _videoTrack->readVQFR(_s, chd.size, readFlags); break;
-		case kZBUF: rc = ((readFlags & kVQAReadCustom) == 0) ? _s->skip(roundup(chd.size)) : _videoTrack->readZBUF(_s, chd.size); break;
+		case kAESC: rc = ((readFlags & kVQAReadCustom) == 0) ? s->skip(roundup(chd.size)) : _videoTrack->readAESC(s, chd.size); break;
+		case kLITE: rc = ((readFlags & kVQAReadCustom) == 0) ? s->skip(roundup(chd.size)) : _videoTrack->readLITE(s, chd.size); break;
+		case kVIEW: rc = ((readFlags & kVQAReadCustom) == 0) ? s->skip(roundup(chd.size)) : _videoTrack->readVIEW(s, chd.size); break;
+		case kVQFL: rc = ((readFlags & kVQAReadVideo ) == 0) ? s->skip(roundup(chd.size)) : _videoTrack->readVQFL(s, chd.size, readFlags); break;
+		case kVQFR: rc = ((readFlags & kVQAReadVideo ) == 0) ? s->skip(roundup(chd.size)) : _videoTrack->readVQFR(s, chd.size, readFlags); break;
+		case kZBUF: rc = ((readFlags & kVQAReadCustom) == 0) ? s->skip(roundup(chd.size)) : _videoTrack->readZBUF(s, chd.size); break;
 		// Sound track
-		case kSN2J: rc = ((readFlags & kVQAReadAudio) == 0) ? _s->skip(roundup(chd.size)) : _audioTrack->readSN2J(_s, chd.size); break;
-		case kSND2: rc = ((readFlags & kVQAReadAudio) == 0) ? _s->skip(roundup(chd.size)) : _audioTrack->readSND2(_s, chd.size); break;
+		case kSN2J: rc = ((readFlags & kVQAReadAudio) == 0) ? s->skip(roundup(chd.size)) : _audioTrack->readSN2J(s, chd.size); break;
+		case kSND2: rc = ((readFlags & kVQAReadAudio) == 0) ? s->skip(roundup(chd.size)) : _audioTrack->readSND2(s, chd.size); break;
 		default:
 			rc = false;
-			_s->skip(roundup(chd.size));
+			s->skip(roundup(chd.size));
 		}
 
 		if (!rc) {
@@ -263,11 +269,86 @@ void VQADecoder::readFrame(int frame, uint readFlags) {
 		error("VQADecoder::readFrame(): frame %d out of bounds, frame count is %d", frame, numFrames());
 	}
 
-	uint32 frameOffset = 2 * (_frameInfo[frame] & 0x0FFFFFFF);
-	_s->seek(frameOffset);
+	uint32 startTime = g_system->getMillis(true);
 
 	_readingFrame = frame;
-	readPacket(readFlags);
+	++_stats.framesRead;
+
+	if (frame == _prefetchFrame) {
+		// The packet was read ahead during an idle tick, parse it from memory
+		Common::MemoryReadStream packet(_prefetchData.data(), _prefetchData.size());
+		readPacket(&packet, readFlags);
+		++_stats.prefetchHits;
+	} else {
+		uint32 frameOffset = 2 * (_frameInfo[frame] & 0x0FFFFFFF);
+		_s->seek(frameOffset);
+		readPacket(_s, readFlags);
+		++_stats.prefetchMisses;
+	}
+
+	_stats.readTime += g_system->getMillis(true) - startTime;
+}
+
+/**
+ * Reads the packet of a frame into memory ahead of time and makes sure its
+ * codebook is decompressed, so that the following readFrame() and
+ * decodeVideoFrame() for that frame do not touch the file.
+ * Intended to be called while the player is waiting for the next frame.
+ */
+void VQADecoder::prefetchFrame(int frame) {
+	if (frame < 0 || frame >= numFrames() || frame == _prefetchFrame) {
+		return;
+	}
+
+	uint32 startTime = g_system->getMillis(true);
+
+	// Make sure a frame following a codebook change does not stall on its
+	// decompression. Reading the codebook does not touch the vector
+	// pointers or custom data of the frame currently on screen.
+	CodebookInfo &codebookInfo = codebookInfoForFrame(frame);
+	if (!codebookInfo.data) {
+		int readingFrame = _readingFrame;
+		_readingFrame = codebookInfo.frame;
+		_s->seek(2 * (_frameInfo[codebookInfo.frame] & 0x0FFFFFFF));
+		readPacket(_s, kVQAReadCodebook);
+		_readingFrame = readingFrame;
+	}
+
+	uint32 frameOffset = 2 * (_frameInfo[frame] & 0x0FFFFFFF);
+	uint32 frameEnd    = _s->size();
+	if (frame + 1 < numFrames()) {
+		frameEnd = 2 * (_frameInfo[frame + 1] & 0x0FFFFFFF);
+	}
+
+	_prefetchFrame = -1;
+	if (frameEnd > frameOffset && frameEnd <= (uint32)_s->size()) {
+		_prefetchData.resize(frameEnd - frameOffset);
+		_s->seek(frameOffset);
+		if (_s->read(_prefetchData.data(), _prefetchData.size()) == _prefetchData.size() && prefetchHasFrameChunk()) {
+			_prefetchFrame = frame;
+		}
+	}
+
+	_stats.prefetchTime += g_system->getMillis(true) - startTime;
+}
+
+bool VQADecoder::prefetchHasFrameChunk() const {
+	// readPacket() stops at VQFR, so the packet is usable only if it is
+	// reached within the buffered range
+	uint32 pos = 0;
+	while (pos + 8 <= _prefetchData.size()) {
+		uint32 id   = READ_BE_UINT32(&_prefetchData[pos]);
+		uint32 size = READ_BE_UINT32(&_prefetchData[pos + 4]);
+		pos += 8;
+		if (id == kVQFR) {
+			return size <= _prefetchData.size() - pos;
+		}
+		if (roundup(size) > _prefetchData.size() - pos) {
+			return false;
+		}
+		pos += roundup(size);
+	}
+	return false;
 }
 
 bool VQADecoder::readVQHD(Common::SeekableReadStream *s, uint32 size) {
@@ -852,6 +933,7 @@ bool VQADecoder::VQAVideoTrack::decodeFrame(Graphics::Surface *surface) {
 	CodebookInfo &codebookInfo = _vqaDecoder->codebookInfoForFrame(_vqaDecoder->_decodingFrame);
 
 	if (!codebookInfo.data) {
+		++_vqaDecoder->_stats.codebookStalls;
 		_vqaDecoder->readFrame(codebookInfo.frame, kVQAReadCodebook);
 	}
 
@@ -63,6 +63,7 @@ public:
 	bool loadStream(Common::SeekableReadStream *s);
 
 	void readFrame(int frame, uint readFlags = kVQAReadAll);
+	void prefetchFrame(int frame);
 
 	void                        decodeVideoFrame(Graphics::Surface *surface, int frame, bool forceDraw = false);
 	void                        decodeZBuffer(ZBuffer *zbuffer);
@@ -135,6 +136,33 @@ public:
 		uint8  *data;
 	};
 
+	// Per-stage timings in milliseconds, accumulated until reset
+	struct Stats {
+		uint32 framesRead;
+		uint32 prefetchHits;
+		uint32 prefetchMisses;
+		uint32 codebookStalls;
+		uint32 readTime;
+		uint32 prefetchTime;
+		uint32 videoTime;
+		uint32 zbufferTime;
+
+		Stats() { reset(); }
+		void reset() {
+			framesRead     = 0;
+			prefetchHits   = 0;
+			prefetchMisses = 0;
+			codebookStalls = 0;
+			readTime       = 0;
+			prefetchTime   = 0;
+			videoTime      = 0;
+			zbufferTime    = 0;
+		}
+	};
+
+	const Stats &getStats() const { return _stats; }
+	void resetStats() { _stats.reset(); }
+
 	class VQAVideoTrack;
 	class VQAAudioTrack;
 
@@ -156,7 +184,13 @@ public:
 	VQAVideoTrack *_videoTrack;
 	VQAAudioTrack *_audioTrack;
 
-	void readPacket(uint readFlags);
+	int                 _prefetchFrame;
+	Common::Array<byte> _prefetchData;
+
+	Stats    _stats;
+
+	void readPacket(Common::SeekableReadStream *s, uint readFlags);
+	bool prefetchHasFrameChunk() const;
 
 	bool readVQHD(Common::SeekableReadStream *s, uint32 size);
 	bool readMSCI(Common::SeekableReadStream *s, uint32 size);
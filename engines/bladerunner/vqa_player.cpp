@@ -133,6 +133,8 @@ int VQAPlayer::update(bool forceDraw, bool advanceFrame, bool useTime, Graphics:
 		// _repeatsCount == 0, so return here at the end of the video, to release the resource
 		return result;
 	} else if (useTime && (now < _frameNextTime)) {
+		// Use the wait for the next frame to read it ahead
+		prefetchNextFrame();
 		result = -1;
 	} else if (advanceFrame) {
 		_frame = _frameNext;
@@ -182,6 +184,19 @@ int VQAPlayer::update(bool forceDraw, bool advanceFrame, bool useTime, Graphics:
 	               // assert(frame >= -1) in overlay modes (elevator, scores, spinner)
 }
 
+void VQAPlayer::prefetchNextFrame() {
+	int frame = _frameNext;
+	if (frame > _frameEnd) {
+		if (_repeatsCount == 0) {
+			return;
+		}
+		frame = _frameBegin;
+	}
+	// A wrong guess (e.g. a seek or a loop change before the next update) only
+	// means that the next frame is read from the file as usual
+	_decoder.prefetchFrame(frame);
+}
+
 void VQAPlayer::updateZBuffer(ZBuffer *zbuffer) {
 	_decoder.decodeZBuffer(zbuffer);
 }
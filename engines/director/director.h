@@ -86,7 +86,8 @@ enum {
 	kDebugFewFramesOnly	= 1 << 12,
 	kDebugPreprocess	= 1 << 13,
 	kDebugScreenshot	= 1 << 14,
-	kDebugDesktop		= 1 << 15
+	kDebugDesktop		= 1 << 15,
+	kDebugBenchmark		= 1 << 16
 };
 
 struct MovieReference {
@@ -122,6 +123,11 @@ struct MacShape {
 	Graphics::MacPlotData *pd;
 };
 
+struct DirectorPlotData;
+
+// Draws a span of source pixels onto one row of DirectorPlotData::dst
+typedef void (*InkSpanProc)(DirectorPlotData *p, int x, int y, const byte *src, int width);
+
 // An extension of MacPlotData for interfacing with inks and patterns without
 // needing extra surfaces.
 struct DirectorPlotData {
@@ -145,6 +151,7 @@ struct DirectorPlotData {
 	bool applyColor;
 
 	void setApplyColor(); // graphics.cpp
+	InkSpanProc getInkSpanProc() const; // graphics.cpp
 
 	DirectorPlotData(Graphics::MacWindowManager *w, SpriteType s, InkType i, int a, uint b, uint f) : _wm(w), sprite(s), ink(i), alpha(a), backColor(b), foreColor(f) {
 		srf = nullptr;
@@ -824,6 +824,48 @@ void DirectorEngine::draw() {
 	g_system->updateScreen();
 }
 
+static byte inkBlendColor(DirectorPlotData *p, byte src, byte dst) {
+	byte rSrc, gSrc, bSrc;
+	byte rDst, gDst, bDst;
+
+	g_director->_wm->decomposeColor(src, rSrc, gSrc, bSrc);
+	g_director->_wm->decomposeColor(dst, rDst, gDst, bDst);
+
+	double alpha = (double)p->alpha / 100.0;
+	rDst = static_cast<byte>((rSrc * alpha) + (rDst * (1.0 - alpha)));
+	gDst = static_cast<byte>((gSrc * alpha) + (gDst * (1.0 - alpha)));
+	bDst = static_cast<byte>((bSrc * alpha) + (bDst * (1.0 - alpha)));
+
+	return p->_wm->findBestColor(rDst, gDst, bDst);
+}
+
+static byte inkArithmeticColor(DirectorPlotData *p, byte src, byte dst) {
+	byte rSrc, gSrc, bSrc;
+	byte rDst, gDst, bDst;
+
+	g_director->_wm->decomposeColor(src, rSrc, gSrc, bSrc);
+	g_director->_wm->decomposeColor(dst, rDst, gDst, bDst);
+
+	switch (p->ink) {
+	case kInkTypeBlend:
+		return p->_wm->findBestColor((rSrc + rDst) / 2, (gSrc + gDst) / 2, (bSrc + bDst) / 2);
+	case kInkTypeAddPin:
+		return p->_wm->findBestColor(MIN((rSrc + rDst), p->colorWhite), MIN((gSrc + gDst), p->colorWhite), MIN((bSrc + bDst), p->colorWhite));
+	case kInkTypeAdd:
+		return p->_wm->findBestColor(abs(rSrc + rDst) % p->colorWhite + 1, abs(gSrc + gDst) % p->colorWhite + 1, abs(bSrc + bDst) % p->colorWhite + 1);
+	case kInkTypeSubPin:
+		return p->_wm->findBestColor(MAX(rSrc - rDst, 0), MAX(gSrc - gDst, 0), MAX(bSrc - bDst, 0));
+	case kInkTypeLight:
+		return p->_wm->findBestColor(MAX(rSrc, rDst), MAX(gSrc, gDst), MAX(bSrc, bDst));
+	case kInkTypeSub:
+		return p->_wm->findBestColor(abs(rSrc - rDst) % p->colorWhite + 1, abs(gSrc - gDst) % p->colorWhite + 1, abs(bSrc - bDst) % p->colorWhite + 1);
+	case kInkTypeDark:
+		return p->_wm->findBestColor(MIN(rSrc, rDst), MIN(gSrc, gDst), MIN(bSrc, bDst));
+	default:
+		return dst;
+	}
+}
+
 void inkDrawPixel(int x, int y, int src, void *data) {
 	DirectorPlotData *p = (DirectorPlotData *)data;
 
@@ -845,18 +887,7 @@ void inkDrawPixel(int x, int y, int src, void *data) {
 		*dst = tmpDst;
 	} else if (p->alpha) {
 		// Sprite blend does not respect colourization; defaults to matte ink
-		byte rSrc, gSrc, bSrc;
-		byte rDst, gDst, bDst;
-
-		g_director->_wm->decomposeColor(src, rSrc, gSrc, bSrc);
-		g_director->_wm->decomposeColor(*dst, rDst, gDst, bDst);
-
-		double alpha = (double)p->alpha / 100.0;
-		rDst = static_cast<byte>((rSrc * alpha) + (rDst * (1.0 - alpha)));
-		gDst = static_cast<byte>((gSrc * alpha) + (gDst * (1.0 - alpha)));
-		bDst = static_cast<byte>((bSrc * alpha) + (bDst * (1.0 - alpha)));
-
-		*dst = p->_wm->findBestColor(rDst, gDst, bDst);
+		*dst = inkBlendColor(p, src, *dst);
 		return;
 	}
 
@@ -928,41 +959,116 @@ void inkDrawPixel(int x, int y, int src, void *data) {
 		*dst = p->applyColor ? (~src | p->backColor) & (*dst | src) : *dst | src;
 		break;
 		// Arithmetic ink types
-	default: {
-		if (src != p->colorWhite) {
-			byte rSrc, gSrc, bSrc;
-			byte rDst, gDst, bDst;
+	default:
+		if (src != p->colorWhite)
+			*dst = inkArithmeticColor(p, src, *dst);
+		break;
+	}
+}
 
-			g_director->_wm->decomposeColor(src, rSrc, gSrc, bSrc);
-			g_director->_wm->decomposeColor(*dst, rDst, gDst, bDst);
+// Span variants of inkDrawPixel, drawing a run of source pixels onto one
+// row of the destination. They are selected once per sprite through
+// DirectorPlotData::getInkSpanProc(); inks without a specialised span
+// fall back to plotting each pixel with inkDrawPixel.
+
+static void inkSpanPixels(DirectorPlotData *p, int x, int y, const byte *src, int width) {
+	for (int i = 0; i < width; i++)
+		inkDrawPixel(x + i, y, src[i], p);
+}
+
+static void inkSpanCopy(DirectorPlotData *p, int x, int y, const byte *src, int width) {
+	memcpy(p->dst->getBasePtr(x, y), src, width);
+}
+
+static void inkSpanBackgndTrans(DirectorPlotData *p, int x, int y, const byte *src, int width) {
+	byte *dst = (byte *)p->dst->getBasePtr(x, y);
+	const byte backColor = p->backColor;
+
+	for (int i = 0; i < width; i++)
+		if (src[i] != backColor)
+			dst[i] = src[i];
+}
+
+static void inkSpanTransparent(DirectorPlotData *p, int x, int y, const byte *src, int width) {
+	byte *dst = (byte *)p->dst->getBasePtr(x, y);
+	const byte foreColor = p->applyColor ? p->foreColor : 0;
+
+	for (int i = 0; i < width; i++)
+		dst[i] = (~src[i] & foreColor) | (dst[i] & src[i]);
+}
+
+static void inkSpanNotTrans(DirectorPlotData *p, int x, int y, const byte *src, int width) {
+	byte *dst = (byte *)p->dst->getBasePtr(x, y);
+	const byte foreColor = p->applyColor ? p->foreColor : 0;
 
-			switch (p->ink) {
-			case kInkTypeBlend:
-					*dst = p->_wm->findBestColor((rSrc + rDst) / 2, (gSrc + gDst) / 2, (bSrc + bDst) / 2);
-				break;
-			case kInkTypeAddPin:
-					*dst = p->_wm->findBestColor(MIN((rSrc + rDst), p->colorWhite), MIN((gSrc + gDst), p->colorWhite), MIN((bSrc + bDst), p->colorWhite));
-				break;
-			case kInkTypeAdd:
-					*dst = p->_wm->findBestColor(abs(rSrc + rDst) % p->colorWhite + 1, abs(gSrc + gDst) % p->colorWhite + 1, abs(bSrc + bDst) % p->colorWhite + 1);
-				break;
-			case kInkTypeSubPin:
-					*dst = p->_wm->findBestColor(MAX(rSrc - rDst, 0), MAX(gSrc - gDst, 0), MAX(bSrc - bDst, 0));
-				break;
-			case kInkTypeLight:
-					*dst = p->_wm->findBestColor(MAX(rSrc, rDst), MAX(gSrc, gDst), MAX(bSrc, bDst));
-				break;
-			case kInkTypeSub:
-					*dst = p->_wm->findBestColor(abs(rSrc - rDst) % p->colorWhite + 1, abs(gSrc - gDst) % p->colorWhite + 1, abs(bSrc - bDst) % p->colorWhite + 1);
-				break;
-			case kInkTypeDark:
-					*dst = p->_wm->findBestColor(MIN(rSrc, rDst), MIN(gSrc, gDst), MIN(bSrc, bDst));
-				break;
-			default:
-				break;
-			}
+	for (int i = 0; i < width; i++)
+		dst[i] = (src[i] & foreColor) | (dst[i] & ~src[i]);
+}
+
+static void inkSpanReverse(DirectorPlotData *p, int x, int y, const byte *src, int width) {
+	byte *dst = (byte *)p->dst->getBasePtr(x, y);
+
+	for (int i = 0; i < width; i++)
+		dst[i] ^= ~src[i];
+}
+
+static void inkSpanNotReverse(DirectorPlotData *p, int x, int y, const byte *src, int width) {
+	byte *dst = (byte *)p->dst->getBasePtr(x, y);
+
+	for (int i = 0; i < width; i++)
+		dst[i] ^= src[i];
+}
+
+static void inkSpanGhost(DirectorPlotData *p, int x, int y, const byte *src, int width) {
+	byte *dst = (byte *)p->dst->getBasePtr(x, y);
+	const byte backColor = p->applyColor ? p->backColor : 0xff;
+
+	for (int i = 0; i < width; i++)
+		dst[i] = (src[i] | backColor) & (dst[i] | ~src[i]);
+}
+
+static void inkSpanNotGhost(DirectorPlotData *p, int x, int y, const byte *src, int width) {
+	byte *dst = (byte *)p->dst->getBasePtr(x, y);
+	const byte backColor = p->applyColor ? p->backColor : 0xff;
+
+	for (int i = 0; i < width; i++)
+		dst[i] = (~src[i] | backColor) & (dst[i] | src[i]);
+}
+
+// The arithmetic inks and sprite blending go through the palette for every
+// pixel. Sprites tend to have long runs of identical source and destination
+// pixels, so the last lookup is reused.
+
+static void inkSpanBlend(DirectorPlotData *p, int x, int y, const byte *src, int width) {
+	byte *dst = (byte *)p->dst->getBasePtr(x, y);
+	int lastSrc = -1, lastDst = -1;
+	byte lastColor = 0;
+
+	for (int i = 0; i < width; i++) {
+		if (src[i] != lastSrc || dst[i] != lastDst) {
+			lastSrc = src[i];
+			lastDst = dst[i];
+			lastColor = inkBlendColor(p, src[i], dst[i]);
 		}
+		dst[i] = lastColor;
 	}
+}
+
+static void inkSpanArithmetic(DirectorPlotData *p, int x, int y, const byte *src, int width) {
+	byte *dst = (byte *)p->dst->getBasePtr(x, y);
+	int lastSrc = -1, lastDst = -1;
+	byte lastColor = 0;
+
+	for (int i = 0; i < width; i++) {
+		if (src[i] == p->colorWhite)
+			continue;
+
+		if (src[i] != lastSrc || dst[i] != lastDst) {
+			lastSrc = src[i];
+			lastDst = dst[i];
+			lastColor = inkArithmeticColor(p, src[i], dst[i]);
+		}
+		dst[i] = lastColor;
 	}
 }
 
@@ -999,5 +1105,36 @@ void DirectorPlotData::setApplyColor() {
 	}
 }
 
+InkSpanProc DirectorPlotData::getInkSpanProc() const {
+	if (ms)
+		return inkSpanPixels;
+
+	if (alpha)
+		return inkSpanBlend;
+
+	switch (ink) {
+	case kInkTypeBackgndTrans:
+		return applyColor ? inkSpanPixels : inkSpanBackgndTrans;
+	case kInkTypeMatte:
+	case kInkTypeMask:
+	case kInkTypeCopy:
+	case kInkTypeNotCopy:
+		return applyColor ? inkSpanPixels : inkSpanCopy;
+	case kInkTypeTransparent:
+		return inkSpanTransparent;
+	case kInkTypeNotTrans:
+		return inkSpanNotTrans;
+	case kInkTypeReverse:
+		return inkSpanReverse;
+	case kInkTypeNotReverse:
+		return inkSpanNotReverse;
+	case kInkTypeGhost:
+		return inkSpanGhost;
+	case kInkTypeNotGhost:
+		return inkSpanNotGhost;
+	default:
+		return inkSpanArithmetic;
+	}
+}
 
 }
@@ -76,6 +76,10 @@ Score::Score(Movie *movie) {
 	_numChannelsDisplayed = 0;
 
 	_framesRan = 0; // used by kDebugFewFramesOnly and kDebugScreenshot
+
+	_benchmarkFrames = 0;
+	_benchmarkTime = 0;
+	_benchmarkMaxTime = 0;
 }
 
 Score::~Score() {
@@ -292,6 +296,11 @@ void Score::step() {
 }
 
 void Score::stopPlay() {
+	if (debugChannelSet(-1, kDebugBenchmark) && _benchmarkFrames) {
+		debug("Score::stopPlay(): rendered %d frames in %d ms, %d ms average, %d ms worst",
+			_benchmarkFrames, _benchmarkTime, _benchmarkTime / _benchmarkFrames, _benchmarkMaxTime);
+	}
+
 	if (_vm->getVersion() >= 300)
 		_movie->processEvent(kEventStopMovie);
 	_lingo->executePerFrameHook(-1, 0);
@@ -448,6 +457,14 @@ void Score::update() {
 }
 
 void Score::renderFrame(uint16 frameId, RenderMode mode) {
+	// In benchmark mode every frame redraws all the sprites on the stage
+	const bool benchmark = debugChannelSet(-1, kDebugBenchmark);
+	uint32 startTime = 0;
+	if (benchmark) {
+		mode = kRenderForceUpdate;
+		startTime = g_system->getMillis(true);
+	}
+
 	if (!renderTransition(frameId))
 		renderSprites(frameId, mode);
 
@@ -459,6 +476,13 @@ void Score::renderFrame(uint16 frameId, RenderMode mode) {
 
 	_window->render();
 
+	if (benchmark) {
+		uint32 time = g_system->getMillis(true) - startTime;
+		_benchmarkTime += time;
+		_benchmarkMaxTime = MAX(_benchmarkMaxTime, time);
+		_benchmarkFrames++;
+	}
+
 	if (_frames[frameId]->_sound1 || _frames[frameId]->_sound2)
 		playSoundChannel(frameId);
 }
@@ -144,6 +144,11 @@ public:
 
 	uint16 _framesRan; // used by kDebugFewFramesOnly
 
+	// used by kDebugBenchmark
+	uint32 _benchmarkFrames;
+	uint32 _benchmarkTime;
+	uint32 _benchmarkMaxTime;
+
 private:
 	DirectorEngine *_vm;
 	Lingo *_lingo;
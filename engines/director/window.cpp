@@ -218,30 +218,62 @@ void Window::inkBlitShape(DirectorPlotData *pd, Common::Rect &srcRect) {
 	}
 }
 
+// Draws one row of a sprite, splitting it into the spans let through by the mask
+static void inkBlitRow(DirectorPlotData *pd, InkSpanProc proc, int y, const byte *src, const byte *msk) {
+	const int width = pd->destRect.width();
+
+	if (!msk) {
+		proc(pd, pd->destRect.left, y, src, width);
+		return;
+	}
+
+	const bool maskInk = (pd->ink == kInkTypeMask);
+	int j = 0;
+
+	while (j < width) {
+		while (j < width && (maskInk ? !msk[j] : msk[j]))
+			j++;
+
+		int start = j;
+		while (j < width && (maskInk ? msk[j] : !msk[j]))
+			j++;
+
+		if (j > start)
+			proc(pd, pd->destRect.left + start, y, src + start, j - start);
+	}
+}
+
 void Window::inkBlitSurface(DirectorPlotData *pd, Common::Rect &srcRect, const Graphics::Surface *mask) {
-	if (!pd->srf)
+	if (!pd->srf || pd->destRect.isEmpty())
 		return;
 
 	// TODO: Determine why colourization causes problems in Warlock
 	if (pd->sprite == kTextSprite)
 		pd->applyColor = false;
 
+	InkSpanProc proc = pd->getInkSpanProc();
+	Common::Array<byte> row;
+	if (pd->sprite == kTextSprite)
+		row.resize(pd->destRect.width());
+
+	pd->srcPoint.x = abs(srcRect.left - pd->destRect.left);
 	pd->srcPoint.y = abs(srcRect.top - pd->destRect.top);
 	for (int i = 0; i < pd->destRect.height(); i++, pd->srcPoint.y++) {
-		pd->srcPoint.x = abs(srcRect.left - pd->destRect.left);
 		const byte *msk = mask ? (const byte *)mask->getBasePtr(pd->srcPoint.x, pd->srcPoint.y) : nullptr;
+		const byte *src = (const byte *)pd->srf->getBasePtr(pd->srcPoint.x, pd->srcPoint.y);
 
-		for (int j = 0; j < pd->destRect.width(); j++, pd->srcPoint.x++) {
-			if (!mask || (msk && (pd->ink == kInkTypeMask ? *msk++ : !(*msk++)))) {
-				inkDrawPixel(pd->destRect.left + j, pd->destRect.top + i,
-										 preprocessColor(pd, *((byte *)pd->srf->getBasePtr(pd->srcPoint.x, pd->srcPoint.y))), pd);
-			}
+		if (pd->sprite == kTextSprite) {
+			for (int j = 0; j < pd->destRect.width(); j++)
+				row[j] = preprocessColor(pd, src[j]);
+			src = row.begin();
 		}
+
+		inkBlitRow(pd, proc, pd->destRect.top + i, src, msk);
 	}
 }
 
 void Window::inkBlitStretchSurface(DirectorPlotData *pd, Common::Rect &srcRect, const Graphics::Surface *mask) {
-	if (!pd->srf)
+	if (!pd->srf || pd->destRect.isEmpty())
 		return;
 
 	// TODO: Determine why colourization causes problems in Warlock
@@ -251,18 +283,21 @@ void Window::inkBlitStretchSurface(DirectorPlotData *pd, Common::Rect &srcRect,
 	int scaleX = SCALE_THRESHOLD * srcRect.width() / pd->destRect.width();
 	int scaleY = SCALE_THRESHOLD * srcRect.height() / pd->destRect.height();
 
+	InkSpanProc proc = pd->getInkSpanProc();
+	Common::Array<byte> row;
+	row.resize(pd->destRect.width());
+
+	pd->srcPoint.x = abs(srcRect.left - pd->destRect.left);
 	pd->srcPoint.y = abs(srcRect.top - pd->destRect.top);
 
 	for (int i = 0, scaleYCtr = 0; i < pd->destRect.height(); i++, scaleYCtr += scaleY, pd->srcPoint.y++) {
-		pd->srcPoint.x = abs(srcRect.left - pd->destRect.left);
 		const byte *msk = mask ? (const byte *)mask->getBasePtr(pd->srcPoint.x, pd->srcPoint.y) : nullptr;
+		const byte *src = (const byte *)pd->srf->getBasePtr(0, scaleYCtr / SCALE_THRESHOLD);
 
-		for (int xCtr = 0, scaleXCtr = 0; xCtr < pd->destRect.width(); xCtr++, scaleXCtr += scaleX, pd->srcPoint.x++) {
-			if (!mask || (msk && (pd->ink == kInkTypeMask ? *msk++ : !(*msk++)))) {
-			inkDrawPixel(pd->destRect.left + xCtr, pd->destRect.top + i,
-									 preprocessColor(pd, *((byte *)pd->srf->getBasePtr(scaleXCtr / SCALE_THRESHOLD, scaleYCtr / SCALE_THRESHOLD))), pd);
-			}
-		}
+		for (int xCtr = 0, scaleXCtr = 0; xCtr < pd->destRect.width(); xCtr++, scaleXCtr += scaleX)
+			row[xCtr] = preprocessColor(pd, src[scaleXCtr / SCALE_THRESHOLD]);
+
+		inkBlitRow(pd, proc, pd->destRect.top + i, row.begin(), msk);
 	}
 }
 
@@ -28,7 +28,9 @@
 
 #include "common/archive.h"
 #include "common/bitstream.h"
+#include "common/cachefile.h"
 #include "common/debug.h"
+#include "common/file.h"
 #include "common/hash-str.h"
 #include "common/hashmap.h"
 #include "common/memstream.h"
@@ -59,9 +61,11 @@ private:
 		uint32 uncompressedSize;
 		uint32 compressedSize;
 		uint32 offset;
+		uint16 crc;
 	};
 
 	Common::SeekableReadStream *_stream;
+	Common::String _cacheKey;
 
 	typedef Common::HashMap<Common::String, FileEntry, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> FileMap;
 	FileMap _map;
@@ -93,10 +97,15 @@ static const uint32 s_magicNumbers[] = {
 bool StuffItArchive::open(const Common::String &filename) {
 	close();
 
-	_stream = SearchMan.createReadStreamForMember(filename);
-
-	if (!_stream)
+	// Mapping the archive lets stored members be handed out as views into
+	// it instead of copies
+	Common::File *file = new Common::File();
+	if (!file->openMapped(filename)) {
+		delete file;
 		return false;
+	}
+
+	_stream = file;
 
 	uint32 tag = _stream->readUint32BE();
 
@@ -150,8 +159,8 @@ bool StuffItArchive::open(const Common::String &filename) {
 		uint32 dataForkUncompressedSize = _stream->readUint32BE();
 		uint32 resForkCompressedSize = _stream->readUint32BE();
 		uint32 dataForkCompressedSize = _stream->readUint32BE();
-		/* uint16 resForkCRC = */ _stream->readUint16BE();
-		/* uint16 dataForkCRC = */ _stream->readUint16BE();
+		uint16 resForkCRC = _stream->readUint16BE();
+		uint16 dataForkCRC = _stream->readUint16BE();
 		_stream->skip(6); // unknown
 		/* uint16 headerCRC = */ _stream->readUint16BE();
 
@@ -167,6 +176,7 @@ bool StuffItArchive::open(const Common::String &filename) {
 			entry.uncompressedSize = dataForkUncompressedSize;
 			entry.compressedSize = dataForkCompressedSize;
 			entry.offset = _stream->pos() + resForkCompressedSize;
+			entry.crc = dataForkCRC;
 			_map[name] = entry;
 
 			debug(0, "StuffIt file '%s', Compression = %d", name.c_str(), entry.compression);
@@ -183,6 +193,7 @@ bool StuffItArchive::open(const Common::String &filename) {
 			entry.uncompressedSize = resForkUncompressedSize;
 			entry.compressedSize = resForkCompressedSize;
 			entry.offset = _stream->pos();
+			entry.crc = resForkCRC;
 			_map[name] = entry;
 
 			debug(0, "StuffIt file '%s', Compression = %d", name.c_str(), entry.compression);
@@ -192,10 +203,15 @@ bool StuffItArchive::open(const Common::String &filename) {
 		_stream->skip(dataForkCompressedSize + resForkCompressedSize);
 	}
 
+	_cacheKey = Common::computeArchiveCacheKey(*_stream);
+
 	return true;
 }
 
 void StuffItArchive::close() {
+	if (_stream)
+		Common::flushArchiveMemberCache();
+
 	delete _stream; _stream = 0;
 	_map.clear();
 }
@@ -229,9 +245,20 @@ Common::SeekableReadStream *StuffItArchive::createReadStreamForMember(const Comm
 	// We currently only support type 14 compression
 	switch (entry.compression) {
 	case 0: // Uncompressed
+		if (subStream.getMappedData())
+			return new Common::MemoryReadStream(subStream.getMappedData(), subStream.size());
 		return subStream.readStream(subStream.size());
-	case 14: // Installer
-		return decompress14(&subStream, entry.uncompressedSize);
+	case 14: { // Installer
+		const uint32 memberKey = Common::computeArchiveMemberKey(_cacheKey, entry.offset, entry.compressedSize, entry.crc);
+		Common::SeekableReadStream *stream = Common::openCachedArchiveMember(_cacheKey, name, memberKey, entry.uncompressedSize);
+		if (stream)
+			return stream;
+
+		stream = decompress14(&subStream, entry.uncompressedSize);
+		if (stream && stream->getMappedData())
+			Common::cacheArchiveMember(_cacheKey, name, memberKey, stream->getMappedData(), entry.uncompressedSize);
+		return stream;
+	}
 	default:
 		error("Unhandled StuffIt compression %d", entry.compression);
 	}
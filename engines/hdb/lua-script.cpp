@@ -24,6 +24,7 @@
 #include "common/lua/lua.h"
 #include "common/lua/lauxlib.h"
 #include "common/lua/lualib.h"
+#include "common/lua/lua_chunkcache.h"
 
 #include "hdb/hdb.h"
 #include "hdb/ai.h"
@@ -1985,7 +1986,7 @@ bool LuaScript::executeMPC(Common::SeekableReadStream *stream, const char *name,
 
 	addPatches(chunkString, scriptName);
 
-	if (!executeChunk(chunkString, name)) {
+	if (!executeChunk(chunkString, name, true)) {
 		delete[] chunk;
 
 		return false;
@@ -2014,7 +2015,7 @@ bool LuaScript::executeFile(const Common::String &filename) {
 
 	addPatches(fileDataString, filename.c_str());
 
-	if (!executeChunk(fileDataString, filename)) {
+	if (!executeChunk(fileDataString, filename, true)) {
 		delete[] fileData;
 		delete file;
 
@@ -2027,9 +2028,12 @@ bool LuaScript::executeFile(const Common::String &filename) {
 	return true;
 }
 
-bool LuaScript::executeChunk(Common::String &chunk, const Common::String &chunkName) const {
-	// Compile Chunk
-	if (luaL_loadbuffer(_state, chunk.c_str(), chunk.size(), chunkName.c_str())) {
+bool LuaScript::executeChunk(Common::String &chunk, const Common::String &chunkName, bool useCache) const {
+	// Compile Chunk. Game scripts are kept in the bytecode cache, save
+	// states are different every time
+	int status = useCache ? Lua::loadBufferCached(_state, chunk.c_str(), chunk.size(), chunkName.c_str()) :
+	                        luaL_loadbuffer(_state, chunk.c_str(), chunk.size(), chunkName.c_str());
+	if (status) {
 		error("Couldn't compile \"%s\": %s", chunkName.c_str(), lua_tostring(_state, -1));
 		lua_pop(_state, -1);
 
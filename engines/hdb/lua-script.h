@@ -64,7 +64,7 @@ public:
 
 	bool executeMPC(Common::SeekableReadStream *stream, const char *name, const char *scriptName, int32 length);
 	bool executeFile(const Common::String &filename);
-	bool executeChunk(Common::String &chunk, const Common::String &chunkName) const;
+	bool executeChunk(Common::String &chunk, const Common::String &chunkName, bool useCache = false) const;
 	void checkParameters(const char *func, int params);
 
 	const char *getStringOffStack();
@@ -68,7 +68,10 @@ void MohawkSurface::convertToTrueColor() {
 	_surface = surface;
 }
 
-GraphicsManager::GraphicsManager() {
+GraphicsManager::GraphicsManager() :
+		_cacheBudget(0),
+		_cacheSize(0),
+		_cacheUseCounter(0) {
 }
 
 GraphicsManager::~GraphicsManager() {
@@ -76,8 +79,8 @@ GraphicsManager::~GraphicsManager() {
 }
 
 void GraphicsManager::clearCache() {
-	for (Common::HashMap<uint16, MohawkSurface *>::iterator it = _cache.begin(); it != _cache.end(); it++)
-		delete it->_value;
+	for (Common::HashMap<uint16, CachedImage>::iterator it = _cache.begin(); it != _cache.end(); it++)
+		delete it->_value.surface;
 	for (Common::HashMap<uint16, Common::Array<MohawkSurface *> >::iterator it = _subImageCache.begin(); it != _subImageCache.end(); it++) {
 		Common::Array<MohawkSurface *> &array = it->_value;
 		for (uint i = 0; i < array.size(); i++)
@@ -86,18 +89,42 @@ void GraphicsManager::clearCache() {
 
 	_cache.clear();
 	_subImageCache.clear();
+	_cacheSize = 0;
+}
+
+void GraphicsManager::setCacheBudget(uint32 bytes) {
+	_cacheBudget = bytes;
+}
+
+bool GraphicsManager::fitsInCache(uint32 size) const {
+	return _cacheBudget == 0 || _cacheSize + size <= _cacheBudget;
+}
+
+bool GraphicsManager::isImageCached(uint16 id) const {
+	return _cache.contains(id);
 }
 
 MohawkSurface *GraphicsManager::findImage(uint16 id) {
 	if (!_cache.contains(id))
-		_cache[id] = decodeImage(id);
+		addImageToCache(id, decodeImage(id));
 
-	// TODO: Probably would be nice to limit the size of the cache
-	// Currently, this can't get large because it is freed on every
-	// card/stack change in Myst/Riven so I'm not worried about it.
-	// Doesn't mean this shouldn't be done in the future.
+	CachedImage &image = _cache[id];
+	image.lastUse = ++_cacheUseCounter;
+	return image.surface;
+}
+
+void GraphicsManager::evictImages(uint16 keepId) {
+	while (_cacheSize > _cacheBudget && _cache.size() > 1) {
+		Common::HashMap<uint16, CachedImage>::iterator oldest = _cache.end();
+		for (Common::HashMap<uint16, CachedImage>::iterator it = _cache.begin(); it != _cache.end(); it++) {
+			if (it->_key != keepId && (oldest == _cache.end() || it->_value.lastUse < oldest->_value.lastUse))
+				oldest = it;
+		}
 
-	return _cache[id];
+		_cacheSize -= oldest->_value.size;
+		delete oldest->_value.surface;
+		_cache.erase(oldest);
+	}
 }
 
 Common::Array<MohawkSurface *> GraphicsManager::decodeImages(uint16 id) {
@@ -227,7 +254,16 @@ void GraphicsManager::addImageToCache(uint16 id, MohawkSurface *surface) {
 	if (_cache.contains(id))
 		error("Image %d already in cache", id);
 
-	_cache[id] = surface;
+	const Graphics::Surface *pixels = surface ? surface->getSurface() : nullptr;
+
+	CachedImage &image = _cache[id];
+	image.surface = surface;
+	image.size = pixels ? pixels->pitch * pixels->h : 0;
+	image.lastUse = ++_cacheUseCounter;
+	_cacheSize += image.size;
+
+	if (_cacheBudget)
+		evictImages(id);
 }
 
 } // End of namespace Mohawk
@@ -74,6 +74,15 @@ public:
 	// Free all surfaces in the cache
 	void clearCache();
 
+	// Limit the memory used by the image cache. Once the limit is exceeded,
+	// the least recently used images are freed. 0 means no limit, in which
+	// case images are only freed by clearCache().
+	void setCacheBudget(uint32 bytes);
+	// Whether an image of the given size in bytes can be added to the cache
+	// without evicting any other image
+	bool fitsInCache(uint32 size) const;
+	bool isImageCached(uint16 id) const;
+
 	// findImage will search the cache to find the image.
 	// If not found, it will call decodeImage to get a new one.
 	MohawkSurface *findImage(uint16 id);
@@ -97,8 +106,20 @@ protected:
 	void addImageToCache(uint16 id, MohawkSurface *surface);
 
 private:
-	// An image cache that stores images until clearCache() is called
-	Common::HashMap<uint16, MohawkSurface *> _cache;
+	struct CachedImage {
+		MohawkSurface *surface;
+		uint32 size;
+		uint32 lastUse;
+	};
+
+	void evictImages(uint16 keepId);
+
+	// An image cache that stores images until clearCache() is called,
+	// or until they are evicted when the cache budget is exceeded
+	Common::HashMap<uint16, CachedImage> _cache;
+	uint32 _cacheBudget;
+	uint32 _cacheSize;
+	uint32 _cacheUseCounter;
 	Common::HashMap<uint16, Common::Array<MohawkSurface *> > _subImageCache;
 };
 
@@ -229,6 +229,11 @@ void MohawkEngine_Riven::doFrame() {
 
 	// Update the screen once per frame
 	_system->updateScreen();
+
+	// Use the idle time to decode the images of the adjacent cards, one per frame
+	if (!_scriptMan->hasQueuedScripts())
+		_gfx->preloadNextImage();
+
 	uint32 loopElapsed = _system->getMillis() - loopStart;
 
 	// Cut down on CPU usage
@@ -382,6 +387,7 @@ void MohawkEngine_Riven::changeToStack(uint16 stackId) {
 
 	// Clear the graphics cache; images aren't used across stack boundaries
 	_gfx->clearCache();
+	_gfx->clearImagePreloadQueue();
 
 	// Clear the old stack files out
 	closeAllArchives();
@@ -618,10 +624,6 @@ static const RivenSpecialChange rivenSpecialChange[] = {
 void MohawkEngine_Riven::changeToCard(uint16 dest) {
 	debug (1, "Changing to card %d", dest);
 
-	// Clear the graphics cache (images typically aren't used
-	// on different cards).
-	_gfx->clearCache();
-
 	if (!isGameVariant(GF_DEMO)) {
 		for (byte i = 0; i < ARRAYSIZE(rivenSpecialChange); i++)
 			if (_stack->getId() == rivenSpecialChange[i].startStack && dest == _stack->getCardStackId(
@@ -646,6 +648,35 @@ void MohawkEngine_Riven::changeToCard(uint16 dest) {
 
 	// Finally, install any hardcoded timer
 	_stack->installCardTimer();
+
+	queueAdjacentCardImages();
+}
+
+void MohawkEngine_Riven::queueAdjacentCardImages() {
+	// The decoded images are kept in the graphics cache across card changes.
+	// Predict the cards the player can go to next and decode their images
+	// while idle so that they are ready when switching to one of them.
+	_gfx->clearImagePreloadQueue();
+
+	Common::Array<uint16> cards = _card->getAdjacentCards();
+	for (uint i = 0; i < cards.size(); i++) {
+		if (!hasResource(ID_PLST, cards[i]))
+			continue;
+
+		Common::SeekableReadStream *plst = getResource(ID_PLST, cards[i]);
+		uint16 recordCount = plst->readUint16BE();
+
+		for (uint16 j = 0; j < recordCount; j++) {
+			plst->readUint16BE(); // index
+			uint16 id = plst->readUint16BE();
+			plst->skip(8); // rect
+
+			if (hasResource(ID_TBMP, id))
+				_gfx->queueImagePreload(id);
+		}
+
+		delete plst;
+	}
 }
 
 Common::SeekableReadStream *MohawkEngine_Riven::getExtrasResource(uint32 tag, uint16 id) {
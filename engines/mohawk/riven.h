@@ -142,6 +142,8 @@ private:
 	RivenCard *_card;
 	RivenStack *_stack;
 
+	void queueAdjacentCardImages();
+
 	int _menuSavedCard;
 	int _menuSavedStack;
 	Common::ScopedPtr<Graphics::Surface, Graphics::SurfaceDeleter> _menuThumbnail;
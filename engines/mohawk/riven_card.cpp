@@ -31,6 +31,7 @@
 #include "mohawk/resource.h"
 #include "mohawk/riven.h"
 
+#include "common/algorithm.h"
 #include "common/memstream.h"
 
 namespace Mohawk {
@@ -1041,6 +1042,25 @@ void RivenCard::setCurrentCardVariable() {
 	_vm->_vars["currentcardid"] = _id;
 }
 
+Common::Array<uint16> RivenCard::getAdjacentCards() const {
+	Common::Array<uint16> cards;
+
+	for (uint i = 0; i < _scripts.size(); i++)
+		_scripts[i].script->getCardChanges(cards);
+
+	for (uint i = 0; i < _hotspots.size(); i++)
+		_hotspots[i]->getCardChanges(cards);
+
+	// Remove the duplicates and the card itself
+	Common::Array<uint16> adjacentCards;
+	for (uint i = 0; i < cards.size(); i++) {
+		if (cards[i] != _id && Common::find(adjacentCards.begin(), adjacentCards.end(), cards[i]) == adjacentCards.end())
+			adjacentCards.push_back(cards[i]);
+	}
+
+	return adjacentCards;
+}
+
 void RivenCard::dump() const {
 	debug("== Card ==");
 	debug("id: %d", _id);
@@ -1395,6 +1415,11 @@ int16 RivenHotspot::getTransitionOffset() const {
 	return _transitionOffset;
 }
 
+void RivenHotspot::getCardChanges(Common::Array<uint16> &cards) const {
+	for (uint i = 0; i < _scripts.size(); i++)
+		_scripts[i].script->getCardChanges(cards);
+}
+
 void RivenHotspot::dump() const {
 	debug("index: %d", _index);
 	debug("blstId: %d", _blstID);
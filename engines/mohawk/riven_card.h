@@ -140,6 +140,9 @@ public:
 	/** Frame update handler for mouse dragging */
 	RivenScriptPtr onMouseDragUpdate();
 
+	/** Get the ids of the cards the card's scripts and hotspots may switch to */
+	Common::Array<uint16> getAdjacentCards() const;
+
 	/** Write all of the card's data to standard output */
 	void dump() const;
 
@@ -268,6 +271,9 @@ public:
 	 */
 	int16 getTransitionOffset() const;
 
+	/** Append the ids of the cards the hotspot's scripts may switch to */
+	void getCardChanges(Common::Array<uint16> &cards) const;
+
 	/** Write all of the hotspot's data to standard output */
 	void dump() const;
 
@@ -28,6 +28,7 @@
 #include "mohawk/riven_stack.h"
 #include "mohawk/riven_video.h"
 
+#include "common/algorithm.h"
 #include "common/system.h"
 #include "common/memstream.h"
 
@@ -328,6 +329,10 @@ RivenGraphics::RivenGraphics(MohawkEngine_Riven* vm) :
 		_transitionDuration(0) {
 	_bitmapDecoder = new MohawkBitmap();
 
+	// Decoded card images are kept across card changes up to this limit.
+	// It is large enough to also hold all the credits images.
+	setCacheBudget(32 * 1024 * 1024);
+
 	// Restrict ourselves to a single pixel format to simplify the effects implementation
 	_pixelFormat = Graphics::createPixelFormat<565>();
 	initGraphics(608, 436, &_pixelFormat);
@@ -372,16 +377,53 @@ void RivenGraphics::copyImageToScreen(uint16 image, uint32 left, uint32 top, uin
 	beginScreenUpdate();
 
 	// Clip the width to fit on the screen. Fixes some images.
-	if (left + surface->w > 608)
-		surface->w = 608 - left;
+	uint16 width = surface->w;
+	if (left + width > 608)
+		width = 608 - left;
 
 	for (uint16 i = 0; i < surface->h; i++)
-		memcpy(_mainScreen->getBasePtr(left, i + top), surface->getBasePtr(0, i), surface->w * surface->format.bytesPerPixel);
+		memcpy(_mainScreen->getBasePtr(left, i + top), surface->getBasePtr(0, i), width * surface->format.bytesPerPixel);
 
 	_dirtyScreen = true;
 	applyScreenUpdate();
 }
 
+void RivenGraphics::queueImagePreload(uint16 id) {
+	if (!isImageCached(id) && Common::find(_preloadQueue.begin(), _preloadQueue.end(), id) == _preloadQueue.end())
+		_preloadQueue.push_back(id);
+}
+
+void RivenGraphics::clearImagePreloadQueue() {
+	_preloadQueue.clear();
+}
+
+bool RivenGraphics::preloadNextImage() {
+	while (!_preloadQueue.empty()) {
+		uint16 id = _preloadQueue.front();
+		_preloadQueue.remove_at(0);
+
+		// Only preload images that fit into the cache as it is, so that
+		// preloading never pushes the images in use out of the cache
+		if (!isImageCached(id) && fitsInCache(estimateImageSize(id))) {
+			preloadImage(id);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+uint32 RivenGraphics::estimateImageSize(uint16 id) {
+	// The size of the image once decoded and converted to the screen format,
+	// read from the header of the bitmap
+	Common::SeekableReadStream *stream = _vm->getResource(ID_TBMP, id);
+	uint16 width = stream->readUint16BE() & 0x3FFF;
+	uint16 height = stream->readUint16BE() & 0x3FFF;
+	delete stream;
+
+	return width * height * _pixelFormat.bytesPerPixel;
+}
+
 void RivenGraphics::updateScreen() {
 	if (_dirtyScreen) {
 		// Copy to screen if there's no transition. Otherwise transition.
@@ -673,6 +715,7 @@ void RivenGraphics::drawExtrasImage(uint16 id, const Common::Rect &dstRect) {
 void RivenGraphics::beginCredits() {
 	// Clear the old cache
 	clearCache();
+	clearImagePreloadQueue();
 
 	_creditsImage = kRivenCreditsZeroImage;
 	_creditsPos = 0;
@@ -84,6 +84,12 @@ public:
 	/** Copy a rect from the system screen to the game screen */
 	void copySystemRectToScreen(const Common::Rect &rect);
 
+	// Image preloading
+	void queueImagePreload(uint16 id);
+	void clearImagePreloadQueue();
+	/** Decode the next queued image into the cache, returns false when there is nothing left to do */
+	bool preloadNextImage();
+
 	Graphics::Surface *getEffectScreen();
 	Graphics::Surface *getBackScreen();
 
@@ -121,6 +127,8 @@ protected:
 private:
 	MohawkEngine_Riven *_vm;
 	MohawkBitmap *_bitmapDecoder;
+	Common::Array<uint16> _preloadQueue;
+	uint32 estimateImageSize(uint16 id);
 	int _screenUpdateNesting;
 	bool _screenUpdateRunning;
 	bool _enableCardUpdateScript;
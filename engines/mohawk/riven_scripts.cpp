@@ -218,6 +218,12 @@ void RivenScript::dumpScript(byte tabs) {
 	}
 }
 
+void RivenScript::getCardChanges(Common::Array<uint16> &cards) const {
+	for (uint16 i = 0; i < _commands.size(); i++) {
+		_commands[i]->getCardChanges(cards);
+	}
+}
+
 void RivenScript::run(RivenScriptManager *scriptManager) {
 	for (uint i = 0; i < _commands.size(); i++) {
 		if (scriptManager->stoppingAllScripts()) {
@@ -831,6 +837,11 @@ RivenCommandType RivenSimpleCommand::getType() const {
 	return _type;
 }
 
+void RivenSimpleCommand::getCardChanges(Common::Array<uint16> &cards) const {
+	if (_type == kRivenCommandChangeCard && !_arguments.empty())
+		cards.push_back(_arguments[0]);
+}
+
 RivenSwitchCommand::RivenSwitchCommand(MohawkEngine_Riven *vm) :
 		RivenCommand(vm),
 		_variableId(0) {
@@ -912,6 +923,12 @@ RivenCommandType RivenSwitchCommand::getType() const {
 	return kRivenCommandSwitch;
 }
 
+void RivenSwitchCommand::getCardChanges(Common::Array<uint16> &cards) const {
+	for (uint16 i = 0; i < _branches.size(); i++) {
+		_branches[i].script->getCardChanges(cards);
+	}
+}
+
 void RivenSwitchCommand::applyCardPatches(uint32 globalId, int scriptType, uint16 hotspotId) {
 	for (uint i = 0; i < _branches.size(); i++) {
 		_branches[i].script->applyCardPatches(_vm, globalId, scriptType, hotspotId);
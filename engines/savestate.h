@@ -31,6 +31,10 @@ namespace Graphics {
 struct Surface;
 }
 
+namespace GUI {
+class SaveStateIndex;
+}
+
 /**
  * Object describing a save state.
  *
@@ -43,6 +47,8 @@ struct Surface;
  * Saves are writable and deletable by default.
  */
 class SaveStateDescriptor {
+	// Stores descriptors as they are
+	friend class GUI::SaveStateIndex;
 private:
 	enum SaveType {
 		kSaveTypeUndetermined,
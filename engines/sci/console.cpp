@@ -150,6 +150,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("vpi",                WRAP_METHOD(Console, cmdVisiblePlaneItemList));	// alias
 	registerCmd("saved_bits",         WRAP_METHOD(Console, cmdSavedBits));
 	registerCmd("show_saved_bits",    WRAP_METHOD(Console, cmdShowSavedBits));
+	registerCmd("frame_arena",        WRAP_METHOD(Console, cmdFrameArena));
 	// Segments
 	registerCmd("segment_table",		WRAP_METHOD(Console, cmdPrintSegmentTable));
 	registerCmd("segtable",			WRAP_METHOD(Console, cmdPrintSegmentTable));	// alias
@@ -376,6 +377,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" visible_plane_items / vpi - Shows a list of all items for a plane in the visible draw list (SCI2+)\n");
 	debugPrintf(" saved_bits - List saved bits on the hunk\n");
 	debugPrintf(" show_saved_bits - Display saved bits\n");
+	debugPrintf(" frame_arena - Shows the scratch memory used for the draw lists of the last frame (SCI2+)\n");
 	debugPrintf("\n");
 	debugPrintf("Segments:\n");
 	debugPrintf(" segment_table / segtable - Lists all segments\n");
@@ -2312,6 +2314,25 @@ bool Console::cmdShowSavedBits(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdFrameArena(int argc, const char **argv) {
+#ifdef ENABLE_SCI32
+	if (_engine->_gfxFrameout) {
+		const Common::FrameArena &arena = _engine->_gfxFrameout->getFrameArena();
+		debugPrintf("Draw and erase list items of the last frame: %u allocations, %u bytes\n",
+			arena.getLastFrameAllocations(), arena.getLastFrameBytes());
+		debugPrintf("These used to be separate heap allocations, the arena needed %u heap allocations\n",
+			arena.getChunkAllocations());
+		debugPrintf("in %u frames. Peak frame: %u bytes, arena size: %u bytes\n",
+			arena.getFrameCount(), arena.getPeakFrameBytes(), (uint)arena.getCapacity());
+	} else {
+		debugPrintf("This SCI version does not have a frame arena\n");
+	}
+#else
+	debugPrintf("SCI32 isn't included in this compiled executable\n");
+#endif
+	return true;
+}
+
 
 bool Console::cmdParseGrammar(int argc, const char **argv) {
 	debugPrintf("Parse grammar, in strict GNF:\n");
@@ -23,6 +23,7 @@
 #include "common/config-manager.h"
 #include "common/debug.h"
 #include "common/debug-channels.h"
+#include "common/profiler.h"
 
 #include "sci/sci.h"
 #include "sci/console.h"
@@ -573,6 +574,8 @@ uint32 findOffset(const int16 relOffset, const Script *scr, const uint32 pcOffse
 void run_vm(EngineState *s) {
 	assert(s);
 
+	PROFILE_ZONE("run_vm");
+
 	int temp;
 	reg_t r_temp; // Temporary register
 	StackPtr s_temp; // Temporary stack pointer
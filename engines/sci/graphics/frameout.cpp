@@ -25,6 +25,7 @@
 #include "common/events.h"
 #include "common/keyboard.h"
 #include "common/list.h"
+#include "common/profiler.h"
 #include "common/str.h"
 #include "common/system.h"
 #include "common/textconsole.h"
@@ -469,6 +470,8 @@ void GfxFrameout::kernelAddPicAt(const reg_t planeObject, const GuiResourceId pi
 #pragma mark Rendering
 
 void GfxFrameout::frameOut(const bool shouldShowBits, const Common::Rect &eraseRect) {
+	PROFILE_ZONE("GfxFrameout::frameOut");
+
 	updateMousePositionForRendering();
 
 	RobotDecoder &robotPlayer = g_sci->_video32->getRobotPlayer();
@@ -478,6 +481,10 @@ void GfxFrameout::frameOut(const bool shouldShowBits, const Common::Rect &eraseR
 		robotPlayer.doRobot();
 	}
 
+	// The lists below are allocated from the frame arena, which must be
+	// released after them
+	Common::FrameArena::FrameScope frameScope(_frameArena);
+
 	// SSCI allocated these as static arrays of 100 pointers to
 	// ScreenItemList / RectList
 	ScreenItemListList screenItemLists;
@@ -486,6 +493,11 @@ void GfxFrameout::frameOut(const bool shouldShowBits, const Common::Rect &eraseR
 	screenItemLists.resize(_planes.size());
 	eraseLists.resize(_planes.size());
 
+	for (PlaneList::size_type i = 0; i < _planes.size(); ++i) {
+		screenItemLists[i].setArena(&_frameArena);
+		eraseLists[i].setArena(&_frameArena);
+	}
+
 	if (g_sci->_gfxRemap32->getRemapCount() > 0 && _remapOccurred) {
 		remapMarkRedraw();
 	}
@@ -536,6 +548,10 @@ void GfxFrameout::palMorphFrameOut(const int8 *styleRanges, PlaneShowStyle *show
 	_showList.add(rect);
 	showBits();
 
+	// The lists below are allocated from the frame arena, which must be
+	// released after them
+	Common::FrameArena::FrameScope frameScope(_frameArena);
+
 	// SSCI allocated these as static arrays of 100 pointers to
 	// ScreenItemList / RectList
 	ScreenItemListList screenItemLists;
@@ -544,6 +560,11 @@ void GfxFrameout::palMorphFrameOut(const int8 *styleRanges, PlaneShowStyle *show
 	screenItemLists.resize(_planes.size());
 	eraseLists.resize(_planes.size());
 
+	for (PlaneList::size_type i = 0; i < _planes.size(); ++i) {
+		screenItemLists[i].setArena(&_frameArena);
+		eraseLists[i].setArena(&_frameArena);
+	}
+
 	if (g_sci->_gfxRemap32->getRemapCount() > 0 && _remapOccurred) {
 		remapMarkRedraw();
 	}
@@ -746,6 +767,7 @@ int splitRectsForRender(Common::Rect &middleRect, const Common::Rect &showRect,
 // The third rectangle parameter is only ever passed by VMD code
 void GfxFrameout::calcLists(ScreenItemListList &drawLists, EraseListList &eraseLists, const Common::Rect &eraseRect) {
 	RectList eraseList;
+	eraseList.setArena(&_frameArena);
 	Common::Rect outRects[4];
 	int deletedPlaneCount = 0;
 	bool addedToEraseList = false;
@@ -1010,6 +1032,7 @@ void GfxFrameout::drawScreenItemList(const DrawList &screenItemList) {
 
 void GfxFrameout::mergeToShowList(const Common::Rect &drawRect, RectList &showList, const int overdrawThreshold) {
 	RectList mergeList;
+	mergeList.setArena(&_frameArena);
 	Common::Rect merged;
 	mergeList.add(drawRect);
 
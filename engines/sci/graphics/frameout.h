@@ -231,6 +231,10 @@ public:
 		return _currentBuffer;
 	}
 
+	inline const Common::FrameArena &getFrameArena() const {
+		return _frameArena;
+	}
+
 	void kernelFrameOut(const bool showBits);
 
 	/**
@@ -329,6 +333,12 @@ private:
 	 */
 	RectList _showList;
 
+	/**
+	 * Scratch memory for the draw and erase lists built while rendering a
+	 * frame.
+	 */
+	Common::FrameArena _frameArena;
+
 	/**
 	 * The amount of extra overdraw that is acceptable when merging two show
 	 * list rectangles together into a single larger rectangle.
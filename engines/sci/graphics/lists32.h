@@ -24,6 +24,7 @@
 #define SCI_GRAPHICS_LISTS32_H
 
 #include "common/array.h"
+#include "common/framearena.h"
 
 namespace Sci {
 
@@ -33,11 +34,24 @@ namespace Sci {
  * RectList, and ScreenItemList. StablePointerArray takes ownership of all
  * pointers that are passed to it and deletes them when calling `erase` or when
  * destroying the StablePointerArray.
+ *
+ * Lists that only live for the duration of a frame can be given a frame
+ * arena with `setArena`, in which case the items added through `create` are
+ * allocated from the arena instead of the heap.
  */
 template<class T, uint N>
 class StablePointerArray {
 	uint _size;
 	T *_items[N];
+	Common::FrameArena *_arena;
+
+	void destroy(T *item) {
+		if (_arena && item && _arena->owns(item)) {
+			item->~T();
+		} else {
+			delete item;
+		}
+	}
 
 public:
 	typedef T **iterator;
@@ -45,8 +59,8 @@ public:
 	typedef T *value_type;
 	typedef uint size_type;
 
-	StablePointerArray() : _size(0), _items() {}
-	StablePointerArray(const StablePointerArray &other) : _size(other._size) {
+	StablePointerArray() : _size(0), _items(), _arena(nullptr) {}
+	StablePointerArray(const StablePointerArray &other) : _size(other._size), _arena(nullptr) {
 		for (size_type i = 0; i < _size; ++i) {
 			if (other._items[i] == nullptr) {
 				_items[i] = nullptr;
@@ -57,7 +71,7 @@ public:
 	}
 	~StablePointerArray() {
 		for (size_type i = 0; i < _size; ++i) {
-			delete _items[i];
+			destroy(_items[i]);
 		}
 	}
 
@@ -68,11 +82,34 @@ public:
 			if (other._items[i] == nullptr) {
 				_items[i] = nullptr;
 			} else {
-				_items[i] = new T(*other._items[i]);
+				_items[i] = create(*other._items[i]);
 			}
 		}
 	}
 
+	/**
+	 * Sets the frame arena used by `create`. Items allocated from the arena
+	 * must not outlive the current frame of the arena.
+	 */
+	void setArena(Common::FrameArena *arena) {
+		_arena = arena;
+	}
+
+	Common::FrameArena *getArena() const {
+		return _arena;
+	}
+
+	/**
+	 * Creates a copy of the given item for adding to the array, in the frame
+	 * arena if there is one.
+	 */
+	T *create(const T &item) const {
+		if (_arena) {
+			return new (*_arena) T(item);
+		}
+		return new T(item);
+	}
+
 	T *const &operator[](size_type index) const {
 		assert(index < _size);
 		return _items[index];
@@ -101,7 +138,7 @@ public:
 
 	void clear() {
 		for (size_type i = 0; i < _size; ++i) {
-			delete _items[i];
+			destroy(_items[i]);
 			_items[i] = nullptr;
 		}
 
@@ -122,7 +159,7 @@ public:
 	void erase(T *item) {
 		for (iterator it = begin(); it != end(); ++it) {
 			if (*it == item) {
-				delete *it;
+				destroy(*it);
 				*it = nullptr;
 				break;
 			}
@@ -134,7 +171,7 @@ public:
 	 */
 	void erase(iterator &it) {
 		assert(it >= _items && it < _items + _size);
-		delete *it;
+		destroy(*it);
 		*it = nullptr;
 	}
 
@@ -144,7 +181,7 @@ public:
 	void erase_at(size_type index) {
 		assert(index < _size);
 
-		delete _items[index];
+		destroy(_items[index]);
 		_items[index] = nullptr;
 	}
 
@@ -56,7 +56,7 @@ typedef StablePointerArray<Common::Rect, 200> RectListBase;
 class RectList : public RectListBase {
 public:
 	void add(const Common::Rect &rect) {
-		RectListBase::add(new Common::Rect(rect));
+		RectListBase::add(create(rect));
 	}
 };
 
@@ -25,6 +25,7 @@
 #include "common/file.h"
 #include "common/fs.h"
 #include "common/macresman.h"
+#include "common/memtrack.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
 #ifdef ENABLE_SCI32
@@ -217,6 +218,7 @@ Resource::Resource(ResourceManager *resMan, ResourceId id) : SciSpan<const byte>
 }
 
 Resource::~Resource() {
+	Common::MemoryTracker::trackFree(_data);
 	delete[] _data;
 	delete[] _header;
 	if (_source && _source->getSourceType() == kSourcePatch)
@@ -224,6 +226,7 @@ Resource::~Resource() {
 }
 
 void Resource::unalloc() {
+	Common::MemoryTracker::trackFree(_data);
 	delete[] _data;
 	_data = nullptr;
 	_status = kResStatusNoMalloc;
@@ -388,9 +391,10 @@ Common::SeekableReadStream *ResourceManager::getVolumeFile(ResourceSource *sourc
 		}
 		++it;
 	}
-	// adding a new file
+	// adding a new file, mapped since resources are read from it all the
+	// time and the volumes never change while the game runs
 	file = new Common::File;
-	if (file->open(filename)) {
+	if (file->openMapped(filename)) {
 		if (_volumeFiles.size() == MAX_OPENED_VOLUMES) {
 			it = --_volumeFiles.end();
 			delete *it;
@@ -423,10 +427,14 @@ void ResourceManager::disposeVolumeFileStream(Common::SeekableReadStream *fileSt
 }
 
 void ResourceManager::loadResource(Resource *res) {
+	Common::MemoryTagScope tagScope("sci.resources");
+
 	res->_source->loadResource(this, res);
 	if (_patcher) {
 		_patcher->applyPatch(*res);
 	};
+
+	Common::MemoryTracker::trackAlloc(res->_data, res->_size);
 }
 
 
@@ -25,15 +25,22 @@
 #include "common/str.h"
 #include "common/system.h"
 #include "common/util.h"
+#include "common/zlib.h"
 
 #include "scumm/actor.h"
 #include "scumm/boxes.h"
 #include "scumm/debugger.h"
+#include "scumm/file.h"
+#include "scumm/gfx.h"
 #include "scumm/imuse/imuse.h"
 #include "scumm/object.h"
 #include "scumm/resource.h"
 #include "scumm/scumm.h"
 #include "scumm/sound.h"
+#ifdef ENABLE_SCUMM_7_8
+#include "scumm/smush/codec37.h"
+#include "scumm/smush/codec47.h"
+#endif
 
 namespace Scumm {
 
@@ -97,6 +104,11 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 	registerCmd("imuse",     WRAP_METHOD(ScummDebugger, Cmd_IMuse));
 
 	registerCmd("resetcursors",    WRAP_METHOD(ScummDebugger, Cmd_ResetCursors));
+
+	registerCmd("stripcache",      WRAP_METHOD(ScummDebugger, Cmd_StripCache));
+#ifdef ENABLE_SCUMM_7_8
+	registerCmd("smush_benchmark", WRAP_METHOD(ScummDebugger, Cmd_SmushBenchmark));
+#endif
 }
 
 ScummDebugger::~ScummDebugger() {
@@ -845,4 +857,136 @@ bool ScummDebugger::Cmd_ResetCursors(int argc, const char **argv) {
 	return false;
 }
 
+bool ScummDebugger::Cmd_StripCache(int argc, const char **argv) {
+	if (argc == 2 && !strcmp(argv[1], "reset")) {
+		_vm->_gdi->resetStripCacheStats();
+		_vm->_gdi->invalidateStripCache();
+		debugPrintf("Room strip cache cleared\n");
+		return true;
+	} else if (argc != 1) {
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	const Gdi::StripCacheStats &stats = _vm->_gdi->getStripCacheStats();
+	const uint32 strips = stats.hits + stats.misses;
+	const uint32 masks = stats.maskHits + stats.maskMisses;
+	debugPrintf("Strips: %d hits, %d misses (%d%% hit rate)\n", stats.hits, stats.misses, strips ? stats.hits * 100 / strips : 0);
+	debugPrintf("Masks:  %d hits, %d misses (%d%% hit rate)\n", stats.maskHits, stats.maskMisses, masks ? stats.maskHits * 100 / masks : 0);
+	debugPrintf("Decode time of missed strips and masks: %d ms\n", stats.decodeTime);
+	return true;
+}
+
+#ifdef ENABLE_SCUMM_7_8
+bool ScummDebugger::Cmd_SmushBenchmark(int argc, const char **argv) {
+	if (argc < 2 || argc > 3) {
+		debugPrintf("Usage: %s <file.san> [frames]\n", argv[0]);
+		return true;
+	}
+
+	ScummFile file;
+	if (!_vm->openFile(file, argv[1]) || file.readUint32BE() != MKTAG('A','N','I','M')) {
+		debugPrintf("Unable to open SMUSH animation %s\n", argv[1]);
+		return true;
+	}
+
+	const uint32 animEnd = file.readUint32BE() + file.pos();
+	const int maxFrames = (argc == 3) ? atoi(argv[2]) : -1;
+	Codec37Decoder *codec37 = NULL;
+	Codec47Decoder *codec47 = NULL;
+	byte *dst = NULL;
+	int dstWidth = 0, dstHeight = 0;
+	int frames = 0, count37 = 0, count47 = 0, skipped = 0;
+	uint32 decodeTime = 0;
+
+	while (file.pos() + 8 <= (int32)animEnd && frames != maxFrames && !file.eos()) {
+		const uint32 type = file.readUint32BE();
+		const int32 size = file.readUint32BE();
+		const int32 end = file.pos() + size + (size & 1);
+		if (type != MKTAG('F','R','M','E')) {
+			file.seek(end, SEEK_SET);
+			continue;
+		}
+
+		while (file.pos() + 8 <= end) {
+			const uint32 subType = file.readUint32BE();
+			const int32 subSize = file.readUint32BE();
+			const int32 subEnd = file.pos() + subSize + (subSize & 1);
+			byte *chunk = NULL;
+			byte *fobj = NULL;
+
+			if (subType == MKTAG('F','O','B','J') && subSize >= 14) {
+				chunk = (byte *)malloc(subSize);
+				file.read(chunk, subSize);
+				fobj = chunk;
+#ifdef USE_ZLIB
+			} else if (subType == MKTAG('Z','F','O','B') && subSize > 4) {
+				chunk = (byte *)malloc(subSize);
+				file.read(chunk, subSize);
+				unsigned long fobjSize = READ_BE_UINT32(chunk);
+				fobj = (byte *)malloc(fobjSize);
+				if (fobjSize < 14 || !Common::uncompress(fobj, &fobjSize, chunk + 4, subSize - 4)) {
+					free(fobj);
+					fobj = NULL;
+				}
+#endif
+			}
+
+			if (fobj) {
+				const int codec = READ_LE_UINT16(fobj);
+				const int width = READ_LE_UINT16(fobj + 6);
+				const int height = READ_LE_UINT16(fobj + 8);
+
+				if ((codec == 37 || codec == 47) && (width != dstWidth || height != dstHeight)) {
+					delete codec37;
+					delete codec47;
+					free(dst);
+					codec37 = NULL;
+					codec47 = NULL;
+					dstWidth = width;
+					dstHeight = height;
+					dst = (byte *)calloc(width * height, 1);
+				}
+
+				const uint32 start = g_system->getMillis(true);
+				if (codec == 37) {
+					if (!codec37)
+						codec37 = new Codec37Decoder(width, height);
+					codec37->decode(dst, fobj + 14);
+					count37++;
+				} else if (codec == 47) {
+					if (!codec47)
+						codec47 = new Codec47Decoder(width, height);
+					codec47->decode(dst, fobj + 14);
+					count47++;
+				} else {
+					skipped++;
+				}
+				decodeTime += g_system->getMillis(true) - start;
+
+				if (fobj != chunk)
+					free(fobj);
+			}
+			free(chunk);
+			file.seek(subEnd, SEEK_SET);
+		}
+
+		frames++;
+		file.seek(end, SEEK_SET);
+	}
+
+	delete codec37;
+	delete codec47;
+	free(dst);
+
+	debugPrintf("%s: %d frames, %d codec37 and %d codec47 objects, %d objects with other codecs skipped\n",
+		argv[1], frames, count37, count47, skipped);
+	if (decodeTime)
+		debugPrintf("Decoded in %d ms (%d frames/s)\n", decodeTime, (count37 + count47) * 1000 / decodeTime);
+	else
+		debugPrintf("Decoded in less than 1 ms\n");
+	return true;
+}
+#endif
+
 } // End of namespace Scumm
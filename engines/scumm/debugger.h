@@ -69,6 +69,11 @@ private:
 
 	bool Cmd_ResetCursors(int argc, const char **argv);
 
+	bool Cmd_StripCache(int argc, const char **argv);
+#ifdef ENABLE_SCUMM_7_8
+	bool Cmd_SmushBenchmark(int argc, const char **argv);
+#endif
+
 	void printBox(int box);
 	void drawBox(int box);
 };
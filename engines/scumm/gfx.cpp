@@ -275,6 +275,7 @@ void Gdi::init() {
 }
 
 void Gdi::roomChanged(byte *roomptr) {
+	invalidateStripCache();
 }
 
 void GdiNES::roomChanged(byte *roomptr) {
@@ -1016,7 +1017,7 @@ void ScummEngine::redrawBGStrip(int start, int num) {
 	else
 		room = getResourceAddress(rtRoom, _roomResource);
 
-	_gdi->drawBitmap(room + _IM00_offs, &_virtscr[kMainVirtScreen], s, 0, _roomWidth, _virtscr[kMainVirtScreen].h, s, num, 0);
+	_gdi->drawBitmap(room + _IM00_offs, &_virtscr[kMainVirtScreen], s, 0, _roomWidth, _virtscr[kMainVirtScreen].h, s, num, Gdi::dbRoomBackground);
 }
 
 void ScummEngine::restoreBackground(Common::Rect rect, byte backColor) {
@@ -1824,6 +1825,9 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 	_objectMode = (flag & dbObjectMode) == dbObjectMode;
 	prepareDrawBitmap(ptr, vs, x, y, width, height, stripnr, numstrip);
 
+	const bool useCache = (flag & dbRoomBackground) && y == 0 && prepareStripCache(ptr, vs, height);
+	const int stripSize = 8 * vs->format.bytesPerPixel;
+
 	sx = x - vs->xstart / 8;
 	if (sx < 0) {
 		numstrip -= -sx;
@@ -1856,7 +1860,37 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 		else
 			dstPtr = (byte *)vs->getBasePtr(x * 8, y);
 
-		transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+		if (useCache && stripnr < _stripCache.numStrips && _stripCache.state[stripnr] == kStripCached) {
+			const byte *src = &_stripCache.pixels[stripnr * stripSize * height];
+			byte *dst = dstPtr;
+			for (int h = 0; h < height; ++h) {
+				memcpy(dst, src, stripSize);
+				src += stripSize;
+				dst += vs->pitch;
+			}
+			transpStrip = false;
+			_stripCacheStats.hits++;
+		} else if (useCache && stripnr < _stripCache.numStrips && _stripCache.state[stripnr] == kStripUncached) {
+			uint32 start = _vm->_system->getMillis(true);
+			transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+			_stripCacheStats.decodeTime += _vm->_system->getMillis(true) - start;
+			_stripCacheStats.misses++;
+
+			if (transpStrip) {
+				_stripCache.state[stripnr] = kStripTransparent;
+			} else {
+				byte *dst = &_stripCache.pixels[stripnr * stripSize * height];
+				const byte *src = dstPtr;
+				for (int h = 0; h < height; ++h) {
+					memcpy(dst, src, stripSize);
+					dst += stripSize;
+					src += vs->pitch;
+				}
+				_stripCache.state[stripnr] = kStripCached;
+			}
+		} else {
+			transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+		}
 
 		// COMI and HE games only uses flag value
 		if (_vm->_game.version == 8 || _vm->_game.heversion >= 60)
@@ -1870,7 +1904,10 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 				clear8Col(frontBuf, vs->pitch, height, vs->format.bytesPerPixel);
 		}
 
-		decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
+		if (useCache && stripnr < _stripCache.numStrips)
+			decodeCachedMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
+		else
+			decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
 
 #if 0
 		// HACK: blit mask(s) onto normal screen. Useful to debug masking
@@ -1898,6 +1935,92 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 	}
 }
 
+bool Gdi::prepareStripCache(const byte *ptr, VirtScreen *vs, int height) {
+	if (!supportsStripCache())
+		return false;
+
+	uint colorsSize;
+	const byte *colors = getRoomColors(colorsSize);
+
+	if (_stripCache.bitmap != ptr || _stripCache.height != height ||
+	    _stripCache.colors.size() != colorsSize || memcmp(_stripCache.colors.begin(), colors, colorsSize)) {
+		invalidateStripCache();
+
+		_stripCache.bitmap = ptr;
+		_stripCache.height = height;
+		_stripCache.numStrips = _vm->_roomWidth / 8;
+		_stripCache.colors.resize(colorsSize);
+		memcpy(_stripCache.colors.begin(), colors, colorsSize);
+		_stripCache.state.resize(_stripCache.numStrips);
+		memset(_stripCache.state.begin(), kStripUncached, _stripCache.numStrips);
+		_stripCache.maskPlanes.resize(_stripCache.numStrips);
+		for (int i = 0; i < _stripCache.numStrips; ++i)
+			_stripCache.maskPlanes[i] = 0;
+		_stripCache.pixels.resize(_stripCache.numStrips * 8 * vs->format.bytesPerPixel * height);
+		_stripCache.masks.resize(_stripCache.numStrips * 9 * height);
+	}
+
+	return true;
+}
+
+void Gdi::invalidateStripCache() {
+	_stripCache.bitmap = 0;
+	_stripCache.height = 0;
+	_stripCache.numStrips = 0;
+	_stripCache.colors.clear();
+	_stripCache.state.clear();
+	_stripCache.maskPlanes.clear();
+	_stripCache.pixels.clear();
+	_stripCache.masks.clear();
+}
+
+const byte *Gdi::getRoomColors(uint &size) const {
+	// Room strips always use the room palette, even when drawStrip()
+	// has selected the verb palette for Indy4 Amiga.
+	size = 256;
+	return _vm->_roomPalette;
+}
+
+void Gdi::decodeCachedMask(int x, int y, const int width, const int height,
+	                int stripnr, int numzbuf, const byte *zplane_list[9],
+	                bool transpStrip, byte flag) {
+	// Room backgrounds only write the masks of the z-planes they have.
+	uint16 planes = 0;
+	for (int i = 1; i < numzbuf; i++) {
+		if (zplane_list[i])
+			planes |= 1 << i;
+	}
+
+	byte *cache = &_stripCache.masks[stripnr * 9 * height];
+	if ((_stripCache.maskPlanes[stripnr] & planes) == planes) {
+		for (int i = 1; i < numzbuf; i++) {
+			if (!(planes & (1 << i)))
+				continue;
+			byte *mask_ptr = getMaskBuffer(x, y, i);
+			const byte *src = cache + i * height;
+			for (int h = 0; h < height; h++)
+				mask_ptr[h * _numStrips] = src[h];
+		}
+		_stripCacheStats.maskHits++;
+		return;
+	}
+
+	uint32 start = _vm->_system->getMillis(true);
+	decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
+	_stripCacheStats.decodeTime += _vm->_system->getMillis(true) - start;
+	_stripCacheStats.maskMisses++;
+
+	for (int i = 1; i < numzbuf; i++) {
+		if (!(planes & (1 << i)))
+			continue;
+		const byte *mask_ptr = getMaskBuffer(x, y, i);
+		byte *dst = cache + i * height;
+		for (int h = 0; h < height; h++)
+			dst[h] = mask_ptr[h * _numStrips];
+	}
+	_stripCache.maskPlanes[stripnr] |= planes;
+}
+
 bool Gdi::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width, const int height,
 					int stripnr, const byte *smap_ptr) {
 	// Do some input verification and make sure the strip/strip offset
@@ -3744,6 +3867,11 @@ void Gdi::unkDecode11(byte *dst, int dstPitch, const byte *src, int height) cons
 void GdiHE16bit::writeRoomColor(byte *dst, byte color) const {
 	WRITE_UINT16(dst, READ_LE_UINT16(_vm->_hePalettes + 2048 + color * 2));
 }
+
+const byte *GdiHE16bit::getRoomColors(uint &size) const {
+	size = 512;
+	return _vm->_hePalettes + 2048;
+}
 #endif
 
 void Gdi::writeRoomColor(byte *dst, byte color) const {
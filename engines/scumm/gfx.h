@@ -24,6 +24,7 @@
 #define SCUMM_GFX_H
 
 #include "common/system.h"
+#include "common/array.h"
 #include "common/list.h"
 
 #include "graphics/surface.h"
@@ -209,6 +210,59 @@ protected:
 	/** Flag which is true when an object is being rendered, false otherwise. */
 	bool _objectMode;
 
+	enum StripCacheState {
+		kStripUncached = 0,
+		kStripCached = 1,
+		kStripTransparent = 2   ///< Transparent strips depend on what is below them and are always decoded
+	};
+
+	/**
+	 * Decoded room background strips and their z-plane masks, so that
+	 * redrawing a strip (e.g. when scrolling) only needs to copy it.
+	 * Filled by drawBitmap() when called with dbRoomBackground.
+	 */
+	struct StripCache {
+		const byte *bitmap;            ///< The room bitmap the strips were decoded from
+		int height;                    ///< The height of the decoded strips
+		int numStrips;                 ///< The number of strips in the room
+		Common::Array<byte> colors;    ///< The room colors the strips were decoded with
+		Common::Array<byte> state;     ///< StripCacheState of each strip
+		Common::Array<uint16> maskPlanes; ///< Bit mask of the cached z-planes of each strip
+		Common::Array<byte> pixels;    ///< Decoded strips, 8 pixels wide
+		Common::Array<byte> masks;     ///< Decoded masks, one byte per line for each strip and z-plane
+
+		StripCache() : bitmap(0), height(0), numStrips(0) {}
+	} _stripCache;
+
+public:
+	/** Statistics of the room strip cache. */
+	struct StripCacheStats {
+		uint32 hits;        ///< Strips copied from the cache
+		uint32 misses;      ///< Strips which had to be decoded
+		uint32 maskHits;    ///< Strip masks copied from the cache
+		uint32 maskMisses;  ///< Strip masks which had to be decoded
+		uint32 decodeTime;  ///< Milliseconds spent decoding strips and masks which were missed
+
+		StripCacheStats() : hits(0), misses(0), maskHits(0), maskMisses(0), decodeTime(0) {}
+	};
+
+protected:
+	StripCacheStats _stripCacheStats;
+
+	bool prepareStripCache(const byte *ptr, VirtScreen *vs, int height);
+	void decodeCachedMask(int x, int y, const int width, const int height,
+	                int stripnr, int numzbuf, const byte *zplane_list[9],
+	                bool transpStrip, byte flag);
+
+	/**
+	 * Returns the color table writeRoomColor() maps room colors with.
+	 * Strips decoded with a different table are removed from the strip cache.
+	 */
+	virtual const byte *getRoomColors(uint &size) const;
+
+	/** Returns whether decoded room strips can be cached; false for Gdis which decode whole rooms in advance. */
+	virtual bool supportsStripCache() const { return true; }
+
 public:
 	/** Flag which is true when loading objects or titles for distaff, in PCEngine version of Loom. */
 	bool _distaff;
@@ -279,10 +333,15 @@ public:
 
 	void resetBackground(int top, int bottom, int strip);
 
+	void invalidateStripCache();
+	const StripCacheStats &getStripCacheStats() const { return _stripCacheStats; }
+	void resetStripCacheStats() { _stripCacheStats = StripCacheStats(); }
+
 	enum DrawBitmapFlags {
 		dbAllowMaskOr   = 1 << 0,
 		dbDrawMaskOnAll = 1 << 1,
-		dbObjectMode    = 2 << 2
+		dbObjectMode    = 2 << 2,
+		dbRoomBackground = 1 << 4    ///< The bitmap is the room background; decoded strips may be cached
 	};
 };
 
@@ -333,6 +392,8 @@ protected:
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip) override;
 
+	bool supportsStripCache() const override { return false; }
+
 public:
 	GdiNES(ScummEngine *vm);
 
@@ -376,6 +437,8 @@ protected:
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip) override;
 
+	bool supportsStripCache() const override { return false; }
+
 public:
 	GdiPCEngine(ScummEngine *vm);
 	~GdiPCEngine() override;
@@ -413,6 +476,8 @@ protected:
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip) override;
 
+	bool supportsStripCache() const override { return false; }
+
 public:
 	GdiV1(ScummEngine *vm);
 
@@ -439,6 +504,8 @@ protected:
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip) override;
 
+	bool supportsStripCache() const override { return false; }
+
 public:
 	GdiV2(ScummEngine *vm);
 	~GdiV2() override;
@@ -450,6 +517,7 @@ public:
 class GdiHE16bit : public GdiHE {
 protected:
 	void writeRoomColor(byte *dst, byte color) const override;
+	const byte *getRoomColors(uint &size) const override;
 public:
 	GdiHE16bit(ScummEngine *vm);
 };
@@ -192,6 +192,11 @@ int Player::start_seq_sound(int sound, bool reset_vars) {
 	} else {
 		// SCUMM SMF resource
 		_parser = MidiParser::createParser_SMF();
+		// Jumps and restoring savegames seek without firing events,
+		// so every checkpoint of the seek index can be used. scan()
+		// fires events, and the SysEx messages in the tracks keep it
+		// parsing from the start of the track.
+		_parser->property(MidiParser::mpSeekIndex, 1);
 	}
 
 	_parser->setMidiDriver(this);
@@ -20,6 +20,7 @@
  *
  */
 
+#include "common/memtrack.h"
 #include "common/str.h"
 #ifndef MACOSX
 #include "common/config-manager.h"
@@ -832,6 +833,7 @@ byte *ResourceManager::createResource(ResType type, ResId idx, uint32 size) {
 
 	expireResources(size);
 
+	Common::MemoryTagScope tagScope("scumm.resources");
 	byte *ptr = new byte[size + SAFETY_AREA];
 	if (ptr == NULL) {
 		error("createResource(%s,%d): Out of memory while allocating %d", nameOfResType(type), idx, size);
@@ -839,6 +841,7 @@ byte *ResourceManager::createResource(ResType type, ResId idx, uint32 size) {
 
 	memset(ptr, 0, size + SAFETY_AREA);
 	_allocatedSize += size;
+	Common::MemoryTracker::trackAlloc(ptr, size + SAFETY_AREA);
 
 	_types[type][idx]._address = ptr;
 	_types[type][idx]._size = size;
@@ -856,11 +859,13 @@ ResourceManager::Resource::Resource() {
 }
 
 ResourceManager::Resource::~Resource() {
+	Common::MemoryTracker::trackFree(_address);
 	delete[] _address;
 	_address = 0;
 }
 
 void ResourceManager::Resource::nuke() {
+	Common::MemoryTracker::trackFree(_address);
 	delete[] _address;
 	_address = 0;
 	_size = 0;
@@ -325,6 +325,27 @@ void Codec37Decoder::maketable(int pitch, int index) {
 		dst += 4;						  \
 	} while (0)
 
+/*
+ * Copy a run of 4x4 pixel blocks from the same place in the previous
+ * frame. The blocks of each block row are copied as one span per line.
+ */
+
+static inline void copyBlockRun(byte *&dst, int32 next_offs, int32 length, int32 &i, int &bh, int bw, int pitch) {
+	while (length > 0) {
+		int32 n = MIN(length, i);
+		for (int x = 0; x < 4; x++)
+			memcpy(dst + pitch * x, dst + next_offs + pitch * x, n * 4);
+		dst += n * 4;
+		length -= n;
+		i -= n;
+		if (i == 0) {
+			dst += pitch * 3;
+			bh--;
+			i = bw;
+		}
+	}
+}
+
 void Codec37Decoder::proc1(byte *dst, const byte *src, int32 next_offs, int bw, int bh, int pitch, int16 *offset_table) {
 	uint8 code;
 	bool filling, skipCode;
@@ -439,16 +460,7 @@ void Codec37Decoder::proc4WithFDFE(byte *dst, const byte *src, int32 next_offs,
 				LITERAL_1X1(src, dst, pitch);
 			} else if (code == 0x00) {
 				int32 length = *src++ + 1;
-				for (int32 l = 0; l < length; l++) {
-					byte *dst2 = dst + next_offs;
-					COPY_4X4(dst2, dst, pitch);
-					i--;
-					if (i == 0) {
-						dst += pitch * 3;
-						bh--;
-						i = bw;
-					}
-				}
+				copyBlockRun(dst, next_offs, length, i, bh, bw, pitch);
 				if (bh == 0) {
 					return;
 				}
@@ -471,16 +483,7 @@ void Codec37Decoder::proc4WithoutFDFE(byte *dst, const byte *src, int32 next_off
 				LITERAL_1X1(src, dst, pitch);
 			} else if (code == 0x00) {
 				int32 length = *src++ + 1;
-				for (int32 l = 0; l < length; l++) {
-					byte *dst2 = dst + next_offs;
-					COPY_4X4(dst2, dst, pitch);
-					i--;
-					if (i == 0) {
-						dst += pitch * 3;
-						bh--;
-						i = bw;
-					}
-				}
+				copyBlockRun(dst, next_offs, length, i, bh, bw, pitch);
 				if (bh == 0) {
 					return;
 				}
@@ -31,6 +31,12 @@ namespace Scumm {
 
 #if defined(SCUMM_NEED_ALIGNMENT)
 
+#define COPY_8X1_LINE(dst, src)			\
+	do {					\
+		COPY_4X1_LINE(dst, src);		\
+		COPY_4X1_LINE((dst) + 4, (src) + 4);	\
+	} while (0)
+
 #define COPY_4X1_LINE(dst, src)			\
 	do {					\
 		(dst)[0] = (src)[0];	\
@@ -45,16 +51,11 @@ namespace Scumm {
 		(dst)[1] = (src)[1];	\
 	} while (0)
 
-
-#else /* SCUMM_NEED_ALIGNMENT */
-
-#define COPY_4X1_LINE(dst, src)			\
-	*(uint32 *)(dst) = *(const uint32 *)(src)
-
-#define COPY_2X1_LINE(dst, src)			\
-	*(uint16 *)(dst) = *(const uint16 *)(src)
-
-#endif
+#define FILL_8X1_LINE(dst, val)			\
+	do {					\
+		FILL_4X1_LINE(dst, val);		\
+		FILL_4X1_LINE((dst) + 4, val);	\
+	} while (0)
 
 #define FILL_4X1_LINE(dst, val)			\
 	do {					\
@@ -70,6 +71,31 @@ namespace Scumm {
 		(dst)[1] = val;	\
 	} while (0)
 
+#else /* SCUMM_NEED_ALIGNMENT */
+
+// Whole block lines are moved with a single (unaligned) load and store.
+// Fill values are replicated to all bytes of the word first.
+
+#define COPY_8X1_LINE(dst, src)			\
+	*(uint64 *)(dst) = *(const uint64 *)(src)
+
+#define COPY_4X1_LINE(dst, src)			\
+	*(uint32 *)(dst) = *(const uint32 *)(src)
+
+#define COPY_2X1_LINE(dst, src)			\
+	*(uint16 *)(dst) = *(const uint16 *)(src)
+
+#define FILL_8X1_LINE(dst, val)			\
+	*(uint64 *)(dst) = (byte)(val) * 0x0101010101010101ULL
+
+#define FILL_4X1_LINE(dst, val)			\
+	*(uint32 *)(dst) = (byte)(val) * 0x01010101U
+
+#define FILL_2X1_LINE(dst, val)			\
+	*(uint16 *)(dst) = (byte)(val) * 0x0101U
+
+#endif
+
 static const  int8 codec47_table_small1[] = {
   0, 1, 2, 3, 3, 3, 3, 2, 1, 0, 0, 0, 1, 2, 2, 1,
 };
@@ -451,8 +477,7 @@ void Codec47Decoder::level1(byte *d_dst) {
 	if (code < 0xF8) {
 		tmp2 = _table[code] + _offset1;
 		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp2);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp2 + 4);
+			COPY_8X1_LINE(d_dst, d_dst + tmp2);
 			d_dst += _d_pitch;
 		}
 	} else if (code == 0xFF) {
@@ -466,8 +491,7 @@ void Codec47Decoder::level1(byte *d_dst) {
 	} else if (code == 0xFE) {
 		byte t = *_d_src++;
 		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
+			FILL_8X1_LINE(d_dst, t);
 			d_dst += _d_pitch;
 		}
 	} else if (code == 0xFD) {
@@ -490,15 +514,13 @@ void Codec47Decoder::level1(byte *d_dst) {
 	} else if (code == 0xFC) {
 		tmp2 = _offset2;
 		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp2);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp2 + 4);
+			COPY_8X1_LINE(d_dst, d_dst + tmp2);
 			d_dst += _d_pitch;
 		}
 	} else {
 		byte t = _paramPtr[code];
 		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
+			FILL_8X1_LINE(d_dst, t);
 			d_dst += _d_pitch;
 		}
 	}
@@ -22,6 +22,7 @@
 
 #include "common/config-manager.h"
 #include "common/file.h"
+#include "common/profiler.h"
 #include "common/system.h"
 #include "common/util.h"
 
@@ -737,6 +738,8 @@ void SmushPlayer::handleNewPalette(int32 subSize, Common::SeekableReadStream &b)
 void smush_decode_codec1(byte *dst, const byte *src, int left, int top, int width, int height, int pitch);
 
 void SmushPlayer::decodeFrameObject(int codec, const uint8 *src, int left, int top, int width, int height) {
+	PROFILE_ZONE("SmushPlayer::decodeFrameObject");
+
 	if ((height == 242) && (width == 384)) {
 		if (_specialBuffer == 0)
 			_specialBuffer = (byte *)malloc(242 * 384);
@@ -22,14 +22,187 @@
 
 #include "sword25/console.h"
 #include "sword25/sword25.h"
+#include "sword25/gfx/image/vectorimage.h"
+#include "sword25/kernel/kernel.h"
+#include "sword25/kernel/resmanager.h"
+#include "sword25/package/packagemanager.h"
+
+#include "common/system.h"
+
+#include "common/lua/lua.h"
+#include "common/lua/lauxlib.h"
+#include "common/lua/lua_chunkcache.h"
 
 namespace Sword25 {
 
 Sword25Console::Sword25Console(Sword25Engine *vm) : GUI::Debugger(), _vm(vm) {
 	assert(_vm);
+
+	registerCmd("raster_cache", WRAP_METHOD(Sword25Console, Cmd_RasterCache));
+	registerCmd("raster_bench", WRAP_METHOD(Sword25Console, Cmd_RasterBench));
+	registerCmd("lua_bench", WRAP_METHOD(Sword25Console, Cmd_LuaBench));
 }
 
 Sword25Console::~Sword25Console() {
 }
 
+bool Sword25Console::Cmd_RasterCache(int argc, const char **argv) {
+	ResourceManager *resMan = Kernel::getInstance()->getResourceManager();
+
+	if (argc > 1 && !strcmp(argv[1], "clear")) {
+		resMan->emptyRasterCache();
+		debugPrintf("Vector image rasterization cache cleared\n");
+		return true;
+	}
+
+	debugPrintf("Vector image rasterization cache: %d entries, %d KB\n",
+		resMan->getRasterCacheEntryCount(), resMan->getRasterCacheSize() / 1024);
+	debugPrintf("Hits: %d, misses: %d\n", resMan->getRasterCacheHits(), resMan->getRasterCacheMisses());
+	return true;
+}
+
+bool Sword25Console::Cmd_RasterBench(int argc, const char **argv) {
+	if (argc > 3) {
+		debugPrintf("%s [passes [scale percent]]\n", argv[0]);
+		debugPrintf("Rasterizes all vector images of the game package the given number of times\n");
+		debugPrintf("(default 3) at the given scale (default 100), with and without the cache.\n");
+		return true;
+	}
+
+	int passes = (argc > 1) ? atoi(argv[1]) : 3;
+	int scale = (argc > 2) ? atoi(argv[2]) : 100;
+	if (passes < 1 || scale < 1) {
+		debugPrintf("Invalid parameters\n");
+		return true;
+	}
+
+	PackageManager *pPackage = Kernel::getInstance()->getPackage();
+	ResourceManager *resMan = Kernel::getInstance()->getResourceManager();
+
+	Common::ArchiveMemberList files;
+	pPackage->doSearch(files, "/*.swf", "", PackageManager::FT_FILE);
+
+	// Parse all images up front, so that only the rasterization is measured
+	Common::Array<VectorImage *> images;
+	for (Common::ArchiveMemberList::iterator it = files.begin(); it != files.end(); ++it) {
+		Common::String fileName = "/" + (*it)->getName();
+		uint fileSize;
+		byte *fileData = pPackage->getFile(fileName, &fileSize);
+		if (!fileData)
+			continue;
+
+		bool result = false;
+		VectorImage *image = new VectorImage(fileData, fileSize, result, fileName);
+		delete[] fileData;
+		if (result)
+			images.push_back(image);
+		else
+			delete image;
+	}
+
+	uint32 uncachedTime = 0;
+	uint32 cachedTime = 0;
+	uint32 pixels = 0;
+
+	for (int pass = 0; pass < passes; pass++) {
+		for (uint i = 0; i < images.size(); i++) {
+			int width = MAX(1, images[i]->getWidth() * scale / 100);
+			int height = MAX(1, images[i]->getHeight() * scale / 100);
+
+			uint32 start = g_system->getMillis();
+			free(images[i]->render(width, height));
+			uncachedTime += g_system->getMillis() - start;
+
+			start = g_system->getMillis();
+			if (!resMan->getRasterizedImage(images[i], width, height))
+				resMan->addRasterizedImage(images[i], width, height, images[i]->render(width, height));
+			cachedTime += g_system->getMillis() - start;
+
+			pixels += width * height;
+		}
+	}
+
+	debugPrintf("%d vector images, %d passes, %d pixels rasterized\n", images.size(), passes, pixels);
+	debugPrintf("Without cache: %d ms, with cache: %d ms\n", uncachedTime, cachedTime);
+
+	for (uint i = 0; i < images.size(); i++)
+		delete images[i];
+
+	return true;
+}
+
+bool Sword25Console::Cmd_LuaBench(int argc, const char **argv) {
+	if (argc > 2) {
+		debugPrintf("%s [passes]\n", argv[0]);
+		debugPrintf("Compiles all scripts of the game package the given number of times\n");
+		debugPrintf("(default 3), from source and from the bytecode cache.\n");
+		return true;
+	}
+
+	int passes = (argc > 1) ? atoi(argv[1]) : 3;
+	if (passes < 1) {
+		debugPrintf("Invalid parameters\n");
+		return true;
+	}
+
+	PackageManager *pPackage = Kernel::getInstance()->getPackage();
+
+	Common::ArchiveMemberList files;
+	pPackage->doSearch(files, "/*.lua", "", PackageManager::FT_FILE);
+
+	// Read all scripts up front, so that only the compilation is measured
+	Common::StringArray names;
+	Common::Array<Common::String> scripts;
+	uint32 totalSize = 0;
+	for (Common::ArchiveMemberList::iterator it = files.begin(); it != files.end(); ++it) {
+		Common::String fileName = "/" + (*it)->getName();
+		uint fileSize;
+		byte *fileData = pPackage->getFile(fileName, &fileSize);
+		if (!fileData)
+			continue;
+
+		names.push_back("@" + pPackage->getAbsolutePath(fileName));
+		scripts.push_back(Common::String((const char *)fileData, fileSize));
+		totalSize += fileSize;
+		delete[] fileData;
+	}
+
+	// Compile into a separate state, the game state is left alone
+	lua_State *L = luaL_newstate();
+
+	// Make sure the cache holds all scripts before measuring it
+	uint32 start = g_system->getMillis();
+	for (uint i = 0; i < scripts.size(); i++) {
+		if (Lua::loadBufferCached(L, scripts[i].c_str(), scripts[i].size(), names[i].c_str()) == 0)
+			lua_pop(L, 1);
+	}
+	uint32 fillTime = g_system->getMillis() - start;
+
+	uint32 sourceTime = 0;
+	uint32 cachedTime = 0;
+	int failures = 0;
+
+	for (int pass = 0; pass < passes; pass++) {
+		for (uint i = 0; i < scripts.size(); i++) {
+			start = g_system->getMillis();
+			int status = luaL_loadbuffer(L, scripts[i].c_str(), scripts[i].size(), names[i].c_str());
+			lua_pop(L, 1);
+			sourceTime += g_system->getMillis() - start;
+
+			start = g_system->getMillis();
+			if (Lua::loadBufferCached(L, scripts[i].c_str(), scripts[i].size(), names[i].c_str()) != 0 || status != 0)
+				failures++;
+			lua_pop(L, 1);
+			cachedTime += g_system->getMillis() - start;
+		}
+	}
+
+	lua_close(L);
+
+	debugPrintf("%d scripts (%d KB), %d passes, %d failed to compile\n", scripts.size(), totalSize / 1024, passes, failures);
+	debugPrintf("From source: %d ms, from cache: %d ms (filling the cache took %d ms)\n", sourceTime, cachedTime, fillTime);
+
+	return true;
+}
+
 } // End of namespace Sword25
@@ -35,6 +35,10 @@ public:
 	~Sword25Console(void) override;
 
 private:
+	bool Cmd_RasterCache(int argc, const char **argv);
+	bool Cmd_RasterBench(int argc, const char **argv);
+	bool Cmd_LuaBench(int argc, const char **argv);
+
 	Sword25Engine *_vm;
 };
 
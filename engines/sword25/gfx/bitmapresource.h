@@ -51,6 +51,13 @@ public:
 		return (_pImage != 0);
 	}
 
+	/**
+	    @brief Gibt den Speicherbedarf der Pixeldaten in Bytes zurück (32 Bit pro Pixel).
+	*/
+	uint getMemoryUsage() const override {
+		return _pImage ? _pImage->getWidth() * _pImage->getHeight() * 4 : 0;
+	}
+
 	/**
 	    @brief Gibt die Breite des Bitmaps zurück.
 	*/
@@ -146,6 +146,9 @@ bool GraphicEngine::endFrame() {
 
 	g_system->updateScreen();
 
+	// Use the rest of the frame to load the resources queued by the scripts
+	Kernel::getInstance()->getResourceManager()->processPreloadQueue();
+
 	return true;
 }
 
@@ -183,7 +183,11 @@ public:
 	}
 	bool fill(const Common::Rect *pFillRect = 0, uint color = BS_RGB(0, 0, 0)) override;
 
-	void render(int width, int height);
+	/**
+	    @brief Rasterizes the image at the given size.
+	    @return A malloc()ed ARGB32 buffer of width * height pixels, which the caller must free.
+	*/
+	byte *render(int width, int height);
 
 	uint getPixel(int x, int y) override;
 	bool isBlitSource() const override {
@@ -225,8 +229,6 @@ private:
 	Common::Array<VectorImageElement>    _elements;
 	Common::Rect                         _boundingBox;
 
-	byte *_pixelData;
-
 	Common::String _fname;
 	uint _bgColor;
 };
@@ -37,6 +37,7 @@
 #include "sword25/gfx/graphicengine.h"
 #include "sword25/gfx/animationtemplateregistry.h"
 #include "common/rect.h"
+#include "common/profiler.h"
 #include "sword25/gfx/renderobject.h"
 #include "sword25/gfx/timedrenderobject.h"
 #include "sword25/gfx/rootrenderobject.h"
@@ -88,6 +89,8 @@ void RenderObjectManager::startFrame() {
 }
 
 bool RenderObjectManager::render() {
+	PROFILE_ZONE("RenderObjectManager::render");
+
 	// Den Objekt-Status des Wurzelobjektes aktualisieren. Dadurch werden rekursiv alle Baumelemente aktualisiert.
 	// Beim aktualisieren des Objekt-Status werden auch die Update-Rects gefunden, so dass feststeht, was neu gezeichnet
 	// werden muss.
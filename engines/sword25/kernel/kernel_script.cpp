@@ -310,11 +310,9 @@ static int precacheResource(lua_State *L) {
 	ResourceManager *pResource = pKernel->getResourceManager();
 	assert(pResource);
 
-#ifdef PRECACHE_RESOURCES
-	lua_pushbooleancpp(L, pResource->precacheResource(luaL_checkstring(L, 1)));
-#else
+	// Load the resource in the background, instead of stalling the script
+	pResource->queuePreload(luaL_checkstring(L, 1));
 	lua_pushbooleancpp(L, true);
-#endif
 
 	return 1;
 }
@@ -340,9 +338,7 @@ static int getMaxMemoryUsage(lua_State *L) {
 	ResourceManager *pResource = pKernel->getResourceManager();
 	assert(pResource);
 
-	// This is used for debugging, so it doesn't really matter.
-	// The default value set by the scripts is 256000000 bytes
-	lua_pushnumber(L, 256000000);
+	lua_pushnumber(L, pResource->getMaxMemoryUsage());
 
 	return 1;
 }
@@ -353,8 +349,31 @@ static int setMaxMemoryUsage(lua_State *L) {
 	ResourceManager *pResource = pKernel->getResourceManager();
 	assert(pResource);
 
-	// This call is ignored, we set a limit on the number of
-	// simultaneous resources loaded instead.
+	// Only preloading keeps to this budget. The cache itself is limited
+	// by the number of simultaneously loaded resources instead.
+	pResource->setMaxMemoryUsage(static_cast<uint>(luaL_checknumber(L, 1)));
+
+	return 0;
+}
+
+static int getPendingPreloadCount(lua_State *L) {
+	Kernel *pKernel = Kernel::getInstance();
+	assert(pKernel);
+	ResourceManager *pResource = pKernel->getResourceManager();
+	assert(pResource);
+
+	lua_pushnumber(L, pResource->getPendingPreloadCount());
+
+	return 1;
+}
+
+static int cancelPreloads(lua_State *L) {
+	Kernel *pKernel = Kernel::getInstance();
+	assert(pKernel);
+	ResourceManager *pResource = pKernel->getResourceManager();
+	assert(pResource);
+
+	pResource->cancelPreloads();
 
 	return 0;
 }
@@ -388,6 +407,8 @@ static const luaL_reg RESOURCE_FUNCTIONS[] = {
 	{"ForcePrecacheResource", forcePrecacheResource},
 	{"GetMaxMemoryUsage", getMaxMemoryUsage},
 	{"SetMaxMemoryUsage", setMaxMemoryUsage},
+	{"GetPendingPreloadCount", getPendingPreloadCount},
+	{"CancelPreloads", cancelPreloads},
 	{"EmptyCache", emptyCache},
 	{"IsLogCacheMiss", dummyFuncError},
 	{"SetLogCacheMiss", dummyFuncError},
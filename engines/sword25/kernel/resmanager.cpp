@@ -35,6 +35,9 @@
 #include "sword25/kernel/resservice.h"
 #include "sword25/package/packagemanager.h"
 
+#include "common/memtrack.h"
+#include "common/system.h"
+
 namespace Sword25 {
 
 // Sets the amount of resources that are simultaneously loaded.
@@ -46,8 +49,18 @@ namespace Sword25 {
 // are loaded, the resource manager will start purging resources till it
 // hits the minimum limit above
 #define SWORD25_RESOURCECACHE_MAX 500
+// The memory budget in bytes for rasterized vector images. Each distinct
+// size a vector image is displayed at costs width * height * 4 bytes.
+#define SWORD25_RASTERCACHE_MAXSIZE (8 * 1024 * 1024)
+// The time in milliseconds per frame that may be spent on loading queued
+// resources. A resource is always loaded completely, so the time slice may
+// be overrun by the resource that is being loaded when it runs out.
+#define SWORD25_PRELOAD_TIMESLICE 4
 
 ResourceManager::~ResourceManager() {
+	// Free all rasterized vector images
+	emptyRasterCache();
+
 	// Clear all unlocked resources
 	emptyCache();
 
@@ -220,6 +233,45 @@ bool ResourceManager::precacheResource(const Common::String &fileName, bool forc
 
 #endif
 
+void ResourceManager::queuePreload(const Common::String &fileName) {
+	Common::String uniqueFileName = getUniqueFileName(fileName);
+	if (uniqueFileName.empty() || getResource(uniqueFileName) || _preloadQueued.contains(uniqueFileName))
+		return;
+
+	debugC(kDebugResource, "Queueing \"%s\" for preloading", uniqueFileName.c_str());
+	_preloadQueue.push(uniqueFileName);
+	_preloadQueued[uniqueFileName] = true;
+}
+
+void ResourceManager::processPreloadQueue() {
+	uint32 startTime = g_system->getMillis();
+
+	while (!_preloadQueue.empty()) {
+		// Stop once the loaded resources use up the memory budget. Loading
+		// must also not trigger a purge, as that would throw out resources
+		// that were used more recently than the preloaded ones.
+		if (_usedMemory >= _maxMemoryUsage || _resources.size() >= SWORD25_RESOURCECACHE_MAX)
+			return;
+
+		Common::String fileName = _preloadQueue.pop();
+		_preloadQueued.erase(fileName);
+
+		// The resource may have been requested in the meantime. A missing
+		// or broken file is left for the actual request to report.
+		PackageManager *pPackage = (PackageManager *)_kernelPtr->getPackage();
+		if (!getResource(fileName) && (!pPackage->fileExists(fileName) || !loadResource(fileName, false)))
+			debugC(kDebugResource, "Could not preload \"%s\"", fileName.c_str());
+
+		if (g_system->getMillis() - startTime >= SWORD25_PRELOAD_TIMESLICE)
+			return;
+	}
+}
+
+void ResourceManager::cancelPreloads() {
+	_preloadQueue.clear();
+	_preloadQueued.clear();
+}
+
 /**
  * Moves a resource to the top of the resource list
  * @param pResource     The resource
@@ -238,8 +290,9 @@ void ResourceManager::moveToFront(Resource *pResource) {
  *
  * The resource must not already be loaded
  * @param FileName      The unique filename of the resource to be loaded
+ * @param Required      Whether failing to load the resource is fatal
  */
-Resource *ResourceManager::loadResource(const Common::String &fileName) {
+Resource *ResourceManager::loadResource(const Common::String &fileName, bool required) {
 	// ResourceService finden, der die Resource laden kann.
 	for (uint i = 0; i < _resourceServices.size(); ++i) {
 		if (_resourceServices[i]->canLoadResource(fileName)) {
@@ -247,12 +300,17 @@ Resource *ResourceManager::loadResource(const Common::String &fileName) {
 			deleteResourcesIfNecessary();
 
 			// Load the resource
+			Common::MemoryTagScope tagScope("sword25.resources");
 			Resource *pResource = _resourceServices[i]->loadResource(fileName);
 			if (!pResource) {
-				error("Responsible service could not load resource \"%s\".", fileName.c_str());
+				if (required)
+					error("Responsible service could not load resource \"%s\".", fileName.c_str());
 				return NULL;
 			}
 
+			pResource->_memoryUsage = pResource->getMemoryUsage();
+			_usedMemory += pResource->_memoryUsage;
+
 			// Add the resource to the front of the list
 			_resources.push_front(pResource);
 			pResource->_iterator = _resources.begin();
@@ -298,6 +356,7 @@ Common::List<Resource *>::iterator ResourceManager::deleteResource(Resource *pRe
 
 	// Delete the resource from the resource list
 	Common::List<Resource *>::iterator result = _resources.erase(pResource->_iterator);
+	_usedMemory -= pResource->_memoryUsage;
 
 	// Delete the resource
 	delete pResource;
@@ -331,4 +390,61 @@ void ResourceManager::dumpLockedResources() {
 	}
 }
 
+byte *ResourceManager::getRasterizedImage(const VectorImage *pImage, int width, int height) {
+	for (Common::List<RasterCacheEntry>::iterator iter = _rasterCache.begin(); iter != _rasterCache.end(); ++iter) {
+		if (iter->image == pImage && iter->width == width && iter->height == height) {
+			// Move the entry to the front of the list, so that it is purged last
+			if (iter != _rasterCache.begin()) {
+				RasterCacheEntry entry = *iter;
+				_rasterCache.erase(iter);
+				_rasterCache.push_front(entry);
+			}
+			++_rasterCacheHits;
+			return _rasterCache.front().pixelData;
+		}
+	}
+
+	++_rasterCacheMisses;
+	return NULL;
+}
+
+void ResourceManager::addRasterizedImage(const VectorImage *pImage, int width, int height, byte *pixelData) {
+	RasterCacheEntry entry;
+	entry.image = pImage;
+	entry.width = width;
+	entry.height = height;
+	entry.pixelData = pixelData;
+	_rasterCache.push_front(entry);
+	_rasterCacheSize += width * height * 4;
+
+	// Purge the least recently used rasterizations until the cache fits its budget
+	// again. The entry just added is always kept, as the caller is about to use it.
+	while (_rasterCacheSize > SWORD25_RASTERCACHE_MAXSIZE && _rasterCache.size() > 1) {
+		RasterCacheEntry &last = _rasterCache.back();
+		_rasterCacheSize -= last.width * last.height * 4;
+		free(last.pixelData);
+		_rasterCache.pop_back();
+	}
+}
+
+void ResourceManager::removeRasterizedImages(const VectorImage *pImage) {
+	Common::List<RasterCacheEntry>::iterator iter = _rasterCache.begin();
+	while (iter != _rasterCache.end()) {
+		if (iter->image == pImage) {
+			_rasterCacheSize -= iter->width * iter->height * 4;
+			free(iter->pixelData);
+			iter = _rasterCache.erase(iter);
+		} else
+			++iter;
+	}
+}
+
+void ResourceManager::emptyRasterCache() {
+	for (Common::List<RasterCacheEntry>::iterator iter = _rasterCache.begin(); iter != _rasterCache.end(); ++iter)
+		free(iter->pixelData);
+
+	_rasterCache.clear();
+	_rasterCacheSize = 0;
+}
+
 } // End of namespace Sword25
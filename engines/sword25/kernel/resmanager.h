@@ -35,6 +35,7 @@
 #include "common/list.h"
 #include "common/hashmap.h"
 #include "common/hash-str.h"
+#include "common/queue.h"
 
 #include "sword25/kernel/common.h"
 
@@ -42,9 +43,14 @@ namespace Sword25 {
 
 //#define PRECACHE_RESOURCES
 
+// The default memory budget for preloaded resources in bytes, the value the
+// scripts set with Resource.SetMaxMemoryUsage()
+#define SWORD25_RESOURCE_MAXMEMORY 256000000
+
 class ResourceService;
 class Resource;
 class Kernel;
+class VectorImage;
 
 class ResourceManager {
 	friend class Kernel;
@@ -66,6 +72,55 @@ public:
 	bool precacheResource(const Common::String &fileName, bool forceReload = false);
 #endif
 
+	/**
+	 * Queues a resource to be loaded in the background. Queued resources are
+	 * loaded one after another between frames by processPreloadQueue(), so that
+	 * the assets of the next scene are available when it is entered.
+	 * @param FileName      The filename of the resource to be preloaded
+	 */
+	void queuePreload(const Common::String &fileName);
+
+	/**
+	 * Loads queued resources until the time slice for the current frame is used
+	 * up. Preloading pauses while the loaded resources use up the memory budget,
+	 * or when loading another resource would purge the cache, so that it never
+	 * forces resources that are in use out of the cache.
+	 */
+	void processPreloadQueue();
+
+	/**
+	 * Discards all queued preload requests
+	 */
+	void cancelPreloads();
+
+	/**
+	 * Returns the number of queued preload requests
+	 */
+	uint getPendingPreloadCount() const {
+		return _preloadQueue.size();
+	}
+
+	/**
+	 * Returns the estimated memory used by the loaded resources in bytes
+	 */
+	uint getUsedMemory() const {
+		return _usedMemory;
+	}
+
+	/**
+	 * Returns the memory budget for preloaded resources in bytes
+	 */
+	uint getMaxMemoryUsage() const {
+		return _maxMemoryUsage;
+	}
+
+	/**
+	 * Sets the memory budget for preloaded resources in bytes
+	 */
+	void setMaxMemoryUsage(uint maxMemoryUsage) {
+		_maxMemoryUsage = maxMemoryUsage;
+	}
+
 	/**
 	 * Registers a RegisterResourceService. This method is the constructor of
 	 * BS_ResourceService, and thus helps all resource services in the ResourceManager list
@@ -88,13 +143,58 @@ public:
 	 */
 	void dumpLockedResources();
 
+	/**
+	 * Returns the cached rasterization of a vector image at the given size,
+	 * or NULL if the image has not been rasterized at this size yet.
+	 * @param pImage        The vector image
+	 * @param Width         The width of the rasterization
+	 * @param Height        The height of the rasterization
+	 */
+	byte *getRasterizedImage(const VectorImage *pImage, int width, int height);
+
+	/**
+	 * Stores the rasterization of a vector image in the cache. The cache takes
+	 * ownership of the pixel data, which must have been allocated with malloc().
+	 * The least recently used rasterizations are freed when the cache grows
+	 * beyond its memory budget.
+	 * @param pImage        The vector image
+	 * @param Width         The width of the rasterization
+	 * @param Height        The height of the rasterization
+	 * @param PixelData     The ARGB32 pixel data
+	 */
+	void addRasterizedImage(const VectorImage *pImage, int width, int height, byte *pixelData);
+
+	/**
+	 * Removes all cached rasterizations of a vector image
+	 * @param pImage        The vector image
+	 */
+	void removeRasterizedImages(const VectorImage *pImage);
+
+	/**
+	 * Releases all cached vector image rasterizations
+	 */
+	void emptyRasterCache();
+
+	/**
+	 * Statistics of the vector image rasterization cache
+	 */
+	uint getRasterCacheEntryCount() const { return _rasterCache.size(); }
+	uint32 getRasterCacheSize() const { return _rasterCacheSize; }
+	uint32 getRasterCacheHits() const { return _rasterCacheHits; }
+	uint32 getRasterCacheMisses() const { return _rasterCacheMisses; }
+
 private:
 	/**
 	 * Creates a new resource manager
 	 * Only the BS_Kernel class can generate copies this class. Thus, the constructor is private
 	 */
 	ResourceManager(Kernel *pKernel) :
-		_kernelPtr(pKernel)
+		_kernelPtr(pKernel),
+		_usedMemory(0),
+		_maxMemoryUsage(SWORD25_RESOURCE_MAXMEMORY),
+		_rasterCacheSize(0),
+		_rasterCacheHits(0),
+		_rasterCacheMisses(0)
 	{}
 	virtual ~ResourceManager();
 
@@ -109,8 +209,10 @@ private:
 	 *
 	 * The resource must not already be loaded
 	 * @param FileName      The unique filename of the resource to be loaded
+	 * @param Required      Whether failing to load the resource is fatal. Preloads are only hints
+	 * and just skip resources that cannot be loaded.
 	 */
-	Resource *loadResource(const Common::String &fileName);
+	Resource *loadResource(const Common::String &fileName, bool required = true);
 
 	/**
 	 * Returns the full path of a given resource filename.
@@ -139,6 +241,23 @@ private:
 	Common::List<Resource *> _resources;
 	typedef Common::HashMap<Common::String, Resource *> ResMap;
 	ResMap _resourceHashMap;
+	uint _usedMemory;
+	uint _maxMemoryUsage;
+	Common::Queue<Common::String> _preloadQueue;
+	/** The file names in _preloadQueue, so that each is only queued once */
+	Common::HashMap<Common::String, bool> _preloadQueued;
+
+	struct RasterCacheEntry {
+		const VectorImage *image;
+		int width;
+		int height;
+		byte *pixelData;
+	};
+	/** Rasterized vector images, most recently used first */
+	Common::List<RasterCacheEntry> _rasterCache;
+	uint32 _rasterCacheSize;
+	uint32 _rasterCacheHits;
+	uint32 _rasterCacheMisses;
 };
 
 } // End of namespace Sword25
@@ -92,6 +92,15 @@ public:
 		return _type;
 	}
 
+	/**
+	 * Returns an estimate of the memory used by the resource in bytes. The
+	 * resource manager keeps preloaded resources within its memory budget
+	 * based on it.
+	 */
+	virtual uint getMemoryUsage() const {
+		return 0;
+	}
+
 protected:
 	virtual ~Resource() {}
 
@@ -99,6 +108,7 @@ private:
 	Common::String _fileName;          ///< The absolute filename
 	uint _refCount;          ///< The number of locks
 	uint _type;              ///< The type of the resource
+	uint _memoryUsage;       ///< The memory usage charged to the resource manager
 	Common::List<Resource *>::iterator _iterator;        ///< Points to the resource position in the LRU list
 };
 
@@ -43,6 +43,7 @@
 #include "common/lua/lua.h"
 #include "common/lua/lualib.h"
 #include "common/lua/lauxlib.h"
+#include "common/lua/lua_chunkcache.h"
 #include "common/lua/lua_persistence.h"
 
 namespace Sword25 {
@@ -153,7 +154,7 @@ bool LuaScriptEngine::executeFile(const Common::String &fileName) {
 	}
 
 	// Run the file content
-	if (!executeBuffer(fileData, fileSize, "@" + pPackage->getAbsolutePath(fileName))) {
+	if (!executeBuffer(fileData, fileSize, "@" + pPackage->getAbsolutePath(fileName), true)) {
 		// Release file buffer
 		delete[] fileData;
 #ifdef DEBUG
@@ -199,9 +200,11 @@ bool LuaScriptEngine::registerStandardLibs() {
 	return true;
 }
 
-bool LuaScriptEngine::executeBuffer(const byte *data, uint size, const Common::String &name) const {
+bool LuaScriptEngine::executeBuffer(const byte *data, uint size, const Common::String &name, bool useCache) const {
 	// Compile buffer
-	if (luaL_loadbuffer(_state, (const char *)data, size, name.c_str()) != 0) {
+	int status = useCache ? Lua::loadBufferCached(_state, (const char *)data, size, name.c_str()) :
+	                        luaL_loadbuffer(_state, (const char *)data, size, name.c_str());
+	if (status != 0) {
 		error("Couldn't compile \"%s\":\n%s", name.c_str(), lua_tostring(_state, -1));
 		lua_pop(_state, 1);
 
@@ -99,7 +99,11 @@ private:
 
 	bool registerStandardLibs();
 	bool registerStandardLibExtensions();
-	bool executeBuffer(const byte *data, uint size, const Common::String &name) const;
+	/**
+	 * Compiles and runs a buffer of Lua code.
+	 * @param useCache      If true, the compiled code is kept in the bytecode cache
+	 */
+	bool executeBuffer(const byte *data, uint size, const Common::String &name, bool useCache = false) const;
 };
 
 } // End of namespace Sword25
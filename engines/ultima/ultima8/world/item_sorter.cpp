@@ -42,8 +42,8 @@ namespace Ultima8 {
 
 // This does NOT need to be in the header
 struct SortItem {
-	SortItem(SortItem *n) : _next(n), _prev(nullptr), _itemNum(0),
-			_shape(nullptr), _order(-1), _depends(), _shapeNum(0),
+	SortItem(SortItem *n, Common::FrameArena *arena) : _next(n), _prev(nullptr), _itemNum(0),
+			_shape(nullptr), _order(-1), _depends(arena), _shapeNum(0),
 			_frame(0), _flags(0), _extFlags(0), _sx(0), _sy(0),
 			_sx2(0), _sy2(0), _x(0), _y(0), _z(0), _xLeft(0),
 			_yFar(0), _zTop(0), _sxLeft(0), _sxRight(0), _sxTop(0),
@@ -120,6 +120,8 @@ struct SortItem {
 	// Alternatively i could use Std::list, BUT there is no guarentee that it will keep wont delete
 	// the unused nodes after doing a clear
 	// So the only reasonable solution is to write my own list
+	// The nodes come from the ItemSorter's arena and are released all at
+	// once when the next display list is started
 	struct DependsList {
 		struct Node {
 			Node        *_next;
@@ -130,7 +132,7 @@ struct SortItem {
 
 		Node *list;
 		Node *tail;
-		Node *unused;
+		Common::FrameArena *arena;
 
 		struct iterator {
 			Node *n;
@@ -155,18 +157,12 @@ struct SortItem {
 		}
 
 		void clear() {
-			if (tail) {
-				tail->_next = unused;
-				unused = list;
-				tail = nullptr;
-				list = nullptr;
-			}
+			tail = nullptr;
+			list = nullptr;
 		}
 
 		void push_back(SortItem *other) {
-			if (!unused) unused = new Node();
-			Node *nn = unused;
-			unused = unused->_next;
+			Node *nn = new (*arena) Node();
 			nn->val = other;
 
 			// Put it at the end
@@ -178,9 +174,7 @@ struct SortItem {
 		}
 
 		void insert_sorted(SortItem *other) {
-			if (!unused) unused = new Node();
-			Node *nn = unused;
-			unused = unused->_next;
+			Node *nn = new (*arena) Node();
 			nn->val = other;
 
 			for (Node *n = list; n != nullptr; n = n->_next) {
@@ -203,16 +197,7 @@ struct SortItem {
 			tail = nn;
 		}
 
-		DependsList() : list(nullptr), tail(nullptr), unused(nullptr) { }
-
-		~DependsList() {
-			clear();
-			while (unused)  {
-				Node *n = unused->_next;
-				delete unused;
-				unused = n;
-			}
-		}
+		explicit DependsList(Common::FrameArena *a) : list(nullptr), tail(nullptr), arena(a) { }
 	};
 
 	//Std::vector<SortItem *>   _depends;    // All this Items dependencies (i.e. all objects behind)
@@ -584,7 +569,9 @@ ItemSorter::ItemSorter() :
 	_shapes(nullptr), _surf(nullptr), _items(nullptr), _itemsTail(nullptr),
 	_itemsUnused(nullptr), _sortLimit(0), _camSx(0), _camSy(0), _orderCounter(0) {
 	int i = 2048;
-	while (i--) _itemsUnused = new SortItem(_itemsUnused);
+	while (i--) _itemsUnused = new SortItem(_itemsUnused, &_dependsArena);
+
+	_dependsArena.beginFrame();
 }
 
 ItemSorter::~ItemSorter() {
@@ -618,6 +605,11 @@ void ItemSorter::BeginDisplayList(RenderSurface *rs,
 	_items = nullptr;
 	_itemsTail = nullptr;
 
+	// Release the dependency lists of the previous display list. They are
+	// kept until now, since Trace() may still need them
+	_dependsArena.endFrame();
+	_dependsArena.beginFrame();
+
 	// Set the RenderSurface, and reset the item list
 	_surf = rs;
 	_orderCounter = 0;
@@ -632,7 +624,7 @@ void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 fram
 
 	// First thing, get a SortItem to use (first of unused)
 	if (!_itemsUnused)
-		_itemsUnused = new SortItem(0);
+		_itemsUnused = new SortItem(0, &_dependsArena);
 	SortItem *si = _itemsUnused;
 
 	si->_itemNum = itemNum;
@@ -707,9 +699,7 @@ void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 fram
 	si->_occluded = false;
 	si->_order = -1;
 
-	// We will clear all the vector memory
-	// Stictly speaking the vector will sort of leak memory, since they
-	// are never deleted
+	// The nodes of the old list were released with the previous display list
 	si->_depends.clear();
 
 	// Iterate the list and compare _shapes
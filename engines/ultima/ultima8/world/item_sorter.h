@@ -23,6 +23,8 @@
 #ifndef ULTIMA8_WORLD_ITEMSORTER_H
 #define ULTIMA8_WORLD_ITEMSORTER_H
 
+#include "common/framearena.h"
+
 namespace Ultima {
 namespace Ultima8 {
 
@@ -44,6 +46,8 @@ class ItemSorter {
 
 	int32       _camSx, _camSy;
 
+	Common::FrameArena _dependsArena;
+
 public:
 	ItemSorter();
 	~ItemSorter();
@@ -50,6 +50,7 @@ Console::Console(ZVision *engine) : GUI::Debugger(), _engine(engine) {
 	registerCmd("generaterendertable", WRAP_METHOD(Console, cmdGenerateRenderTable));
 	registerCmd("setpanoramafov", WRAP_METHOD(Console, cmdSetPanoramaFoV));
 	registerCmd("setpanoramascale", WRAP_METHOD(Console, cmdSetPanoramaScale));
+	registerCmd("warpbenchmark", WRAP_METHOD(Console, cmdWarpBenchmark));
 	registerCmd("location", WRAP_METHOD(Console, cmdLocation));
 	registerCmd("dumpfile", WRAP_METHOD(Console, cmdDumpFile));
 	registerCmd("dumpfiles", WRAP_METHOD(Console, cmdDumpFiles));
@@ -201,6 +202,66 @@ bool Console::cmdSetPanoramaScale(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdWarpBenchmark(int argc, const char **argv) {
+	if (argc > 2) {
+		debugPrintf("Use %s [frames] to measure the panorama and tilt warping speed\n", argv[0]);
+		return true;
+	}
+
+	int frames = (argc == 2) ? atoi(argv[1]) : 200;
+	if (frames <= 0) {
+		debugPrintf("Invalid number of frames\n");
+		return true;
+	}
+
+	static const struct {
+		const char *name;
+		uint16 width;
+		uint16 height;
+	} resolutions[] = {
+		{ "Zork Nemesis", ZNM_WORKING_WINDOW_WIDTH, ZNM_WORKING_WINDOW_HEIGHT },
+		{ "Zork Grand Inquisitor", ZGI_WORKING_WINDOW_WIDTH, ZGI_WORKING_WINDOW_HEIGHT }
+	};
+
+	const Graphics::PixelFormat formats[] = {
+		Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0),
+		Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0)
+	};
+
+	for (uint r = 0; r < ARRAYSIZE(resolutions); r++) {
+		RenderTable table(resolutions[r].width, resolutions[r].height);
+
+		for (uint f = 0; f < ARRAYSIZE(formats); f++) {
+			Graphics::Surface source, dest;
+			source.create(resolutions[r].width, resolutions[r].height, formats[f]);
+			dest.create(resolutions[r].width, resolutions[r].height, formats[f]);
+
+			for (int state = RenderTable::PANORAMA; state <= RenderTable::TILT; state++) {
+				for (int filter = 0; filter < 2; filter++) {
+					table.setRenderState((RenderTable::RenderState)state);
+					table.setBilinearFiltering(filter != 0);
+					table.generateRenderTable();
+
+					uint32 start = _engine->_system->getMillis();
+					for (int i = 0; i < frames; i++)
+						table.mutateImage(&dest, &source);
+					uint32 elapsed = MAX<uint32>(_engine->_system->getMillis() - start, 1);
+
+					debugPrintf("%s %dx%d %dbpp %s%s: %d frames/s\n", resolutions[r].name,
+						resolutions[r].width, resolutions[r].height, formats[f].bytesPerPixel * 8,
+						(state == RenderTable::PANORAMA) ? "panorama" : "tilt",
+						filter ? " (bilinear)" : "", frames * 1000 / elapsed);
+				}
+			}
+
+			source.free();
+			dest.free();
+		}
+	}
+
+	return true;
+}
+
 bool Console::cmdLocation(int argc, const char **argv) {
 	Location curLocation = _engine->getScriptManager()->getCurrentLocation();
 	Common::String scrFile = Common::String::format("%c%c%c%c.scr", curLocation.world, curLocation.room, curLocation.node, curLocation.view);
@@ -31,10 +31,17 @@ namespace ZVision {
 RenderTable::RenderTable(uint numColumns, uint numRows)
 	: _numRows(numRows),
 	  _numColumns(numColumns),
+	  _subPixelPositions(nullptr),
+	  _bilinearFiltering(false),
 	  _renderState(FLAT) {
-	assert(numRows != 0 && numColumns != 0);
+	assert(numRows > 1 && numColumns > 1);
 
 	_internalBuffer = new Common::Point[numRows * numColumns];
+	_sourceOffsets = new uint32[numRows * numColumns];
+
+	// Start out with an identity mapping, like _internalBuffer
+	for (uint32 i = 0; i < numRows * numColumns; ++i)
+		_sourceOffsets[i] = i;
 
 	memset(&_panoramaOptions, 0, sizeof(_panoramaOptions));
 	memset(&_tiltOptions, 0, sizeof(_tiltOptions));
@@ -42,6 +49,8 @@ RenderTable::RenderTable(uint numColumns, uint numRows)
 
 RenderTable::~RenderTable() {
 	delete[] _internalBuffer;
+	delete[] _sourceOffsets;
+	delete[] _subPixelPositions;
 }
 
 void RenderTable::setRenderState(RenderState newState) {
@@ -84,47 +93,150 @@ const Common::Point RenderTable::convertWarpedCoordToFlatCoord(const Common::Poi
 	return newPoint;
 }
 
-void RenderTable::mutateImage(uint16 *sourceBuffer, uint16 *destBuffer, uint32 destWidth, const Common::Rect &subRect) {
-	uint32 destOffset = 0;
+namespace {
+
+// Interpolates between two pixels that have been spread out so that every
+// color component has at least 5 unused bits above it
+inline uint32 lerpSpread(uint32 a, uint32 b, uint frac, uint32 mask) {
+	return ((a * (32 - frac) + b * frac) >> 5) & mask;
+}
+
+inline uint32 bilerpSpread(uint32 p00, uint32 p01, uint32 p10, uint32 p11, uint16 subPixel, uint32 mask) {
+	uint fracX = subPixel & 0xFF;
+	uint fracY = subPixel >> 8;
+	return lerpSpread(lerpSpread(p00, p01, fracX, mask), lerpSpread(p10, p11, fracX, mask), fracY, mask);
+}
 
+template<typename Pixel>
+void warpNearest(const Pixel *source, Pixel *dest, uint32 destPitch, const uint32 *offsets, uint32 tableWidth, const Common::Rect &subRect) {
 	for (int16 y = subRect.top; y < subRect.bottom; ++y) {
-		uint32 sourceOffset = y * _numColumns;
+		const uint32 *rowOffsets = offsets + y * tableWidth + subRect.left;
+		uint32 width = subRect.width();
 
-		for (int16 x = subRect.left; x < subRect.right; ++x) {
-			uint32 normalizedX = x - subRect.left;
-			uint32 index = sourceOffset + x;
+		for (uint32 x = 0; x < width; ++x)
+			dest[x] = source[rowOffsets[x]];
 
-			// RenderTable only stores offsets from the original coordinates
-			uint32 sourceYIndex = y + _internalBuffer[index].y;
-			uint32 sourceXIndex = x + _internalBuffer[index].x;
+		dest += destPitch;
+	}
+}
 
-			destBuffer[destOffset + normalizedX] = sourceBuffer[sourceYIndex * _numColumns + sourceXIndex];
+// 16bpp pixels are spread by moving the green component to the upper 16 bits,
+// which leaves enough room between red and blue in RGB555 and RGB565
+void warpBilinear16(const uint16 *source, uint16 *dest, uint32 destPitch, const uint32 *offsets, const uint16 *subPixels,
+                    uint32 tableWidth, const Common::Rect &subRect, const Graphics::PixelFormat &format) {
+	const uint32 greenMask = format.gMax() << format.gShift;
+	const uint32 lowMask = (format.rMax() << format.rShift) | (format.bMax() << format.bShift);
+	const uint32 mask = lowMask | (greenMask << 16);
+
+	for (int16 y = subRect.top; y < subRect.bottom; ++y) {
+		uint32 index = y * tableWidth + subRect.left;
+		uint32 width = subRect.width();
+
+		for (uint32 x = 0; x < width; ++x, ++index) {
+			const uint16 *p = source + offsets[index];
+			uint32 p00 = (p[0] & lowMask) | ((p[0] & greenMask) << 16);
+			uint32 p01 = (p[1] & lowMask) | ((p[1] & greenMask) << 16);
+			uint32 p10 = (p[tableWidth] & lowMask) | ((p[tableWidth] & greenMask) << 16);
+			uint32 p11 = (p[tableWidth + 1] & lowMask) | ((p[tableWidth + 1] & greenMask) << 16);
+
+			uint32 result = bilerpSpread(p00, p01, p10, p11, subPixels[index], mask);
+			dest[x] = (result & lowMask) | ((result >> 16) & greenMask);
 		}
 
-		destOffset += destWidth;
+		dest += destPitch;
 	}
 }
 
+// 32bpp pixels are split into two halves holding two components each
+void warpBilinear32(const uint32 *source, uint32 *dest, uint32 destPitch, const uint32 *offsets, const uint16 *subPixels,
+                    uint32 tableWidth, const Common::Rect &subRect) {
+	const uint32 mask = 0x00FF00FF;
+
+	for (int16 y = subRect.top; y < subRect.bottom; ++y) {
+		uint32 index = y * tableWidth + subRect.left;
+		uint32 width = subRect.width();
+
+		for (uint32 x = 0; x < width; ++x, ++index) {
+			const uint32 *p = source + offsets[index];
+			uint16 subPixel = subPixels[index];
+
+			uint32 low = bilerpSpread(p[0] & mask, p[1] & mask, p[tableWidth] & mask, p[tableWidth + 1] & mask, subPixel, mask);
+			uint32 high = bilerpSpread((p[0] >> 8) & mask, (p[1] >> 8) & mask, (p[tableWidth] >> 8) & mask, (p[tableWidth + 1] >> 8) & mask, subPixel, mask);
+			dest[x] = low | (high << 8);
+		}
+
+		dest += destPitch;
+	}
+}
+
+} // End of anonymous namespace
+
 void RenderTable::mutateImage(Graphics::Surface *dstBuf, Graphics::Surface *srcBuf) {
-	uint32 destOffset = 0;
+	assert(srcBuf->format == dstBuf->format);
+	assert(srcBuf->pitch == (int)_numColumns * srcBuf->format.bytesPerPixel);
+
+	Common::Rect rect(srcBuf->w, srcBuf->h);
+	uint32 destPitch = dstBuf->pitch / dstBuf->format.bytesPerPixel;
+
+	if (srcBuf->format.bytesPerPixel == 4) {
+		const uint32 *sourceBuffer = (const uint32 *)srcBuf->getPixels();
+		uint32 *destBuffer = (uint32 *)dstBuf->getPixels();
+
+		if (_bilinearFiltering)
+			warpBilinear32(sourceBuffer, destBuffer, destPitch, _sourceOffsets, _subPixelPositions, _numColumns, rect);
+		else
+			warpNearest<uint32>(sourceBuffer, destBuffer, destPitch, _sourceOffsets, _numColumns, rect);
+	} else {
+		assert(srcBuf->format.bytesPerPixel == 2);
+		const uint16 *sourceBuffer = (const uint16 *)srcBuf->getPixels();
+		uint16 *destBuffer = (uint16 *)dstBuf->getPixels();
+
+		if (_bilinearFiltering)
+			warpBilinear16(sourceBuffer, destBuffer, destPitch, _sourceOffsets, _subPixelPositions, _numColumns, rect, srcBuf->format);
+		else
+			warpNearest<uint16>(sourceBuffer, destBuffer, destPitch, _sourceOffsets, _numColumns, rect);
+	}
+}
 
-	uint16 *sourceBuffer = (uint16 *)srcBuf->getPixels();
-	uint16 *destBuffer = (uint16 *)dstBuf->getPixels();
+void RenderTable::setBilinearFiltering(bool enable) {
+	if (_bilinearFiltering == enable)
+		return;
 
-	for (int16 y = 0; y < srcBuf->h; ++y) {
-		uint32 sourceOffset = y * _numColumns;
+	_bilinearFiltering = enable;
 
-		for (int16 x = 0; x < srcBuf->w; ++x) {
-			uint32 index = sourceOffset + x;
+	if (enable) {
+		_subPixelPositions = new uint16[_numRows * _numColumns]();
+	} else {
+		delete[] _subPixelPositions;
+		_subPixelPositions = nullptr;
+	}
+
+	generateRenderTable();
+}
 
-			// RenderTable only stores offsets from the original coordinates
-			uint32 sourceYIndex = y + _internalBuffer[index].y;
-			uint32 sourceXIndex = x + _internalBuffer[index].x;
+void RenderTable::setSourcePosition(uint x, uint y, float sourceX, float sourceY) {
+	uint32 index = y * _numColumns + x;
+	int32 xInCylinderCoords = int32(floor(sourceX));
+	int32 yInCylinderCoords = int32(floor(sourceY));
 
-			destBuffer[destOffset] = sourceBuffer[sourceYIndex * _numColumns + sourceXIndex];
-			destOffset++;
-		}
+	// Only store the (x,y) offsets instead of the absolute positions
+	_internalBuffer[index].x = xInCylinderCoords - x;
+	_internalBuffer[index].y = yInCylinderCoords - y;
+
+	if (!_bilinearFiltering) {
+		_sourceOffsets[index] = yInCylinderCoords * _numColumns + xInCylinderCoords;
+		return;
 	}
+
+	// Keep the sampled 2x2 block inside the image. Positions on the last row
+	// or column get the full weight of the second row or column of the block.
+	int32 blockX = CLIP<int32>(xInCylinderCoords, 0, _numColumns - 2);
+	int32 blockY = CLIP<int32>(yInCylinderCoords, 0, _numRows - 2);
+	int32 subPixelX = CLIP<int32>(int32((sourceX - blockX) * 32.0f), 0, 32);
+	int32 subPixelY = CLIP<int32>(int32((sourceY - blockY) * 32.0f), 0, 32);
+
+	_sourceOffsets[index] = blockY * _numColumns + blockX;
+	_subPixelPositions[index] = subPixelX | (subPixelY << 8);
 }
 
 void RenderTable::generateRenderTable() {
@@ -144,14 +256,6 @@ void RenderTable::generateRenderTable() {
 }
 
 void RenderTable::generatePanoramaLookupTable() {
-	for (uint y = 0; y < _numRows; y++) {
-		for (uint x = 0; x < _numColumns; x++) {
-			uint32 index = y * _numColumns + x;
-			_internalBuffer[index].x = 0;
-			_internalBuffer[index].y = 0;
-		}
-	}
-
 	float halfWidth = (float)_numColumns / 2.0f;
 	float halfHeight = (float)_numRows / 2.0f;
 
@@ -165,20 +269,16 @@ void RenderTable::generatePanoramaLookupTable() {
 
 		// To get x in cylinder coordinates, we just need to calculate the arc length
 		// We also scale it by _panoramaOptions.linearScale
-		int32 xInCylinderCoords = int32(floor((cylinderRadius * _panoramaOptions.linearScale * alpha) + halfWidth));
+		float xInCylinderCoords = (cylinderRadius * _panoramaOptions.linearScale * alpha) + halfWidth;
 
 		float cosAlpha = cos(alpha);
 
 		for (uint y = 0; y < _numRows; ++y) {
 			// To calculate y in cylinder coordinates, we can do similar triangles comparison,
 			// comparing the triangle from the center to the screen and from the center to the edge of the cylinder
-			int32 yInCylinderCoords = int32(floor(halfHeight + ((float)y - halfHeight) * cosAlpha));
+			float yInCylinderCoords = halfHeight + ((float)y - halfHeight) * cosAlpha;
 
-			uint32 index = y * _numColumns + x;
-
-			// Only store the (x,y) offsets instead of the absolute positions
-			_internalBuffer[index].x = xInCylinderCoords - x;
-			_internalBuffer[index].y = yInCylinderCoords - y;
+			setSourcePosition(x, y, xInCylinderCoords, yInCylinderCoords);
 		}
 	}
 }
@@ -199,21 +299,16 @@ void RenderTable::generateTiltLookupTable() {
 
 		// To get y in cylinder coordinates, we just need to calculate the arc length
 		// We also scale it by _tiltOptions.linearScale
-		int32 yInCylinderCoords = int32(floor((cylinderRadius * _tiltOptions.linearScale * alpha) + halfHeight));
+		float yInCylinderCoords = (cylinderRadius * _tiltOptions.linearScale * alpha) + halfHeight;
 
 		float cosAlpha = cos(alpha);
-		uint32 columnIndex = y * _numColumns;
 
 		for (uint x = 0; x < _numColumns; ++x) {
 			// To calculate x in cylinder coordinates, we can do similar triangles comparison,
 			// comparing the triangle from the center to the screen and from the center to the edge of the cylinder
-			int32 xInCylinderCoords = int32(floor(halfWidth + ((float)x - halfWidth) * cosAlpha));
-
-			uint32 index = columnIndex + x;
+			float xInCylinderCoords = halfWidth + ((float)x - halfWidth) * cosAlpha;
 
-			// Only store the (x,y) offsets instead of the absolute positions
-			_internalBuffer[index].x = xInCylinderCoords - x;
-			_internalBuffer[index].y = yInCylinderCoords - y;
+			setSourcePosition(x, y, xInCylinderCoords, yInCylinderCoords);
 		}
 	}
 }
@@ -43,6 +43,13 @@ public:
 private:
 	uint _numColumns, _numRows;
 	Common::Point *_internalBuffer;
+	// The absolute index of the source pixel of every destination pixel. With
+	// bilinear filtering, this is the top left pixel of the 2x2 block sampled.
+	uint32 *_sourceOffsets;
+	// The position within the sampled 2x2 block, in 1/32 pixels, with x in the
+	// low byte and y in the high byte. Only allocated for bilinear filtering.
+	uint16 *_subPixelPositions;
+	bool _bilinearFiltering;
 	RenderState _renderState;
 
 	struct {
@@ -68,10 +75,14 @@ public:
 
 	const Common::Point convertWarpedCoordToFlatCoord(const Common::Point &point);
 
-	void mutateImage(uint16 *sourceBuffer, uint16 *destBuffer, uint32 destWidth, const Common::Rect &subRect);
 	void mutateImage(Graphics::Surface *dstBuf, Graphics::Surface *srcBuf);
 	void generateRenderTable();
 
+	void setBilinearFiltering(bool enable);
+	bool getBilinearFiltering() {
+		return _bilinearFiltering;
+	}
+
 	void setPanoramaFoV(float fov);
 	void setPanoramaScale(float scale);
 	void setPanoramaReverse(bool reverse);
@@ -90,6 +101,7 @@ public:
 private:
 	void generatePanoramaLookupTable();
 	void generateTiltLookupTable();
+	void setSourcePosition(uint x, uint y, float sourceX, float sourceY);
 };
 
 } // End of namespace ZVision
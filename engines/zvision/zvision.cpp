@@ -247,6 +247,7 @@ void ZVision::initialize() {
 	// Create debugger console. It requires GFX to be initialized
 	setDebugger(new Console(this));
 	_doubleFPS = ConfMan.getBool("doublefps");
+	_renderManager->getRenderTable()->setBilinearFiltering(ConfMan.getBool("smoothpanorama"));
 
 	// Initialize FPS timer callback
 	getTimerManager()->installTimerProc(&fpsTimerCallback, 1000000, this, "zvisionFPS");
@@ -22,6 +22,7 @@
 
 #include "common/algorithm.h"
 #include "common/endian.h"
+#include "common/memtrack.h"
 #include "common/util.h"
 #include "common/rect.h"
 #include "common/textconsole.h"
@@ -73,10 +74,12 @@ void Surface::create(uint16 width, uint16 height, const PixelFormat &f) {
 	if (width && height) {
 		pixels = calloc(width * height, format.bytesPerPixel);
 		assert(pixels);
+		Common::MemoryTracker::trackAlloc(pixels, width * height * format.bytesPerPixel);
 	}
 }
 
 void Surface::free() {
+	Common::MemoryTracker::trackFree(pixels);
 	::free(pixels);
 	pixels = 0;
 	w = h = pitch = 0;
@@ -20,10 +20,16 @@
  *
  */
 
+#include "base/version.h"
 #include "common/system.h"
+#include "common/cachefile.h"
 #include "common/config-manager.h"
 #include "common/file.h"
 #include "common/fs.h"
+#include "common/hash-str.h"
+#include "common/md5.h"
+#include "common/memstream.h"
+#include "common/substream.h"
 #include "common/unzip.h"
 #include "common/tokenizer.h"
 #include "common/translation.h"
@@ -721,6 +727,8 @@ void ThemeEngine::loadTheme(const Common::String &themeId) {
 
 	debug(6, "Loading theme %s", themeId.c_str());
 
+	const uint32 startTime = g_system->getMillis();
+
 	if (themeId == "builtin") {
 		_themeOk = loadDefaultXML();
 	} else {
@@ -740,6 +748,8 @@ void ThemeEngine::loadTheme(const Common::String &themeId) {
 			_widgets[i]->calcBackgroundOffset();
 		}
 	}
+
+	debug(2, "Loaded theme '%s' in %d ms", themeId.c_str(), g_system->getMillis() - startTime);
 }
 
 void ThemeEngine::unloadTheme() {
@@ -784,18 +794,14 @@ bool ThemeEngine::loadDefaultXML() {
 	for (int i = 0; i < ARRAYSIZE(defaultXML); i++)
 		strncat((char *)tmpXML, defaultXML[i], xmllen);
 
-	if (!_parser->loadBuffer(tmpXML, xmllen)) {
-		free(tmpXML);
-
-		return false;
-	}
-
 	_themeName = "ScummVM Classic Theme (Builtin Version)";
 	_themeId = "builtin";
 	_themeFile.clear();
 
-	bool result = _parser->parse();
-	_parser->close();
+	// The builtin theme only changes with the executable
+	Common::MemoryReadStream stream(tmpXML, xmllen);
+	bool result = parseThemeStream(&stream, "builtin",
+		Common::String::format("builtin %s %s", gScummVMFullVersion, gScummVMBuildDate));
 
 	free(tmpXML);
 
@@ -835,25 +841,35 @@ bool ThemeEngine::loadThemeXML(const Common::String &themeId) {
 		return false;
 	}
 
+	Common::FSNode themeNode(_themeFile);
+
 	//
 	// Loop over all STX files, load and parse them
 	//
 	for (Common::ArchiveMemberList::iterator i = members.begin(); i != members.end(); ++i) {
 		assert((*i)->getName().hasSuffix(".stx"));
 
-		if (_parser->loadStream((*i)->createReadStream()) == false) {
+		Common::SeekableReadStream *stream = (*i)->createReadStream();
+		if (!stream) {
 			warning("Failed to load STX file '%s'", (*i)->getDisplayName().c_str());
-			_parser->close();
 			return false;
 		}
 
-		if (_parser->parse() == false) {
+		// The theme cache key of an STX file is its location and the time
+		// it, or the zip file holding it, was last modified
+		const uint32 modificationTime = themeNode.isDirectory() ?
+			themeNode.getChild((*i)->getName()).getModificationTime() : themeNode.getModificationTime();
+		Common::String sourceKey;
+		if (modificationTime)
+			sourceKey = Common::String::format("%s/%s %u", _themeFile.c_str(), (*i)->getName().c_str(), modificationTime);
+
+		bool result = parseThemeStream(stream, (*i)->getDisplayName(), sourceKey);
+		delete stream;
+
+		if (!result) {
 			warning("Failed to parse STX file '%s'", (*i)->getDisplayName().c_str());
-			_parser->close();
 			return false;
 		}
-
-		_parser->close();
 	}
 
 	assert(!_themeName.empty());
@@ -862,6 +878,108 @@ bool ThemeEngine::loadThemeXML(const Common::String &themeId) {
 
 
 
+Common::SeekableReadStream *ThemeEngine::readCompiledTheme(Common::SeekableReadStream *entry) {
+	uint8 storedDigest[16];
+	uint8 digest[16];
+
+	if (entry->readUint32BE() != MKTAG('S', 'T', 'C', 'H'))
+		return nullptr;
+
+	const uint32 size = entry->readUint32LE();
+	if (entry->read(storedDigest, 16) != 16 || entry->err() || entry->size() - entry->pos() != (int32)size)
+		return nullptr;
+
+	byte *data = (byte *)malloc(size);
+	if (!data || entry->read(data, size) != size) {
+		free(data);
+		return nullptr;
+	}
+
+	Common::MemoryReadStream *compiled = new Common::MemoryReadStream(data, size, DisposeAfterUse::YES);
+	Common::computeStreamMD5(*compiled, digest);
+	if (memcmp(digest, storedDigest, 16)) {
+		delete compiled;
+		return nullptr;
+	}
+
+	compiled->seek(0);
+	return compiled;
+}
+
+bool ThemeEngine::parseThemeStream(Common::SeekableReadStream *stream, const Common::String &name, const Common::String &sourceKey) {
+	const uint32 startTime = g_system->getMillis();
+
+	// The entry is found through where the STX file came from, and when it
+	// was last changed. Without that, hash the contents instead. Either way,
+	// stale entries are never picked up; they just linger in the cache
+	// directory.
+	Common::String cacheName;
+	if (!sourceKey.empty()) {
+		cacheName = Common::String::format("theme-%08x-%d-v%d.stc",
+			Common::hashit(sourceKey), stream->size(), Common::XMLParser::kCompiledVersion);
+	} else {
+		cacheName = Common::String::format("theme-%s-v%d.stc",
+			Common::computeStreamMD5AsString(*stream).c_str(), Common::XMLParser::kCompiledVersion);
+		stream->seek(0, SEEK_SET);
+	}
+
+	Common::SeekableReadStream *entry = Common::openCacheFile(cacheName);
+	if (entry) {
+		// The whole entry is checked before anything is replayed, so a
+		// damaged one does not leave the theme half-loaded
+		Common::SeekableReadStream *compiled = readCompiledTheme(entry);
+		delete entry;
+
+		bool result = compiled && _parser->parseCompiled(compiled);
+		delete compiled;
+
+		if (result) {
+			debug(3, "Replayed '%s' from the theme cache in %d ms", name.c_str(), g_system->getMillis() - startTime);
+			return true;
+		}
+
+		// Parsing the STX file resets the parser and replaces whatever a
+		// failed replay registered
+		warning("Damaged theme cache entry '%s' for '%s'", cacheName.c_str(), name.c_str());
+		Common::removeCacheFile(cacheName);
+		_parser->close();
+	}
+
+	Common::MemoryWriteStreamDynamic recording(DisposeAfterUse::YES);
+	_parser->setCompileStream(&recording);
+
+	// The parser takes ownership of the streams it loads
+	_parser->loadStream(new Common::SeekableSubReadStream(stream, 0, stream->size()));
+	bool result = _parser->parse();
+	_parser->close();
+	_parser->setCompileStream(nullptr);
+
+	debug(3, "Parsed '%s' in %d ms", name.c_str(), g_system->getMillis() - startTime);
+
+	if (!result)
+		return false;
+
+	Common::WriteStream *out = Common::createCacheFile(cacheName);
+	if (out) {
+		uint8 digest[16];
+		Common::MemoryReadStream recorded(recording.getData(), recording.size());
+		Common::computeStreamMD5(recorded, digest);
+
+		out->writeUint32BE(MKTAG('S', 'T', 'C', 'H'));
+		out->writeUint32LE(recording.size());
+		out->write(digest, 16);
+		out->write(recording.getData(), recording.size());
+		out->finalize();
+		bool failed = out->err();
+		delete out;
+
+		if (failed)
+			Common::removeCacheFile(cacheName);
+	}
+
+	return true;
+}
+
 /**********************************************************
  * Draw Date descriptors drawing functions
  *********************************************************/
@@ -41,6 +41,10 @@
 
 class OSystem;
 
+namespace Common {
+class SeekableReadStream;
+}
+
 namespace Graphics {
 struct DrawStep;
 class VectorRenderer;
@@ -630,6 +634,26 @@ protected:
 	 */
 	bool loadDefaultXML();
 
+	/**
+	 * Parses one STX file of the theme being loaded. The parsed keys are
+	 * cached in compiled form, and replayed from that cache on later loads.
+	 *
+	 * @param stream STX file contents, owned by the caller.
+	 * @param name Name of the STX file, for diagnostics.
+	 * @param sourceKey Identifies the STX file and its version, e.g. by
+	 *                  its path and modification time. If empty, the
+	 *                  cache entry is keyed by the MD5 of the contents.
+	 * @returns true if the file was successfully parsed.
+	 */
+	bool parseThemeStream(Common::SeekableReadStream *stream, const Common::String &name, const Common::String &sourceKey);
+
+	/**
+	 * Reads a theme cache entry and checks its length and checksum.
+	 *
+	 * @returns the compiled keys, or 0 if the entry is damaged.
+	 */
+	Common::SeekableReadStream *readCompiledTheme(Common::SeekableReadStream *entry);
+
 	/**
 	 * Unloads the currently loaded theme so another one can
 	 * be loaded.
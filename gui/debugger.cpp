@@ -25,7 +25,11 @@
 
 #include "common/debug.h"
 #include "common/debug-channels.h"
+#include "common/file.h"
+#include "common/memtrack.h"
+#include "common/profiler.h"
 #include "common/system.h"
+#include "common/timer.h"
 
 #ifndef DISABLE_MD5
 #include "common/md5.h"
@@ -36,6 +40,8 @@
 
 #include "engines/engine.h"
 
+#include "audio/fmopl.h"
+
 #include "gui/debugger.h"
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 	#include "gui/console.h"
@@ -73,6 +79,13 @@ Debugger::Debugger() {
 	registerCmd("md5mac",			WRAP_METHOD(Debugger, cmdMd5Mac));
 #endif
 
+	registerCmd("opl_benchmark",	WRAP_METHOD(Debugger, cmdOplBenchmark));
+	registerCmd("timers",			WRAP_METHOD(Debugger, cmdTimers));
+	registerCmd("memory",			WRAP_METHOD(Debugger, cmdMemory));
+#ifdef USE_ZONE_PROFILER
+	registerCmd("profiler",			WRAP_METHOD(Debugger, cmdProfiler));
+#endif
+
 	registerCmd("debuglevel",		WRAP_METHOD(Debugger, cmdDebugLevel));
 	registerCmd("debugflag_list",		WRAP_METHOD(Debugger, cmdDebugFlagsList));
 	registerCmd("debugflag_enable",	WRAP_METHOD(Debugger, cmdDebugFlagEnable));
@@ -707,6 +720,139 @@ bool Debugger::cmdMd5Mac(int argc, const char **argv) {
 }
 #endif
 
+bool Debugger::cmdOplBenchmark(int argc, const char **argv) {
+	static const char *const typeNames[] = { "OPL2", "Dual OPL2", "OPL3" };
+
+	uint seconds = (argc > 1) ? atoi(argv[1]) : 10;
+	if (seconds == 0) {
+		debugPrintf("Usage: %s [seconds]\n", argv[0]);
+		return true;
+	}
+
+	debugPrintf("Rendering %d seconds of music per OPL emulator...\n", seconds);
+
+	Common::Array<OPL::Config::BenchmarkResult> results = OPL::Config::benchmark(seconds);
+	for (uint i = 0; i < results.size(); ++i) {
+		const OPL::Config::BenchmarkResult &result = results[i];
+		const OPL::Config::EmulatorDescription *desc = OPL::Config::findDriver(result.driver);
+		const uint32 millis = MAX<uint32>(result.millis, 1);
+
+		debugPrintf("%-6s %-9s %9d samples/s (%.1fx real time)\n", desc->name, typeNames[result.type],
+			(uint32)((uint64)result.samples * 1000 / millis), (float)seconds * 1000 / millis);
+	}
+
+	return true;
+}
+
+bool Debugger::cmdTimers(int argc, const char **argv) {
+	Common::TimerManager *timerManager = g_system->getTimerManager();
+
+	if (argc == 2 && !strcmp(argv[1], "on")) {
+		timerManager->setProfiling(true);
+		debugPrintf("Timer profiling enabled\n");
+		return true;
+	} else if (argc == 2 && !strcmp(argv[1], "off")) {
+		timerManager->setProfiling(false);
+		debugPrintf("Timer profiling disabled\n");
+		return true;
+	} else if (argc != 1) {
+		debugPrintf("Usage: %s [on|off]\n", argv[0]);
+		return true;
+	}
+
+	Common::Array<Common::TimerManager::CallbackStats> stats;
+	if (!timerManager->getCallbackStats(stats)) {
+		debugPrintf("Timer profiling is not supported by this backend\n");
+		return true;
+	}
+
+	debugPrintf("%-24s %9s %8s %9s %7s %9s %7s\n", "Timer", "Interval", "Calls", "Avg ms", "Max ms", "Avg late", "Max late");
+	for (uint i = 0; i < stats.size(); ++i) {
+		const Common::TimerManager::CallbackStats &entry = stats[i];
+		const uint32 calls = MAX<uint32>(entry.calls, 1);
+		debugPrintf("%-24s %9d %8d %9.3f %7.3f %9.3f %7.3f\n", entry.id.c_str(), entry.interval, entry.calls,
+		            (double)entry.totalTime / calls / 1000, entry.maxTime / 1000.0,
+		            (double)entry.totalLateness / calls / 1000, entry.maxLateness / 1000.0);
+	}
+	debugPrintf("Intervals are in microseconds. Use '%s on' to start collecting statistics.\n", argv[0]);
+
+	return true;
+}
+
+bool Debugger::cmdMemory(int argc, const char **argv) {
+	if (argc == 2 && !strcmp(argv[1], "on")) {
+		Common::MemoryTracker::setEnabled(true);
+		debugPrintf("Memory tracking enabled\n");
+		return true;
+	} else if (argc == 2 && !strcmp(argv[1], "off")) {
+		Common::MemoryTracker::setEnabled(false);
+		debugPrintf("Memory tracking disabled\n");
+		return true;
+	} else if (argc == 2 && !strcmp(argv[1], "reset")) {
+		Common::MemoryTracker::resetPeaks();
+		debugPrintf("Memory peaks reset\n");
+		return true;
+	} else if (argc == 3 && !strcmp(argv[1], "log")) {
+		Common::MemoryTracker::setLogInterval(atoi(argv[2]));
+		return true;
+	} else if (argc != 1) {
+		debugPrintf("Usage: %s [on|off|reset|log <seconds>]\n", argv[0]);
+		return true;
+	}
+
+	if (!Common::MemoryTracker::isEnabled()) {
+		debugPrintf("Memory tracking is disabled. Use '%s on' to start tracking.\n", argv[0]);
+		return true;
+	}
+
+	Common::Array<Common::MemoryTracker::TagStats> stats;
+	Common::MemoryTracker::getStats(stats);
+
+	size_t liveBytes = 0;
+	debugPrintf("%-24s %10s %10s %8s %10s\n", "Tag", "Live KB", "Peak KB", "Blocks", "Allocs");
+	for (uint i = 0; i < stats.size(); ++i) {
+		const Common::MemoryTracker::TagStats &entry = stats[i];
+		debugPrintf("%-24s %10d %10d %8d %10d\n", entry.name, (int)(entry.liveBytes / 1024),
+		            (int)(entry.peakBytes / 1024), entry.liveBlocks, entry.allocations);
+		liveBytes += entry.liveBytes;
+	}
+	debugPrintf("%d KB live in total\n", (int)(liveBytes / 1024));
+
+	return true;
+}
+
+#ifdef USE_ZONE_PROFILER
+bool Debugger::cmdProfiler(int argc, const char **argv) {
+	if (argc == 2 && !strcmp(argv[1], "start")) {
+		Common::Profiler::startCapture();
+		debugPrintf("Profiler capture started\n");
+	} else if (argc == 2 && !strcmp(argv[1], "stop")) {
+		Common::Profiler::stopCapture();
+		debugPrintf("Profiler capture stopped, %d events recorded\n", Common::Profiler::getEventCount());
+	} else if ((argc == 2 || argc == 3) && !strcmp(argv[1], "save")) {
+		const char *fileName = argc == 3 ? argv[2] : "scummvm-trace.json";
+		Common::Profiler::stopCapture();
+
+		Common::DumpFile file;
+		uint32 eventCount;
+		if (!file.open(fileName, true) || !Common::Profiler::exportChromeTrace(file, &eventCount)) {
+			debugPrintf("Could not write the trace to '%s'\n", fileName);
+		} else {
+			file.finalize();
+			debugPrintf("Wrote %u events to '%s'\n", eventCount, fileName);
+		}
+	} else if (argc == 1) {
+		debugPrintf("The profiler is %s, %d events recorded\n",
+		            Common::Profiler::isCapturing() ? "capturing" : "stopped", Common::Profiler::getEventCount());
+		debugPrintf("Usage: %s [start|stop|save [file]]\n", argv[0]);
+	} else {
+		debugPrintf("Usage: %s [start|stop|save [file]]\n", argv[0]);
+	}
+
+	return true;
+}
+#endif
+
 bool Debugger::cmdDebugLevel(int argc, const char **argv) {
 	if (argc == 1) { // print level
 		debugPrintf("Debugging is currently %s (set at level %d)\n", (gDebugLevel >= 0) ? "enabled" : "disabled", gDebugLevel);
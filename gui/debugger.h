@@ -235,6 +235,12 @@ protected:
 	bool cmdMd5Mac(int argc, const char **argv);
 #endif
 	bool cmdDebugLevel(int argc, const char **argv);
+	bool cmdOplBenchmark(int argc, const char **argv);
+	bool cmdTimers(int argc, const char **argv);
+	bool cmdMemory(int argc, const char **argv);
+#ifdef USE_ZONE_PROFILER
+	bool cmdProfiler(int argc, const char **argv);
+#endif
 	bool cmdDebugFlagsList(int argc, const char **argv);
 	bool cmdDebugFlagEnable(int argc, const char **argv);
 	bool cmdDebugFlagDisable(int argc, const char **argv);
@@ -18,6 +18,7 @@ MODULE_OBJS := \
 	object.o \
 	options.o \
 	predictivedialog.o \
+	saveindex.o \
 	saveload.o \
 	saveload-dialog.o \
 	themebrowser.o \
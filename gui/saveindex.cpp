@@ -0,0 +1,296 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "gui/saveindex.h"
+#include "engines/metaengine.h"
+
+#include "common/cachefile.h"
+#include "common/memstream.h"
+#include "common/savefile.h"
+#include "common/system.h"
+
+#include "graphics/surface.h"
+#include "graphics/thumbnail.h"
+
+namespace GUI {
+
+enum {
+	kSaveIndexVersion = 2
+};
+
+enum {
+	kEntryDeletable = 1 << 0,
+	kEntryWriteProtected = 1 << 1,
+	kEntryHasThumbnail = 1 << 2
+};
+
+static Common::String getIndexName(const Common::String &target) {
+	return "saves-" + target + ".idx";
+}
+
+static void writeIndexString(Common::WriteStream &out, const Common::String &str) {
+	out.writeUint16LE(str.size());
+	out.writeString(str);
+}
+
+static Common::String readIndexString(Common::SeekableReadStream &in) {
+	const uint16 size = in.readUint16LE();
+	if (size > in.size() - in.pos())
+		return Common::String();
+
+	char *buffer = new char[size];
+	in.read(buffer, size);
+	Common::String str(buffer, size);
+	delete[] buffer;
+	return str;
+}
+
+SaveStateIndex::SaveStateIndex() : _metaEngine(nullptr), _stream(nullptr), _modified(false) {
+}
+
+SaveStateIndex::~SaveStateIndex() {
+	clear();
+}
+
+void SaveStateIndex::load(const MetaEngine *metaEngine, const Common::String &target) {
+	clear();
+	_metaEngine = metaEngine;
+	_target = target;
+
+	_stream = Common::openCacheFile(getIndexName(target));
+	if (!_stream)
+		return;
+
+	if (_stream->readUint32BE() != MKTAG('S', 'V', 'I', 'X') || _stream->readUint32LE() != kSaveIndexVersion) {
+		delete _stream;
+		_stream = nullptr;
+		return;
+	}
+
+	const uint32 count = _stream->readUint32LE();
+	bool valid = true;
+	for (uint32 n = 0; n < count && valid; ++n) {
+		Entry entry;
+		const int slot = _stream->readSint32LE();
+		entry.saveSize = _stream->readUint32LE();
+		entry.modificationTime = _stream->readUint32LE();
+
+		SaveStateDescriptor &desc = entry.desc;
+		desc._slot = slot;
+		desc._description = readIndexString(*_stream);
+		desc._saveDate = readIndexString(*_stream);
+		desc._saveTime = readIndexString(*_stream);
+		desc._playTime = readIndexString(*_stream);
+		desc._playTimeMSecs = _stream->readUint32LE();
+		desc._saveType = (SaveStateDescriptor::SaveType)_stream->readByte();
+
+		const byte flags = _stream->readByte();
+		desc._isDeletable = (flags & kEntryDeletable) != 0;
+		desc._isWriteProtected = (flags & kEntryWriteProtected) != 0;
+
+		// Thumbnails are only decoded once a save is looked up, see find()
+		entry.thumbnailSize = _stream->readUint32LE();
+		entry.thumbnailOffset = -1;
+		if (flags & kEntryHasThumbnail) {
+			entry.thumbnailOffset = _stream->pos();
+			valid = entry.thumbnailSize <= (uint32)(_stream->size() - _stream->pos()) &&
+			        _stream->seek(entry.thumbnailSize, SEEK_CUR);
+		}
+
+		valid = valid && !_stream->err() && !_stream->eos();
+		_entries.setVal(slot, entry);
+	}
+
+	// A damaged index is thrown away as a whole
+	if (!valid)
+		_entries.clear();
+}
+
+void SaveStateIndex::save() {
+	if (!_modified)
+		return;
+	_modified = false;
+
+	Common::WriteStream *out = Common::createCacheFile(getIndexName(_target));
+	if (!out)
+		return;
+
+	out->writeUint32BE(MKTAG('S', 'V', 'I', 'X'));
+	out->writeUint32LE(kSaveIndexVersion);
+	out->writeUint32LE(_entries.size());
+
+	Common::HashMap<int, int32> thumbnailOffsets;
+	for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+		Entry &entry = i->_value;
+		const SaveStateDescriptor &desc = entry.desc;
+		out->writeSint32LE(i->_key);
+		out->writeUint32LE(entry.saveSize);
+		out->writeUint32LE(entry.modificationTime);
+		writeIndexString(*out, desc._description);
+		writeIndexString(*out, desc._saveDate);
+		writeIndexString(*out, desc._saveTime);
+		writeIndexString(*out, desc._playTime);
+		out->writeUint32LE(desc._playTimeMSecs);
+		out->writeByte(desc._saveType);
+
+		// Thumbnails which were never decoded are copied as they are
+		Common::MemoryWriteStreamDynamic thumbnail(DisposeAfterUse::YES);
+		if (desc.getThumbnail()) {
+			Graphics::saveThumbnail(thumbnail, *desc.getThumbnail());
+		} else if (entry.thumbnailOffset >= 0) {
+			byte *data = (byte *)malloc(entry.thumbnailSize);
+			_stream->seek(entry.thumbnailOffset);
+			if (_stream->read(data, entry.thumbnailSize) == entry.thumbnailSize)
+				thumbnail.write(data, entry.thumbnailSize);
+			free(data);
+		}
+
+		out->writeByte((desc._isDeletable ? kEntryDeletable : 0) |
+		               (desc._isWriteProtected ? kEntryWriteProtected : 0) |
+		               (thumbnail.size() ? kEntryHasThumbnail : 0));
+		out->writeUint32LE(thumbnail.size());
+		if (thumbnail.size()) {
+			thumbnailOffsets.setVal(i->_key, out->pos());
+			out->write(thumbnail.getData(), thumbnail.size());
+		}
+	}
+
+	// The old index may be overwritten in place, so it has to be closed
+	// before the new one is finalized
+	delete _stream;
+	_stream = nullptr;
+
+	out->finalize();
+	const bool failed = out->err();
+	delete out;
+
+	if (!failed)
+		_stream = Common::openCacheFile(getIndexName(_target));
+	if (!_stream) {
+		_entries.clear();
+		return;
+	}
+
+	// Keep looking up thumbnails in the new index
+	for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+		Entry &entry = i->_value;
+		entry.desc.setThumbnail(nullptr);
+		entry.thumbnailOffset = thumbnailOffsets.getVal(i->_key, -1);
+	}
+}
+
+void SaveStateIndex::clear() {
+	_metaEngine = nullptr;
+	_target.clear();
+	_entries.clear();
+	delete _stream;
+	_stream = nullptr;
+	_modified = false;
+}
+
+bool SaveStateIndex::find(const SaveStateDescriptor &listed, SaveStateDescriptor &desc) const {
+	EntryMap::const_iterator i = _entries.find(listed.getSaveSlot());
+	if (i == _entries.end() || i->_value.desc.getDescription() != listed.getDescription())
+		return false;
+
+	// Saves written behind the back of the index, e.g. from an engine's own
+	// menus, are told apart by their modification time. Backends which do
+	// not know it only leave the size to compare.
+	const Entry &entry = i->_value;
+	if (entry.modificationTime) {
+		if (getModificationTime(listed.getSaveSlot()) != entry.modificationTime)
+			return false;
+	} else if (getSaveSize(listed.getSaveSlot()) != (int32)entry.saveSize) {
+		return false;
+	}
+
+	desc = entry.desc;
+	if (!desc.getThumbnail() && entry.thumbnailOffset >= 0) {
+		Graphics::Surface *thumbnail = nullptr;
+		if (!_stream->seek(entry.thumbnailOffset) || !Graphics::loadThumbnail(*_stream, thumbnail))
+			return false;
+		desc.setThumbnail(thumbnail);
+	}
+
+	return true;
+}
+
+void SaveStateIndex::store(const SaveStateDescriptor &desc) {
+	if (desc.getSaveSlot() < 0 || desc.getLocked())
+		return;
+
+	const Graphics::Surface *thumbnail = desc.getThumbnail();
+	if (thumbnail && thumbnail->format.bytesPerPixel != 2 && thumbnail->format.bytesPerPixel != 4)
+		return;
+
+	Entry entry;
+	entry.modificationTime = getModificationTime(desc.getSaveSlot());
+	entry.saveSize = 0;
+	if (!entry.modificationTime) {
+		const int32 saveSize = getSaveSize(desc.getSaveSlot());
+		if (saveSize < 0)
+			return;
+		entry.saveSize = saveSize;
+	}
+
+	entry.desc = desc;
+	entry.thumbnailOffset = -1;
+	entry.thumbnailSize = 0;
+	_entries.setVal(desc.getSaveSlot(), entry);
+	_modified = true;
+}
+
+void SaveStateIndex::removeMissing(const SaveStateList &saveList) {
+	Common::HashMap<int, bool> listed;
+	for (uint i = 0; i < saveList.size(); ++i)
+		listed.setVal(saveList[i].getSaveSlot(), true);
+
+	for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+		if (!listed.contains(i->_key)) {
+			_entries.erase(i);
+			_modified = true;
+		}
+	}
+}
+
+uint32 SaveStateIndex::getModificationTime(int slot) const {
+	if (!_metaEngine)
+		return 0;
+
+	// Only saves at the default location can be checked
+	return g_system->getSavefileManager()->getModificationTime(_metaEngine->getSavegameFile(slot, _target.c_str()));
+}
+
+int32 SaveStateIndex::getSaveSize(int slot) const {
+	if (!_metaEngine)
+		return -1;
+
+	Common::InSaveFile *in = g_system->getSavefileManager()->openForLoading(_metaEngine->getSavegameFile(slot, _target.c_str()));
+	if (!in)
+		return -1;
+
+	const int32 size = in->size();
+	delete in;
+	return size;
+}
+
+} // End of namespace GUI
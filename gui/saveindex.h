@@ -0,0 +1,116 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GUI_SAVEINDEX_H
+#define GUI_SAVEINDEX_H
+
+#include "common/hashmap.h"
+#include "common/noncopyable.h"
+#include "common/str.h"
+#include "common/stream.h"
+
+#include "engines/savestate.h"
+
+class MetaEngine;
+
+namespace GUI {
+
+/**
+ * A per-target index of save meta infos, including the thumbnails, kept
+ * in the cache directory. It spares the save/load chooser from opening
+ * and parsing every save file each time it is shown.
+ *
+ * An entry is only used while the save file still has the modification
+ * time it had when the entry was stored, and the save list still shows
+ * the same description. Where the save file manager does not know
+ * modification times, the size of the save file is compared instead.
+ *
+ * Thumbnails are read from the index file only when a save is looked up.
+ */
+class SaveStateIndex : Common::NonCopyable {
+public:
+	SaveStateIndex();
+	~SaveStateIndex();
+
+	/**
+	 * Load the index of a target, dropping any index loaded before.
+	 *
+	 * @param metaEngine	the meta engine of the target, used to locate
+	 *						its save files
+	 * @param target		the target
+	 */
+	void load(const MetaEngine *metaEngine, const Common::String &target);
+
+	/**
+	 * Write the index back to the cache directory, if it changed.
+	 */
+	void save();
+
+	/**
+	 * Forget the loaded index without writing it.
+	 */
+	void clear();
+
+	/**
+	 * Look up the meta infos of a save.
+	 *
+	 * @param listed	the save as returned by MetaEngine::listSaves()
+	 * @param desc		receives the meta infos
+	 * @return true if the index has up-to-date meta infos for the save
+	 */
+	bool find(const SaveStateDescriptor &listed, SaveStateDescriptor &desc) const;
+
+	/**
+	 * Add the meta infos returned by MetaEngine::querySaveMetaInfos() to
+	 * the index.
+	 */
+	void store(const SaveStateDescriptor &desc);
+
+	/**
+	 * Drop the entries of saves which are not in the save list any more.
+	 */
+	void removeMissing(const SaveStateList &saveList);
+
+private:
+	struct Entry {
+		uint32 saveSize;			///< only set if the modification time is unknown
+		uint32 modificationTime;
+		SaveStateDescriptor desc;	///< only holds a thumbnail if it was just stored
+		int32 thumbnailOffset;		///< of the thumbnail in the index file, or -1
+		uint32 thumbnailSize;
+	};
+
+	typedef Common::HashMap<int, Entry> EntryMap;
+
+	uint32 getModificationTime(int slot) const;
+	int32 getSaveSize(int slot) const;
+
+	const MetaEngine *_metaEngine;
+	Common::String _target;
+	EntryMap _entries;
+	Common::SeekableReadStream *_stream;	///< the loaded index file
+	bool _modified;
+};
+
+} // End of namespace GUI
+
+#endif
@@ -752,6 +752,11 @@ enum {
 	kNewSaveCmd = 'SAVE'
 };
 
+enum {
+	// Time in milliseconds per tickle spent on loading save meta infos
+	kMetaInfoTimeSlice = 20
+};
+
 SaveLoadChooserGrid::SaveLoadChooserGrid(const Common::String &title, bool saveMode)
 	: SaveLoadChooserDialog("SaveLoadChooser", saveMode), _lines(0), _columns(0), _entriesPerPage(0),
 	_curPage(0), _newSaveContainer(nullptr), _nextFreeSaveSlot(0), _buttons() {
@@ -844,6 +849,7 @@ void SaveLoadChooserGrid::handleMouseWheel(int x, int y, int direction) {
 
 void SaveLoadChooserGrid::updateSaveList() {
 	SaveLoadChooserDialog::updateSaveList();
+	_metaInfoCache.clear();
 	updateSaves();
 	g_gui.scheduleTopDialogRedraw();
 }
@@ -852,6 +858,9 @@ void SaveLoadChooserGrid::open() {
 	SaveLoadChooserDialog::open();
 
 	listSaves();
+	_metaInfoCache.clear();
+	_saveIndex.load(_metaEngine, _target);
+	_saveIndex.removeMissing(_saveList);
 	_resultString.clear();
 
 	// Load information to restore the last page the user had open.
@@ -1028,6 +1037,29 @@ void SaveLoadChooserGrid::close() {
 
 	SaveLoadChooserDialog::close();
 	hideButtons();
+	_pendingMetaInfos.clear();
+	_metaInfoCache.clear();
+	_saveIndex.save();
+	_saveIndex.clear();
+}
+
+void SaveLoadChooserGrid::handleTickle() {
+	// Query the meta infos of the saves on the current page a few at a time.
+	// This way the dialog opens right away, and the thumbnails fill in while
+	// the user looks at it.
+	const uint32 startTime = g_system->getMillis();
+	while (!_pendingMetaInfos.empty() && g_system->getMillis() - startTime < kMetaInfoTimeSlice) {
+		const uint i = _pendingMetaInfos.pop();
+		const int saveSlot = _saveList[i].getSaveSlot();
+
+		SaveStateDescriptor desc = _metaEngine->querySaveMetaInfos(_target.c_str(), saveSlot);
+		_metaInfoCache.setVal(saveSlot, desc);
+		_saveIndex.store(desc);
+		updateSlotButton(i - _curPage * _entriesPerPage, saveSlot, desc);
+		_buttons[i - _curPage * _entriesPerPage].button->markAsDirty();
+	}
+
+	SaveLoadChooserDialog::handleTickle();
 }
 
 int SaveLoadChooserGrid::runIntern() {
@@ -1078,6 +1110,7 @@ void SaveLoadChooserGrid::destroyButtons() {
 	}
 
 	_buttons.clear();
+	_pendingMetaInfos.clear();
 }
 
 void SaveLoadChooserGrid::hideButtons() {
@@ -1089,59 +1122,25 @@ void SaveLoadChooserGrid::hideButtons() {
 
 void SaveLoadChooserGrid::updateSaves() {
 	hideButtons();
+	_pendingMetaInfos.clear();
 
 	for (uint i = _curPage * _entriesPerPage, curNum = 0; i < _saveList.size() && curNum < _entriesPerPage; ++i, ++curNum) {
-		const uint saveSlot = _saveList[i].getSaveSlot();
-
-		SaveStateDescriptor desc =  (_saveList[i].getLocked() ? _saveList[i] : _metaEngine->querySaveMetaInfos(_target.c_str(), saveSlot));
-		SlotButton &curButton = _buttons[curNum];
-		curButton.setVisible(true);
-		const Graphics::Surface *thumbnail = desc.getThumbnail();
-		if (thumbnail) {
-			curButton.button->setGfx(desc.getThumbnail());
-		} else {
-			curButton.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
-		}
-		curButton.description->setLabel(Common::String::format("%d. %s", saveSlot, desc.getDescription().c_str()));
-
-		Common::String tooltip(_("Name: "));
-		tooltip += desc.getDescription();
-
-		if (_saveDateSupport) {
-			const Common::String &saveDate = desc.getSaveDate();
-			if (!saveDate.empty()) {
-				tooltip += "\n";
-				tooltip +=  _("Date: ") + saveDate;
-			}
-
-			const Common::String &saveTime = desc.getSaveTime();
-			if (!saveTime.empty()) {
-				tooltip += "\n";
-				tooltip += _("Time: ") + saveTime;
-			}
-		}
-
-		if (_playTimeSupport) {
-			const Common::String &playTime = desc.getPlayTime();
-			if (!playTime.empty()) {
-				tooltip += "\n";
-				tooltip += _("Playtime: ") + playTime;
-			}
-		}
-
-		curButton.button->setTooltip(tooltip);
-
-		// In save mode we disable the button, when it's write protected.
-		// TODO: Maybe we should not display it at all then?
-		if (_saveMode && desc.getWriteProtectedFlag()) {
-			curButton.button->setEnabled(false);
+		const int saveSlot = _saveList[i].getSaveSlot();
+
+		// Show what the save list already knows until the meta infos are loaded
+		MetaInfoCache::const_iterator cached = _metaInfoCache.find(saveSlot);
+		SaveStateDescriptor desc;
+		if (_saveList[i].getLocked()) {
+			updateSlotButton(curNum, saveSlot, _saveList[i]);
+		} else if (cached != _metaInfoCache.end()) {
+			updateSlotButton(curNum, saveSlot, cached->_value);
+		} else if (_saveIndex.find(_saveList[i], desc)) {
+			_metaInfoCache.setVal(saveSlot, desc);
+			updateSlotButton(curNum, saveSlot, desc);
 		} else {
-			curButton.button->setEnabled(true);
+			updateSlotButton(curNum, saveSlot, _saveList[i]);
+			_pendingMetaInfos.push(i);
 		}
-
-		//that would make it look "disabled" if slot is locked
-		curButton.button->setEnabled(!desc.getLocked());
-		curButton.description->setEnabled(!desc.getLocked());
 	}
 
 	const uint numPages = (_entriesPerPage != 0 && !_saveList.empty()) ? ((_saveList.size() + _entriesPerPage - 1) / _entriesPerPage) : 1;
@@ -1158,6 +1157,57 @@ void SaveLoadChooserGrid::updateSaves() {
 		_nextButton->setEnabled(false);
 }
 
+void SaveLoadChooserGrid::updateSlotButton(uint buttonNum, int saveSlot, const SaveStateDescriptor &desc) {
+	SlotButton &curButton = _buttons[buttonNum];
+	curButton.setVisible(true);
+	const Graphics::Surface *thumbnail = desc.getThumbnail();
+	if (thumbnail) {
+		curButton.button->setGfx(desc.getThumbnail());
+	} else {
+		curButton.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
+	}
+	curButton.description->setLabel(Common::String::format("%d. %s", saveSlot, desc.getDescription().c_str()));
+
+	Common::String tooltip(_("Name: "));
+	tooltip += desc.getDescription();
+
+	if (_saveDateSupport) {
+		const Common::String &saveDate = desc.getSaveDate();
+		if (!saveDate.empty()) {
+			tooltip += "\n";
+			tooltip +=  _("Date: ") + saveDate;
+		}
+
+		const Common::String &saveTime = desc.getSaveTime();
+		if (!saveTime.empty()) {
+			tooltip += "\n";
+			tooltip += _("Time: ") + saveTime;
+		}
+	}
+
+	if (_playTimeSupport) {
+		const Common::String &playTime = desc.getPlayTime();
+		if (!playTime.empty()) {
+			tooltip += "\n";
+			tooltip += _("Playtime: ") + playTime;
+		}
+	}
+
+	curButton.button->setTooltip(tooltip);
+
+	// In save mode we disable the button, when it's write protected.
+	// TODO: Maybe we should not display it at all then?
+	if (_saveMode && desc.getWriteProtectedFlag()) {
+		curButton.button->setEnabled(false);
+	} else {
+		curButton.button->setEnabled(true);
+	}
+
+	//that would make it look "disabled" if slot is locked
+	curButton.button->setEnabled(!desc.getLocked());
+	curButton.description->setEnabled(!desc.getLocked());
+}
+
 SavenameDialog::SavenameDialog()
 	: Dialog("SavenameDialog") {
 	_title = new StaticTextWidget(this, "SavenameDialog.DescriptionText", Common::String());
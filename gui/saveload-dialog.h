@@ -27,6 +27,10 @@
 #include "gui/widgets/list.h"
 
 #include "engines/metaengine.h"
+#include "gui/saveindex.h"
+
+#include "common/hashmap.h"
+#include "common/queue.h"
 
 namespace GUI {
 
@@ -205,6 +209,8 @@ public:
 	SaveLoadChooserType getType() const override { return kSaveLoadDialogGrid; }
 
 	void close() override;
+
+	void handleTickle() override;
 protected:
 	void handleCommand(CommandSender *sender, uint32 cmd, uint32 data) override;
 	void handleMouseWheel(int x, int y, int direction) override;
@@ -246,6 +252,26 @@ private:
 	void destroyButtons();
 	void hideButtons();
 	void updateSaves();
+	void updateSlotButton(uint buttonNum, int saveSlot, const SaveStateDescriptor &desc);
+
+	/**
+	 * Meta infos (including thumbnails) of the saves queried so far, by
+	 * slot. Paging back to a page shown before does not query them again.
+	 */
+	typedef Common::HashMap<int, SaveStateDescriptor> MetaInfoCache;
+	MetaInfoCache _metaInfoCache;
+
+	/**
+	 * The meta infos stored by earlier runs of the dialog, so that they
+	 * need not be queried again.
+	 */
+	SaveStateIndex _saveIndex;
+
+	/**
+	 * Indices into _saveList of the saves on the current page, whose meta
+	 * infos are still to be queried in handleTickle().
+	 */
+	Common::Queue<uint> _pendingMetaInfos;
 };
 
 #endif // !DISABLE_SAVELOADCHOOSER_GRID
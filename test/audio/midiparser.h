@@ -0,0 +1,202 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/mididrv.h"
+#include "audio/midiparser.h"
+
+#include "common/array.h"
+#include "common/config-manager.h"
+
+class MidiParserTestDriver : public MidiDriver_BASE {
+public:
+	/** Everything sent, SysEx messages are logged as 0xF0 followed by their first byte. */
+	Common::Array<uint32> events;
+
+	void send(uint32 b) override { events.push_back(b); }
+	void sysEx(const byte *msg, uint16 length) override { events.push_back(0xF0 | (length ? msg[0] << 8 : 0)); }
+};
+
+class MidiParserTestSuite : public CxxTest::TestSuite {
+	enum {
+		kPPQN = 96,
+		kBeats = 64
+	};
+
+	Common::Array<byte> _smf;
+
+	void writeVLQ(Common::Array<byte> &track, uint32 value) {
+		byte bytes[4];
+		int count = 0;
+		do {
+			bytes[count++] = value & 0x7F;
+			value >>= 7;
+		} while (value);
+		while (count-- > 1)
+			track.push_back(bytes[count] | 0x80);
+		track.push_back(bytes[0]);
+	}
+
+	/**
+	 * Builds a type 0 SMF playing one note per beat. With withSysEx set,
+	 * every beat also carries a SysEx message, as the SCUMM iMUSE
+	 * resources do.
+	 */
+	void buildSMF(bool withSysEx) {
+		Common::Array<byte> track;
+
+		// Tempo, 500000 microseconds per quarter note
+		const byte tempo[] = { 0x00, 0xFF, 0x51, 0x03, 0x07, 0xA1, 0x20 };
+		track.push_back(Common::Array<byte>(tempo, ARRAYSIZE(tempo)));
+
+		for (int beat = 0; beat < kBeats; ++beat) {
+			writeVLQ(track, beat ? kPPQN / 2 : 0);
+			track.push_back(0xB0);
+			track.push_back(7);
+			track.push_back(beat & 0x7F);
+
+			if (withSysEx) {
+				writeVLQ(track, 0);
+				track.push_back(0xF0);
+				track.push_back(2);
+				track.push_back(0x7D);
+				track.push_back(beat & 0x7F);
+			}
+
+			writeVLQ(track, 0);
+			track.push_back(0xC0);
+			track.push_back(beat & 0x7F);
+
+			writeVLQ(track, 0);
+			track.push_back(0x90);
+			track.push_back(60);
+			track.push_back(100);
+
+			writeVLQ(track, kPPQN / 2);
+			track.push_back(0x80);
+			track.push_back(60);
+			track.push_back(0);
+		}
+
+		const byte endOfTrack[] = { 0x00, 0xFF, 0x2F, 0x00 };
+		track.push_back(Common::Array<byte>(endOfTrack, ARRAYSIZE(endOfTrack)));
+
+		const byte header[] = { 'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, 0, 0, 1, kPPQN >> 8, kPPQN & 0xFF, 'M', 'T', 'r', 'k' };
+		_smf.clear();
+		_smf.push_back(Common::Array<byte>(header, ARRAYSIZE(header)));
+		_smf.push_back(track.size() >> 24);
+		_smf.push_back((track.size() >> 16) & 0xFF);
+		_smf.push_back((track.size() >> 8) & 0xFF);
+		_smf.push_back(track.size() & 0xFF);
+		_smf.push_back(track);
+	}
+
+	MidiParser *createParser(MidiDriver_BASE *driver, bool seekIndex) {
+		MidiParser *parser = MidiParser::createParser_SMF();
+		parser->setMidiDriver(driver);
+		parser->property(MidiParser::mpSeekIndex, seekIndex);
+		TS_ASSERT(parser->loadMusic(&_smf[0], _smf.size()));
+		return parser;
+	}
+
+public:
+	void setUp() {
+		// Read by the MidiDriver_BASE constructor
+		ConfMan.setBool("dump_midi", false, Common::ConfigManager::kTransientDomain);
+	}
+
+	void tearDown() {
+		ConfMan.removeKey("dump_midi", Common::ConfigManager::kTransientDomain);
+	}
+
+	void test_seek_index_without_events() {
+		// iMUSE jumps and restores savegames like this, so the checkpoints
+		// are used even though its tracks are full of SysEx messages.
+		buildSMF(true);
+
+		MidiParserTestDriver referenceDriver;
+		MidiParser *reference = createParser(&referenceDriver, false);
+		MidiParserTestDriver driver;
+		MidiParser *parser = createParser(&driver, true);
+
+		const uint32 targets[] = { 40 * kPPQN + 10, 20 * kPPQN, 60 * kPPQN + 48, 17 * kPPQN + 1 };
+		for (int i = 0; i < ARRAYSIZE(targets); ++i) {
+			TS_ASSERT(reference->jumpToTick(targets[i]));
+			TS_ASSERT(parser->jumpToTick(targets[i]));
+			TS_ASSERT_EQUALS(parser->getTick(), reference->getTick());
+		}
+
+		// Replace the first event after the tempo with End of Track. Only
+		// a parser resuming from a checkpoint still reaches the target.
+		const byte endOfTrack[] = { 0x00, 0xFF, 0x2F, 0x00 };
+		memcpy(&_smf[22 + 7], endOfTrack, sizeof(endOfTrack));
+		TS_ASSERT(!reference->jumpToTick(50 * kPPQN));
+		TS_ASSERT(parser->jumpToTick(50 * kPPQN));
+		TS_ASSERT_EQUALS(parser->getTick(), (uint32)50 * kPPQN);
+
+		delete parser;
+		delete reference;
+	}
+
+	void test_seek_index_with_sysex_events() {
+		// iMUSE scans with fireEvents set. The SysEx messages then rule
+		// out the checkpoints, and every skipped event is sent as before.
+		buildSMF(true);
+
+		MidiParserTestDriver referenceDriver;
+		MidiParser *reference = createParser(&referenceDriver, false);
+		MidiParserTestDriver driver;
+		MidiParser *parser = createParser(&driver, true);
+
+		TS_ASSERT(parser->jumpToTick(10 * kPPQN));
+		driver.events.clear();
+
+		TS_ASSERT(reference->jumpToTick(50 * kPPQN + 60, true));
+		TS_ASSERT(parser->jumpToTick(50 * kPPQN + 60, true));
+		TS_ASSERT_EQUALS(parser->getTick(), reference->getTick());
+		TS_ASSERT_EQUALS(driver.events.size(), referenceDriver.events.size());
+		for (uint i = 0; i < driver.events.size() && i < referenceDriver.events.size(); ++i)
+			TS_ASSERT_EQUALS(driver.events[i], referenceDriver.events[i]);
+
+		delete parser;
+		delete reference;
+	}
+
+	void test_seek_index_with_channel_events() {
+		// Without SysEx, the skipped events are replaced by the channel
+		// state they leave behind.
+		buildSMF(false);
+
+		MidiParserTestDriver referenceDriver;
+		MidiParser *reference = createParser(&referenceDriver, false);
+		MidiParserTestDriver driver;
+		MidiParser *parser = createParser(&driver, true);
+
+		TS_ASSERT(parser->jumpToTick(10 * kPPQN));
+		driver.events.clear();
+
+		TS_ASSERT(reference->jumpToTick(50 * kPPQN + 60, true));
+		TS_ASSERT(parser->jumpToTick(50 * kPPQN + 60, true));
+		TS_ASSERT_EQUALS(parser->getTick(), reference->getTick());
+		TS_ASSERT_LESS_THAN(driver.events.size(), referenceDriver.events.size());
+
+		// The volume and program end up the same
+		uint32 volume = 0, referenceVolume = 0, program = 0, referenceProgram = 0;
+		for (uint i = 0; i < driver.events.size(); ++i) {
+			if ((driver.events[i] & 0xFFFF) == 0x07B0)
+				volume = driver.events[i];
+			else if ((driver.events[i] & 0xFF) == 0xC0)
+				program = driver.events[i];
+		}
+		for (uint i = 0; i < referenceDriver.events.size(); ++i) {
+			if ((referenceDriver.events[i] & 0xFFFF) == 0x07B0)
+				referenceVolume = referenceDriver.events[i];
+			else if ((referenceDriver.events[i] & 0xFF) == 0xC0)
+				referenceProgram = referenceDriver.events[i];
+		}
+		TS_ASSERT_EQUALS(volume, referenceVolume);
+		TS_ASSERT_EQUALS(program, referenceProgram);
+		TS_ASSERT_DIFFERS(volume, (uint32)0);
+
+		delete parser;
+		delete reference;
+	}
+};
@@ -0,0 +1,238 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/cachefile.h"
+#include "common/config-manager.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/memstream.h"
+#include "common/system.h"
+
+#include "backends/fs/abstract-fs.h"
+#include "backends/fs/fs-factory.h"
+
+#include "helper.h"
+
+/**
+ * A file system held in memory, just enough for the cache directory:
+ * flat files below a few directories.
+ */
+struct CacheFileTestFS {
+	typedef Common::HashMap<Common::String, Common::Array<byte> *> FileMap;
+	FileMap files;
+	Common::HashMap<Common::String, bool> dirs;
+
+	~CacheFileTestFS() {
+		for (FileMap::iterator i = files.begin(); i != files.end(); ++i)
+			delete i->_value;
+	}
+};
+
+class CacheFileTestWriteStream : public Common::WriteStream {
+	Common::Array<byte> *_data;
+
+public:
+	explicit CacheFileTestWriteStream(Common::Array<byte> *data) : _data(data) { _data->clear(); }
+
+	uint32 write(const void *dataPtr, uint32 dataSize) override {
+		const byte *bytes = (const byte *)dataPtr;
+		for (uint32 i = 0; i < dataSize; ++i)
+			_data->push_back(bytes[i]);
+		return dataSize;
+	}
+
+	int32 pos() const override { return _data->size(); }
+};
+
+class CacheFileTestNode : public AbstractFSNode {
+	CacheFileTestFS *_fs;
+	Common::String _path;
+
+public:
+	CacheFileTestNode(CacheFileTestFS *fs, const Common::String &path) : _fs(fs), _path(path) {}
+
+	AbstractFSNode *getChild(const Common::String &name) const override { return new CacheFileTestNode(_fs, _path + "/" + name); }
+	AbstractFSNode *getParent() const override { return nullptr; }
+	bool getChildren(AbstractFSList &list, ListMode mode, bool hidden) const override { return false; }
+
+	bool exists() const override { return isDirectory() || _fs->files.contains(_path); }
+	Common::String getName() const override { return _path; }
+	Common::String getPath() const override { return _path; }
+	bool isDirectory() const override { return _fs->dirs.contains(_path); }
+	bool isReadable() const override { return exists(); }
+	bool isWritable() const override { return true; }
+
+	Common::SeekableReadStream *createReadStream() override {
+		if (!_fs->files.contains(_path))
+			return nullptr;
+
+		const Common::Array<byte> &data = *_fs->files[_path];
+		byte *copy = (byte *)malloc(data.size() + 1);
+		if (!data.empty())
+			memcpy(copy, &data[0], data.size());
+		return new Common::MemoryReadStream(copy, data.size(), DisposeAfterUse::YES);
+	}
+
+	Common::WriteStream *createWriteStream() override {
+		if (!_fs->files.contains(_path))
+			_fs->files[_path] = new Common::Array<byte>();
+		return new CacheFileTestWriteStream(_fs->files[_path]);
+	}
+
+	bool createDirectory() override {
+		_fs->dirs[_path] = true;
+		return true;
+	}
+
+	bool remove() override {
+		if (!_fs->files.contains(_path))
+			return false;
+
+		delete _fs->files[_path];
+		_fs->files.erase(_path);
+		return true;
+	}
+};
+
+class CacheFileTestFactory : public FilesystemFactory {
+	CacheFileTestFS *_fs;
+
+public:
+	explicit CacheFileTestFactory(CacheFileTestFS *fs) : _fs(fs) {}
+
+	AbstractFSNode *makeCurrentDirectoryFileNode() const override { return new CacheFileTestNode(_fs, ""); }
+	AbstractFSNode *makeFileNodePath(const Common::String &path) const override { return new CacheFileTestNode(_fs, path); }
+	AbstractFSNode *makeRootFileNode() const override { return new CacheFileTestNode(_fs, ""); }
+};
+
+/**
+ * Just enough of an OSystem to reach the in-memory file system.
+ */
+class CacheFileTestSystem : public StubTestSystem {
+public:
+	explicit CacheFileTestSystem(CacheFileTestFS *fs) { _fsFactory = new CacheFileTestFactory(fs); }
+};
+
+class CacheFileTestSuite : public CxxTest::TestSuite {
+	OSystem *_savedSystem;
+	CacheFileTestSystem *_system;
+	CacheFileTestFS *_fs;
+
+	enum {
+		kMemberSize = 20 * 1024
+	};
+
+	Common::Array<byte> makeMember(byte seed) {
+		Common::Array<byte> data(kMemberSize);
+		for (uint i = 0; i < data.size(); ++i)
+			data[i] = (byte)(i * 7 + seed);
+		return data;
+	}
+
+	bool isCached(const char *name, uint32 memberKey) {
+		Common::SeekableReadStream *stream = Common::openCachedArchiveMember("archive", name, memberKey, kMemberSize);
+		delete stream;
+		return stream != nullptr;
+	}
+
+public:
+	void setUp() {
+		_savedSystem = g_system;
+		_fs = new CacheFileTestFS();
+		_fs->dirs["/cache"] = true;
+		_system = new CacheFileTestSystem(_fs);
+		g_system = _system;
+		ConfMan.set("cachepath", "/cache", Common::ConfigManager::kTransientDomain);
+	}
+
+	void tearDown() {
+		Common::flushArchiveMemberCache();
+		ConfMan.removeKey("cachepath", Common::ConfigManager::kTransientDomain);
+		ConfMan.removeKey("archive_cache_size", Common::ConfigManager::kTransientDomain);
+		g_system = _savedSystem;
+		delete _system;
+		delete _fs;
+	}
+
+	void test_roundtrip() {
+		Common::Array<byte> data = makeMember(1);
+		Common::cacheArchiveMember("archive", "FILE.DAT", 0x1234, &data[0], data.size());
+
+		Common::SeekableReadStream *stream = Common::openCachedArchiveMember("archive", "file.dat", 0x1234, kMemberSize);
+		TS_ASSERT(stream != nullptr);
+		if (stream) {
+			TS_ASSERT_EQUALS(stream->size(), (int32)kMemberSize);
+			byte buffer[kMemberSize];
+			stream->read(buffer, kMemberSize);
+			TS_ASSERT(!memcmp(buffer, &data[0], kMemberSize));
+			delete stream;
+		}
+	}
+
+	void test_member_key_mismatch() {
+		Common::Array<byte> data = makeMember(2);
+		Common::cacheArchiveMember("archive", "FILE.DAT", 0x1234, &data[0], data.size());
+
+		// Same archive key, name and size, but different compressed data
+		TS_ASSERT(!isCached("FILE.DAT", 0x5678));
+		TS_ASSERT(isCached("FILE.DAT", 0x1234));
+	}
+
+	void test_member_key() {
+		uint32 key = Common::computeArchiveMemberKey("archive", 16, 32, 0xABCD);
+		TS_ASSERT_EQUALS(Common::computeArchiveMemberKey("archive", 16, 32, 0xABCD), key);
+
+		// Patched members differ in where they are stored or in their checksum
+		TS_ASSERT_DIFFERS(Common::computeArchiveMemberKey("archive", 20, 32, 0xABCD), key);
+		TS_ASSERT_DIFFERS(Common::computeArchiveMemberKey("archive", 16, 36, 0xABCD), key);
+		TS_ASSERT_DIFFERS(Common::computeArchiveMemberKey("archive", 16, 32, 0xABCE), key);
+		TS_ASSERT_DIFFERS(Common::computeArchiveMemberKey("other", 16, 32, 0xABCD), key);
+	}
+
+	void test_corruption() {
+		Common::Array<byte> data = makeMember(3);
+		Common::cacheArchiveMember("archive", "FILE.DAT", 0x1234, &data[0], data.size());
+
+		// Damage the stored size in the header
+		Common::String path;
+		for (CacheFileTestFS::FileMap::iterator i = _fs->files.begin(); i != _fs->files.end(); ++i) {
+			if (i->_key.hasPrefix("/cache/member-") && i->_key.hasSuffix(".bin"))
+				path = i->_key;
+		}
+		TS_ASSERT(!path.empty());
+		if (path.empty())
+			return;
+		(*_fs->files[path])[8] ^= 0x80;
+
+		TS_ASSERT(!isCached("FILE.DAT", 0x1234));
+		// The damaged entry is deleted
+		TS_ASSERT(!_fs->files.contains(path));
+
+		// A truncated entry is rejected too
+		Common::cacheArchiveMember("archive", "FILE.DAT", 0x1234, &data[0], data.size());
+		TS_ASSERT(_fs->files.contains(path));
+		_fs->files[path]->resize(_fs->files[path]->size() / 2);
+		TS_ASSERT(!isCached("FILE.DAT", 0x1234));
+	}
+
+	void test_eviction() {
+		// Room for two members
+		ConfMan.setInt("archive_cache_size", 2 * kMemberSize / 1024 + 1, Common::ConfigManager::kTransientDomain);
+
+		Common::Array<byte> data = makeMember(4);
+		Common::cacheArchiveMember("archive", "A", 1, &data[0], data.size());
+		Common::cacheArchiveMember("archive", "B", 2, &data[0], data.size());
+
+		// Use A, so B is the least recently used member
+		TS_ASSERT(isCached("A", 1));
+
+		Common::cacheArchiveMember("archive", "C", 3, &data[0], data.size());
+		TS_ASSERT(isCached("A", 1));
+		TS_ASSERT(!isCached("B", 2));
+		TS_ASSERT(isCached("C", 3));
+
+		// Members larger than the whole budget are not cached
+		ConfMan.setInt("archive_cache_size", kMemberSize / 1024 - 1, Common::ConfigManager::kTransientDomain);
+		Common::cacheArchiveMember("archive", "D", 4, &data[0], data.size());
+		TS_ASSERT(!isCached("D", 4));
+	}
+};
@@ -0,0 +1,82 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/framearena.h"
+
+class FrameArenaTestSuite : public CxxTest::TestSuite {
+public:
+	void test_alignment() {
+		Common::FrameArena arena(256);
+
+		for (int i = 1; i < 40; i++) {
+			void *ptr = arena.allocate(i);
+			TS_ASSERT_EQUALS((size_t)ptr % 8, (size_t)0);
+			TS_ASSERT(arena.owns(ptr));
+		}
+
+		int local;
+		TS_ASSERT(!arena.owns(&local));
+	}
+
+	void test_reuse_after_frame() {
+		Common::FrameArena arena(1024);
+
+		void *first;
+		{
+			Common::FrameArena::FrameScope scope(arena);
+			first = arena.allocate(100);
+			arena.allocate(2000);	// larger than a chunk
+			arena.allocate(900);
+		}
+
+		TS_ASSERT_EQUALS(arena.getFrameCount(), (uint32)1);
+		TS_ASSERT_EQUALS(arena.getLastFrameAllocations(), (uint32)3);
+		TS_ASSERT_EQUALS(arena.getLastFrameBytes(), (uint32)(104 + 2000 + 904));
+		uint32 chunks = arena.getChunkAllocations();
+
+		// The same frame again must not need any new memory
+		{
+			Common::FrameArena::FrameScope scope(arena);
+			TS_ASSERT_EQUALS(arena.allocate(100), first);
+			arena.allocate(2000);
+			arena.allocate(900);
+		}
+
+		TS_ASSERT_EQUALS(arena.getChunkAllocations(), chunks);
+		TS_ASSERT_EQUALS(arena.getPeakFrameBytes(), (uint32)(104 + 2000 + 904));
+	}
+
+	void test_nested_frames() {
+		Common::FrameArena arena(1024);
+
+		arena.beginFrame();
+		int *outer = arena.allocateArray<int>(4);
+		outer[3] = 42;
+
+		arena.beginFrame();
+		int *inner = arena.allocateArray<int>(4);
+		inner[3] = 7;
+		arena.endFrame();
+
+		// The inner frame must not release the outer frame's memory
+		TS_ASSERT_EQUALS(arena.getFrameCount(), (uint32)0);
+		TS_ASSERT_EQUALS(outer[3], 42);
+		TS_ASSERT_DIFFERS(arena.allocateArray<int>(4), outer);
+
+		arena.endFrame();
+		TS_ASSERT_EQUALS(arena.getFrameCount(), (uint32)1);
+		TS_ASSERT_EQUALS(arena.getLastFrameAllocations(), (uint32)3);
+	}
+
+	void test_placement_new() {
+		struct Point {
+			int x, y;
+			Point(int x_, int y_) : x(x_), y(y_) {}
+		};
+
+		Common::FrameArena arena;
+		Point *p = new (arena) Point(3, 4);
+		TS_ASSERT(arena.owns(p));
+		TS_ASSERT_EQUALS(p->x, 3);
+		TS_ASSERT_EQUALS(p->y, 4);
+	}
+};
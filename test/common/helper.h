@@ -0,0 +1,138 @@
+#ifndef TEST_COMMON_HELPER_H
+#define TEST_COMMON_HELPER_H
+
+#include "common/scummsys.h"
+#include "common/system.h"
+
+#include "graphics/pixelformat.h"
+
+/**
+ * An OSystem which does nothing, to be extended by the tests with just
+ * what they need. There are no threads, and mutexes are no-ops.
+ */
+class StubTestSystem : public OSystem {
+public:
+	virtual MutexRef createMutex() { return nullptr; }
+	virtual void lockMutex(MutexRef mutex) {}
+	virtual void unlockMutex(MutexRef mutex) {}
+	virtual void deleteMutex(MutexRef mutex) {}
+
+	virtual Graphics::PixelFormat getScreenFormat() const { return Graphics::PixelFormat(); }
+	virtual Common::List<Graphics::PixelFormat> getSupportedFormats() const { return Common::List<Graphics::PixelFormat>(); }
+	virtual void initSize(uint width, uint height, const Graphics::PixelFormat *format) {}
+	virtual int16 getHeight() { return 0; }
+	virtual int16 getWidth() { return 0; }
+	virtual PaletteManager *getPaletteManager() { return nullptr; }
+	virtual void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) {}
+	virtual Graphics::Surface *lockScreen() { return nullptr; }
+	virtual void unlockScreen() {}
+	virtual void fillScreen(uint32 col) {}
+	virtual void updateScreen() {}
+	virtual void setShakePos(int shakeXOffset, int shakeYOffset) {}
+	virtual void showOverlay() {}
+	virtual void hideOverlay() {}
+	virtual Graphics::PixelFormat getOverlayFormat() const { return Graphics::PixelFormat(); }
+	virtual void clearOverlay() {}
+	virtual void grabOverlay(void *buf, int pitch) {}
+	virtual void copyRectToOverlay(const void *buf, int pitch, int x, int y, int w, int h) {}
+	virtual int16 getOverlayHeight() { return 0; }
+	virtual int16 getOverlayWidth() { return 0; }
+	virtual bool showMouse(bool visible) { return false; }
+	virtual void warpMouse(int x, int y) {}
+	virtual void setMouseCursor(const void *buf, uint w, uint h, int hotspotX, int hotspotY, uint32 keycolor, bool dontScale, const Graphics::PixelFormat *format) {}
+	virtual uint32 getMillis(bool skipRecord) { return 0; }
+	virtual void delayMillis(uint msecs) {}
+	virtual void getTimeAndDate(TimeDate &t) const {}
+	virtual Audio::Mixer *getMixer() { return nullptr; }
+	virtual void quit() {}
+	virtual void displayMessageOnOSD(const char *msg) {}
+	virtual void displayActivityIconOnOSD(const Graphics::Surface *icon) {}
+	virtual void logMessage(LogMessageType::Type type, const char *message) {}
+};
+
+#ifdef POSIX
+
+#include <pthread.h>
+
+/**
+ * Just enough of an OSystem to run a TaskPool: pthread based mutexes,
+ * threads and conditions.
+ */
+class TaskPoolTestSystem : public StubTestSystem {
+	bool _threads;
+
+	struct ThreadStart {
+		ThreadProc proc;
+		void *param;
+	};
+
+	static void *threadProc(void *data) {
+		ThreadStart start = *(ThreadStart *)data;
+		delete (ThreadStart *)data;
+		start.proc(start.param);
+		return nullptr;
+	}
+
+public:
+	explicit TaskPoolTestSystem(bool threads) : _threads(threads) {}
+
+	virtual MutexRef createMutex() {
+		pthread_mutexattr_t attr;
+		pthread_mutexattr_init(&attr);
+		pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+		pthread_mutex_t *mutex = new pthread_mutex_t;
+		pthread_mutex_init(mutex, &attr);
+		pthread_mutexattr_destroy(&attr);
+		return (MutexRef)mutex;
+	}
+	virtual void lockMutex(MutexRef mutex) { pthread_mutex_lock((pthread_mutex_t *)mutex); }
+	virtual void unlockMutex(MutexRef mutex) { pthread_mutex_unlock((pthread_mutex_t *)mutex); }
+	virtual void deleteMutex(MutexRef mutex) {
+		pthread_mutex_destroy((pthread_mutex_t *)mutex);
+		delete (pthread_mutex_t *)mutex;
+	}
+
+	virtual ThreadRef createThread(ThreadProc proc, void *param) {
+		if (!_threads)
+			return nullptr;
+		ThreadStart *start = new ThreadStart;
+		start->proc = proc;
+		start->param = param;
+		pthread_t *thread = new pthread_t;
+		pthread_create(thread, nullptr, threadProc, start);
+		return (ThreadRef)thread;
+	}
+	virtual void joinThread(ThreadRef thread) {
+		pthread_join(*(pthread_t *)thread, nullptr);
+		delete (pthread_t *)thread;
+	}
+	virtual ConditionRef createCondition() {
+		if (!_threads)
+			return nullptr;
+		pthread_cond_t *cond = new pthread_cond_t;
+		pthread_cond_init(cond, nullptr);
+		return (ConditionRef)cond;
+	}
+	virtual void waitCondition(ConditionRef cond, MutexRef mutex) {
+		if (cond)
+			pthread_cond_wait((pthread_cond_t *)cond, (pthread_mutex_t *)mutex);
+	}
+	virtual void signalCondition(ConditionRef cond) {
+		if (cond)
+			pthread_cond_signal((pthread_cond_t *)cond);
+	}
+	virtual void broadcastCondition(ConditionRef cond) {
+		if (cond)
+			pthread_cond_broadcast((pthread_cond_t *)cond);
+	}
+	virtual void deleteCondition(ConditionRef cond) {
+		if (cond) {
+			pthread_cond_destroy((pthread_cond_t *)cond);
+			delete (pthread_cond_t *)cond;
+		}
+	}
+};
+
+#endif
+
+#endif
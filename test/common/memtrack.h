@@ -0,0 +1,97 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memtrack.h"
+#include "common/memorypool.h"
+
+class MemoryTrackerTestSuite : public CxxTest::TestSuite {
+	static const Common::MemoryTracker::TagStats *findTag(const Common::Array<Common::MemoryTracker::TagStats> &stats, const char *name) {
+		for (uint i = 0; i < stats.size(); ++i) {
+			if (!strcmp(stats[i].name, name))
+				return &stats[i];
+		}
+		return nullptr;
+	}
+
+public:
+	void test_disabled() {
+		static byte block[16];
+		Common::MemoryTracker::trackAlloc(block, sizeof(block));
+
+		Common::Array<Common::MemoryTracker::TagStats> stats;
+		Common::MemoryTracker::getStats(stats);
+		TS_ASSERT(stats.empty());
+	}
+
+	void test_scopes() {
+		static byte outer[100], inner[50], other[10];
+
+		Common::MemoryTracker::setEnabled(true);
+		{
+			Common::MemoryTagScope scope("test.outer");
+			Common::MemoryTracker::trackAlloc(outer, sizeof(outer));
+			{
+				Common::MemoryTagScope innerScope("test.inner");
+				Common::MemoryTracker::trackAlloc(inner, sizeof(inner));
+			}
+			Common::MemoryTracker::trackFree(outer);
+			// A block is charged to the tag it was allocated under
+			Common::MemoryTracker::trackFree(inner);
+		}
+		Common::MemoryTracker::trackAlloc(other, sizeof(other));
+
+		Common::Array<Common::MemoryTracker::TagStats> stats;
+		Common::MemoryTracker::getStats(stats);
+
+		const Common::MemoryTracker::TagStats *tag = findTag(stats, "test.outer");
+		TS_ASSERT(tag);
+		if (tag) {
+			TS_ASSERT_EQUALS(tag->liveBytes, (size_t)0);
+			TS_ASSERT_EQUALS(tag->peakBytes, (size_t)100);
+			TS_ASSERT_EQUALS(tag->allocations, (uint32)1);
+		}
+
+		tag = findTag(stats, "test.inner");
+		TS_ASSERT(tag);
+		if (tag) {
+			TS_ASSERT_EQUALS(tag->liveBytes, (size_t)0);
+			TS_ASSERT_EQUALS(tag->peakBytes, (size_t)50);
+		}
+
+		tag = findTag(stats, "untagged");
+		TS_ASSERT(tag);
+		if (tag) {
+			TS_ASSERT_EQUALS(tag->liveBytes, (size_t)10);
+			TS_ASSERT_EQUALS(tag->liveBlocks, (uint32)1);
+		}
+
+		Common::MemoryTracker::setEnabled(false);
+	}
+
+	void test_memory_pool() {
+		Common::MemoryTracker::setEnabled(true);
+		{
+			Common::MemoryTagScope scope("test.pool");
+			Common::MemoryPool pool(16);
+			void *chunk = pool.allocChunk();
+
+			Common::Array<Common::MemoryTracker::TagStats> stats;
+			Common::MemoryTracker::getStats(stats);
+			const Common::MemoryTracker::TagStats *tag = findTag(stats, "test.pool");
+			TS_ASSERT(tag);
+			if (tag) {
+				TS_ASSERT_EQUALS(tag->liveBlocks, (uint32)1);
+				TS_ASSERT(tag->liveBytes >= 16);
+			}
+
+			pool.freeChunk(chunk);
+			pool.freeUnusedPages();
+
+			Common::MemoryTracker::getStats(stats);
+			tag = findTag(stats, "test.pool");
+			TS_ASSERT(tag);
+			if (tag)
+				TS_ASSERT_EQUALS(tag->liveBytes, (size_t)0);
+		}
+		Common::MemoryTracker::setEnabled(false);
+	}
+};
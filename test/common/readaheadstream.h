@@ -0,0 +1,451 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/bufferedstream.h"
+#include "common/memstream.h"
+#include "common/taskpool.h"
+#include "common/thread.h"
+
+#include "helper.h"
+
+/**
+ * Memory stream counting the reads and seeks reaching it, standing in
+ * for a file where each of them is a system call.
+ */
+class CountingReadStream : public Common::MemoryReadStream {
+public:
+	uint32 reads;
+	uint32 seeks;
+	uint32 bytes;
+
+	CountingReadStream(const byte *data, uint32 size) : Common::MemoryReadStream(data, size), reads(0), seeks(0), bytes(0) {}
+
+	uint32 read(void *dataPtr, uint32 dataSize) {
+		++reads;
+		uint32 n = Common::MemoryReadStream::read(dataPtr, dataSize);
+		bytes += n;
+		return n;
+	}
+
+	bool seek(int32 offs, int whence = SEEK_SET) {
+		++seeks;
+		return Common::MemoryReadStream::seek(offs, whence);
+	}
+};
+
+#ifdef POSIX
+
+class PrefetchTestSystem;
+
+/**
+ * Counting stream which notices the reads of prefetch tasks, and can
+ * hold them up so a test can act while a prefetch is in flight.
+ */
+class PrefetchReadStream : public CountingReadStream {
+	PrefetchTestSystem *_system;
+	pthread_t _readerThread;
+	Common::Mutex _mutex;
+	bool _hold;
+	bool _held;
+
+public:
+	uint32 prefetchReads;
+	bool inPrefetch;
+
+	PrefetchReadStream(const byte *data, uint32 size, PrefetchTestSystem *system);
+	~PrefetchReadStream();
+
+	bool isReaderThread() const { return pthread_equal(pthread_self(), _readerThread); }
+
+	/** Hold up prefetch reads until holding is switched off again. */
+	void holdPrefetches(bool hold) {
+		Common::StackLock lock(_mutex);
+		_hold = hold;
+	}
+
+	/** Whether a prefetch read is being held up right now. */
+	bool isHeld() {
+		Common::StackLock lock(_mutex);
+		return _held;
+	}
+
+	uint32 read(void *dataPtr, uint32 dataSize) {
+		if (isReaderThread())
+			return CountingReadStream::read(dataPtr, dataSize);
+
+		inPrefetch = true;
+		++prefetchReads;
+
+		_mutex.lock();
+		_held = _hold;
+		while (_held && _hold) {
+			_mutex.unlock();
+			sched_yield();
+			_mutex.lock();
+		}
+		_held = false;
+		_mutex.unlock();
+
+		uint32 n = CountingReadStream::read(dataPtr, dataSize);
+		inPrefetch = false;
+		return n;
+	}
+};
+
+/**
+ * Switches off holding prefetches as soon as the reading thread waits,
+ * since it may be waiting for the prefetch being held.
+ */
+class PrefetchTestSystem : public TaskPoolTestSystem {
+public:
+	PrefetchReadStream *stream;
+
+	PrefetchTestSystem() : TaskPoolTestSystem(true), stream(nullptr) {}
+
+	virtual void waitCondition(ConditionRef cond, MutexRef mutex) {
+		if (stream && stream->isReaderThread())
+			stream->holdPrefetches(false);
+		TaskPoolTestSystem::waitCondition(cond, mutex);
+	}
+};
+
+PrefetchReadStream::PrefetchReadStream(const byte *data, uint32 size, PrefetchTestSystem *system) : CountingReadStream(data, size),
+	_system(system), _readerThread(pthread_self()), _hold(false), _held(false), prefetchReads(0), inPrefetch(false) {
+	_system->stream = this;
+}
+
+PrefetchReadStream::~PrefetchReadStream() {
+	_system->stream = nullptr;
+}
+
+#endif
+
+class ReadAheadStreamTestSuite : public CxxTest::TestSuite {
+	enum {
+		kDataSize = 1024 * 1024
+	};
+
+	byte *_data;
+#ifdef POSIX
+	OSystem *_savedSystem;
+	PrefetchTestSystem *_threadSystem;
+#endif
+
+public:
+	void setUp() {
+		_data = new byte[kDataSize];
+		for (uint32 i = 0; i < kDataSize; ++i)
+			_data[i] = (i * 7) ^ (i >> 8);
+#ifdef POSIX
+		_savedSystem = g_system;
+		_threadSystem = nullptr;
+#endif
+	}
+
+	void tearDown() {
+#ifdef POSIX
+		if (_threadSystem) {
+			// The task pool has to stop before the system it runs on
+			Common::TaskPool::destroy();
+			g_system = _savedSystem;
+			delete _threadSystem;
+		}
+#endif
+		delete[] _data;
+	}
+
+public:
+	enum Pattern {
+		kSequential,
+		kStrided,
+		kBackward,
+		kRandom
+	};
+
+	/**
+	 * Read through the stream with the given pattern and check the data.
+	 * @return the number of parent reads and seeks
+	 */
+	uint32 runPattern(Pattern pattern, bool readAhead, bool asyncPrefetch = false) {
+		CountingReadStream parent(_data, kDataSize);
+		Common::SeekableReadStream *stream;
+		if (readAhead)
+			stream = Common::wrapReadAheadSeekableReadStream(&parent, 64 * 1024, DisposeAfterUse::NO, asyncPrefetch);
+		else
+			stream = Common::wrapBufferedSeekableReadStream(&parent, 4096, DisposeAfterUse::NO);
+
+		byte buf[256];
+		bool ok = true;
+		uint32 seed = 1;
+		uint32 count = 0;
+
+		for (int32 pos = 0; pos + 256 < kDataSize; ) {
+			uint32 len = 16;
+			switch (pattern) {
+			case kSequential:
+				break;
+			case kStrided:
+				// Like reading the headers of consecutive archive members
+				len = 32;
+				stream->seek(pos);
+				break;
+			case kBackward:
+				// Read a record, then go back to re-read part of the previous one
+				len = 200;
+				if (pos >= 1000) {
+					stream->seek(pos - 1000);
+					stream->read(buf, 100);
+					ok = ok && !memcmp(buf, _data + pos - 1000, 100);
+				}
+				stream->seek(pos);
+				break;
+			case kRandom:
+				seed = seed * 1103515245 + 12345;
+				pos = (seed >> 8) % (kDataSize - 256);
+				stream->seek(pos);
+				break;
+			}
+
+			ok = ok && stream->read(buf, len) == len && stream->pos() == pos + (int32)len;
+			ok = ok && !memcmp(buf, _data + pos, len);
+
+			switch (pattern) {
+			case kSequential:
+			case kBackward:
+				pos += len;
+				break;
+			case kStrided:
+				pos += 300;
+				break;
+			case kRandom:
+				if (++count == 2000)
+					pos = kDataSize;
+				break;
+			}
+		}
+
+		TS_ASSERT(ok);
+		delete stream;
+		return parent.reads + parent.seeks;
+	}
+
+public:
+	void test_sequential() {
+		uint32 buffered = runPattern(kSequential, false);
+		uint32 readAhead = runPattern(kSequential, true);
+		TS_ASSERT_LESS_THAN(readAhead * 8, buffered);
+	}
+
+	void test_strided() {
+		uint32 buffered = runPattern(kStrided, false);
+		uint32 readAhead = runPattern(kStrided, true);
+		TS_ASSERT_LESS_THAN(readAhead * 8, buffered);
+	}
+
+	void test_backward() {
+		// The fixed buffer drops its contents on every seek out of it
+		uint32 buffered = runPattern(kBackward, false);
+		uint32 readAhead = runPattern(kBackward, true);
+		TS_ASSERT_LESS_THAN(readAhead * 8, buffered);
+	}
+
+	void test_random() {
+		// Random access must not cost more calls than the fixed buffer
+		uint32 buffered = runPattern(kRandom, false);
+		uint32 readAhead = runPattern(kRandom, true);
+		TS_ASSERT_LESS_THAN_EQUALS(readAhead, buffered);
+	}
+
+	void test_eos() {
+		CountingReadStream parent(_data, 100);
+		Common::SeekableReadStream *stream = Common::wrapReadAheadSeekableReadStream(&parent, 64, DisposeAfterUse::NO);
+
+		byte buf[128];
+		TS_ASSERT_EQUALS(stream->read(buf, 100), 100u);
+		TS_ASSERT(!stream->eos());
+		TS_ASSERT_EQUALS(stream->read(buf, 1), 0u);
+		TS_ASSERT(stream->eos());
+
+		TS_ASSERT(stream->seek(-10, SEEK_END));
+		TS_ASSERT(!stream->eos());
+		TS_ASSERT_EQUALS(stream->read(buf, 128), 10u);
+		TS_ASSERT(stream->eos());
+		TS_ASSERT(!memcmp(buf, _data + 90, 10));
+
+		TS_ASSERT(!stream->seek(101));
+		delete stream;
+	}
+
+#ifdef POSIX
+private:
+	void useThreads() {
+		// Run the prefetches on worker threads
+		Common::TaskPool::destroy();
+		_threadSystem = new PrefetchTestSystem();
+		g_system = _threadSystem;
+	}
+
+	/**
+	 * Read on sequentially from pos until a prefetch is held up.
+	 * @return false if the data read was wrong or no prefetch was held
+	 */
+	bool readUntilPrefetch(Common::SeekableReadStream *stream, PrefetchReadStream &parent, int32 &pos) {
+		byte buf[1024];
+		stream->seek(pos);
+		while (pos + (int32)sizeof(buf) <= stream->size()) {
+			// Waiting for a prefetch switches holding off
+			parent.holdPrefetches(true);
+			if (stream->read(buf, sizeof(buf)) != sizeof(buf) || memcmp(buf, _data + pos, sizeof(buf)))
+				return false;
+			pos += sizeof(buf);
+
+			// Give a prefetch the chance to start. A prefetch the reader
+			// waits for before a worker picks it up runs on the reader.
+			for (int i = 0; i < 100; ++i) {
+				if (parent.isHeld())
+					return true;
+				sched_yield();
+			}
+		}
+		return false;
+	}
+
+	bool readAt(Common::SeekableReadStream *stream, int32 pos, uint32 len) {
+		byte buf[256];
+		assert(len <= sizeof(buf));
+		return stream->seek(pos) && stream->read(buf, len) == len && stream->pos() == pos + (int32)len && !memcmp(buf, _data + pos, len);
+	}
+
+public:
+	void test_async_patterns() {
+		useThreads();
+
+		// runPattern() checks the data, the prefetches must not cost more
+		// parent calls than reading synchronously
+		TS_ASSERT_LESS_THAN_EQUALS(runPattern(kSequential, true, true), runPattern(kSequential, true) + 1);
+		TS_ASSERT_LESS_THAN_EQUALS(runPattern(kStrided, true, true), runPattern(kStrided, true) + 1);
+		runPattern(kBackward, true, true);
+		runPattern(kRandom, true, true);
+	}
+
+	void test_async_sequential() {
+		useThreads();
+		PrefetchReadStream parent(_data, kDataSize, _threadSystem);
+		Common::SeekableReadStream *stream = Common::wrapReadAheadSeekableReadStream(&parent, 64 * 1024, DisposeAfterUse::NO, true);
+
+		// Every prefetch held up is released when the reader catches up
+		int32 pos = 0;
+		uint held = 0;
+		while (readUntilPrefetch(stream, parent, pos))
+			++held;
+		TS_ASSERT_LESS_THAN(0u, held);
+		TS_ASSERT_EQUALS(pos, (int32)kDataSize);
+		TS_ASSERT(!stream->eos());
+
+		byte buf[1];
+		TS_ASSERT_EQUALS(stream->read(buf, 1), 0u);
+		TS_ASSERT(stream->eos());
+		delete stream;
+	}
+
+	void test_async_seek_during_prefetch() {
+		useThreads();
+		PrefetchReadStream parent(_data, kDataSize, _threadSystem);
+		Common::SeekableReadStream *stream = Common::wrapReadAheadSeekableReadStream(&parent, 16 * 1024, DisposeAfterUse::NO, true);
+
+		// Back into data read before
+		int32 pos = 0;
+		TS_ASSERT(readUntilPrefetch(stream, parent, pos));
+		TS_ASSERT(parent.isHeld());
+		TS_ASSERT(readAt(stream, pos - 5000, 100));
+
+		// Into the window being prefetched
+		TS_ASSERT(readUntilPrefetch(stream, parent, pos));
+		TS_ASSERT(parent.isHeld());
+		TS_ASSERT(readAt(stream, pos + 16 * 1024, 256));
+
+		// Past it
+		pos += 16 * 1024 + 256;
+		TS_ASSERT(readUntilPrefetch(stream, parent, pos));
+		TS_ASSERT(parent.isHeld());
+		TS_ASSERT(readAt(stream, kDataSize - 200, 200));
+
+		// Large reads bypass the blocks
+		pos = 0;
+		TS_ASSERT(readUntilPrefetch(stream, parent, pos));
+		TS_ASSERT(parent.isHeld());
+		byte *large = new byte[32 * 1024];
+		TS_ASSERT(stream->seek(pos + 4096));
+		TS_ASSERT_EQUALS(stream->read(large, 32 * 1024), 32u * 1024);
+		TS_ASSERT(!memcmp(large, _data + pos + 4096, 32 * 1024));
+		delete[] large;
+
+		delete stream;
+	}
+
+	void test_async_eos() {
+		useThreads();
+		const int32 size = 100 * 1024 + 10;
+		PrefetchReadStream parent(_data, size, _threadSystem);
+		Common::SeekableReadStream *stream = Common::wrapReadAheadSeekableReadStream(&parent, 16 * 1024, DisposeAfterUse::NO, true);
+
+		// The last prefetch only covers the end of the stream
+		int32 pos = 0;
+		while (readUntilPrefetch(stream, parent, pos))
+			;
+		TS_ASSERT_LESS_THAN(0u, parent.prefetchReads);
+
+		byte buf[1024];
+		TS_ASSERT_EQUALS(stream->read(buf, sizeof(buf)), (uint32)(size - pos));
+		TS_ASSERT(!memcmp(buf, _data + pos, size - pos));
+		TS_ASSERT(stream->eos());
+
+		TS_ASSERT_EQUALS(stream->read(buf, 1), 0u);
+		TS_ASSERT(stream->eos());
+
+		TS_ASSERT(stream->seek(-10, SEEK_END));
+		TS_ASSERT(!stream->eos());
+		TS_ASSERT_EQUALS(stream->read(buf, sizeof(buf)), 10u);
+		TS_ASSERT(stream->eos());
+		TS_ASSERT(!memcmp(buf, _data + size - 10, 10));
+
+		delete stream;
+	}
+
+	void test_async_destroy_during_prefetch() {
+		useThreads();
+		PrefetchReadStream parent(_data, kDataSize, _threadSystem);
+		Common::SeekableReadStream *stream = Common::wrapReadAheadSeekableReadStream(&parent, 16 * 1024, DisposeAfterUse::NO, true);
+
+		int32 pos = 0;
+		TS_ASSERT(readUntilPrefetch(stream, parent, pos));
+		TS_ASSERT(parent.isHeld());
+
+		// The stream waits for the prefetch before freeing its blocks
+		delete stream;
+		TS_ASSERT(!parent.inPrefetch);
+	}
+
+	void test_async_err_during_prefetch() {
+		useThreads();
+		PrefetchReadStream parent(_data, kDataSize, _threadSystem);
+		Common::SeekableReadStream *stream = Common::wrapReadAheadSeekableReadStream(&parent, 16 * 1024, DisposeAfterUse::NO, true);
+
+		// The parent is only asked once the prefetch is done with it
+		int32 pos = 0;
+		TS_ASSERT(readUntilPrefetch(stream, parent, pos));
+		TS_ASSERT(parent.isHeld());
+		TS_ASSERT(!stream->err());
+		TS_ASSERT(!parent.inPrefetch);
+
+		TS_ASSERT(readUntilPrefetch(stream, parent, pos));
+		TS_ASSERT(parent.isHeld());
+		stream->clearErr();
+		TS_ASSERT(!parent.inPrefetch);
+
+		// The prefetched data is still used
+		TS_ASSERT(readAt(stream, pos, 256));
+
+		delete stream;
+	}
+#endif
+};
@@ -70,4 +70,16 @@ class SeekableSubReadStreamTestSuite : public CxxTest::TestSuite {
 		b = ssrs.readByte();
 		TS_ASSERT_EQUALS(b, 1);
 	}
+	void test_mapped_data() {
+		byte contents[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		Common::MemoryReadStream ms(contents, 10);
+		TS_ASSERT_EQUALS(ms.getMappedData(), contents);
+
+		Common::SeekableSubReadStream ssrs(&ms, 1, 9);
+		TS_ASSERT_EQUALS(ssrs.getMappedData(), contents + 1);
+
+		// Nested substreams resolve to the same buffer
+		Common::SeekableSubReadStream nested(&ssrs, 2, 5);
+		TS_ASSERT_EQUALS(nested.getMappedData(), contents + 3);
+	}
 };
@@ -0,0 +1,215 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/scummsys.h"
+
+#ifdef POSIX
+
+#include "common/taskpool.h"
+#include "common/thread.h"
+
+#include "helper.h"
+
+class TaskPoolTestSuite : public CxxTest::TestSuite {
+	OSystem *_savedSystem;
+	TaskPoolTestSystem *_system;
+
+	void useSystem(bool threads) {
+		_system = new TaskPoolTestSystem(threads);
+		g_system = _system;
+	}
+
+	struct SumTask {
+		int from, to;
+
+		int run() {
+			int sum = 0;
+			for (int i = from; i < to; ++i)
+				sum += i;
+			return sum;
+		}
+	};
+
+	struct FibTask {
+		Common::TaskPool *pool;
+		int n;
+
+		int run() {
+			if (n < 2)
+				return n;
+			// Compute one half on this thread, queue the other one
+			FibTask a = { pool, n - 1 };
+			FibTask b = { pool, n - 2 };
+			Common::Future<int> future = pool->submit(new Common::Functor0Mem<int, FibTask>(&a, &FibTask::run));
+			int result = b.run();
+			return future.get() + result;
+		}
+	};
+
+	struct CountTask {
+		Common::Mutex *mutex;
+		int *counter;
+		Common::Semaphore *done;
+
+		void run() {
+			mutex->lock();
+			++*counter;
+			mutex->unlock();
+			if (done)
+				done->release();
+		}
+	};
+
+	int sumTasks(Common::TaskPool &pool, int count) {
+		Common::Array<SumTask> tasks(count);
+		Common::Array<Common::Future<int> > futures;
+		for (int i = 0; i < count; ++i) {
+			tasks[i].from = i * 100;
+			tasks[i].to = (i + 1) * 100;
+			futures.push_back(pool.submit(new Common::Functor0Mem<int, SumTask>(&tasks[i], &SumTask::run)));
+		}
+
+		int sum = 0;
+		for (int i = 0; i < count; ++i)
+			sum += futures[i].get();
+		return sum;
+	}
+
+public:
+	void setUp() {
+		_savedSystem = g_system;
+		_system = nullptr;
+	}
+
+	void tearDown() {
+		g_system = _savedSystem;
+		delete _system;
+	}
+
+	void test_single_threaded_fallback() {
+		useSystem(false);
+		Common::TaskPool pool(4);
+		TS_ASSERT_EQUALS(pool.getThreadCount(), 0u);
+
+		SumTask task = { 0, 10 };
+		Common::Future<int> future = pool.submit(new Common::Functor0Mem<int, SumTask>(&task, &SumTask::run));
+		TS_ASSERT(future.isReady());
+		TS_ASSERT_EQUALS(future.get(), 45);
+
+		// Nested waits have to work without workers too
+		FibTask fib = { &pool, 10 };
+		TS_ASSERT_EQUALS(fib.run(), 55);
+	}
+
+	void test_results() {
+		useSystem(true);
+		Common::TaskPool pool(4);
+		TS_ASSERT_EQUALS(pool.getThreadCount(), 4u);
+
+		// Sum of 0 .. 19999
+		TS_ASSERT_EQUALS(sumTasks(pool, 200), 19999 * 20000 / 2);
+	}
+
+	void test_nested_wait() {
+		useSystem(true);
+		Common::TaskPool pool(3);
+
+		FibTask fib = { &pool, 18 };
+		TS_ASSERT_EQUALS(fib.run(), 2584);
+	}
+
+	void test_wait_all_stress() {
+		useSystem(true);
+
+		for (int round = 0; round < 20; ++round) {
+			Common::TaskPool pool(1 + round % 4);
+			Common::Mutex mutex;
+			int counter = 0;
+
+			CountTask task = { &mutex, &counter, nullptr };
+			for (int i = 0; i < 500; ++i)
+				pool.submit(new Common::Functor0Mem<void, CountTask>(&task, &CountTask::run));
+
+			pool.waitAll();
+			TS_ASSERT_EQUALS(counter, 500);
+		}
+	}
+
+	void test_shutdown_runs_queued_tasks() {
+		useSystem(true);
+		Common::Mutex mutex;
+		int counter = 0;
+
+		{
+			Common::TaskPool pool(2);
+			CountTask task = { &mutex, &counter, nullptr };
+			for (int i = 0; i < 200; ++i)
+				pool.submit(new Common::Functor0Mem<void, CountTask>(&task, &CountTask::run));
+		}
+
+		TS_ASSERT_EQUALS(counter, 200);
+	}
+
+	void test_semaphore() {
+		useSystem(true);
+		Common::TaskPool pool(4);
+		Common::Mutex mutex;
+		Common::Semaphore done;
+		int counter = 0;
+
+		CountTask task = { &mutex, &counter, &done };
+		for (int i = 0; i < 100; ++i)
+			pool.submit(new Common::Functor0Mem<void, CountTask>(&task, &CountTask::run));
+
+		for (int i = 0; i < 100; ++i)
+			done.acquire();
+		TS_ASSERT(!done.tryAcquire());
+		TS_ASSERT_EQUALS(counter, 100);
+	}
+
+	void test_semaphore_single_threaded() {
+		useSystem(false);
+		Common::TaskPool pool(4);
+		Common::Mutex mutex;
+		Common::Semaphore done;
+		int counter = 0;
+
+		// The tasks run when they are submitted, so the count is positive
+		// before the semaphore is acquired
+		CountTask task = { &mutex, &counter, &done };
+		for (int i = 0; i < 10; ++i)
+			pool.submit(new Common::Functor0Mem<void, CountTask>(&task, &CountTask::run));
+
+		for (int i = 0; i < 10; ++i)
+			done.acquire();
+		TS_ASSERT(!done.tryAcquire());
+		TS_ASSERT_EQUALS(counter, 10);
+	}
+
+	void test_future_outlives_pool() {
+		for (int threads = 0; threads < 2; ++threads) {
+			useSystem(threads != 0);
+
+			Common::Array<SumTask> tasks(50);
+			Common::Array<Common::Future<int> > futures;
+			Common::TaskPool *pool = new Common::TaskPool(2);
+			for (uint i = 0; i < tasks.size(); ++i) {
+				tasks[i].from = 0;
+				tasks[i].to = i;
+				futures.push_back(pool->submit(new Common::Functor0Mem<int, SumTask>(&tasks[i], &SumTask::run)));
+			}
+			delete pool;
+
+			for (uint i = 0; i < futures.size(); ++i) {
+				TS_ASSERT(futures[i].isReady());
+				TS_ASSERT_EQUALS(futures[i].get(), (int)(i * (i - 1) / 2));
+			}
+			futures.clear();
+
+			g_system = _savedSystem;
+			delete _system;
+			_system = nullptr;
+		}
+	}
+};
+
+#endif
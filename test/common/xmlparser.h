@@ -0,0 +1,90 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/xmlparser.h"
+#include "common/memstream.h"
+
+static const char *xmlparser_test_document =
+	"<?xml version = '1.0'?>"
+	"<!-- Comments are not part of the compiled form -->"
+	"<layout name = 'main' width = '320'>"
+	"	<widget name = 'OK' />"
+	"	<widget name = 'Cancel' type = 'button' />"
+	"</layout>"
+	"<layout name = 'second'>"
+	"</layout>";
+
+class XMLParserTestParser : public Common::XMLParser {
+public:
+	Common::String _trace;
+
+protected:
+	CUSTOM_XML_PARSER(XMLParserTestParser) {
+		XML_KEY(layout)
+			XML_PROP(name, true)
+			XML_PROP(width, false)
+			XML_KEY(widget)
+				XML_PROP(name, true)
+				XML_PROP(type, false)
+			KEY_END()
+		KEY_END()
+	} PARSER_END()
+
+	bool parserCallback_layout(ParserNode *node) {
+		_trace += "layout:" + node->values["name"];
+		if (node->values.contains("width"))
+			_trace += "/" + node->values["width"];
+		_trace += ";";
+		return true;
+	}
+
+	bool parserCallback_widget(ParserNode *node) {
+		_trace += "widget:" + node->values["name"];
+		if (node->values.contains("type"))
+			_trace += "/" + node->values["type"];
+		_trace += ";";
+		return true;
+	}
+
+	bool closedKeyCallback(ParserNode *node) override {
+		_trace += "close:" + node->name + ";";
+		return true;
+	}
+
+	void cleanup() override {
+		_trace.clear();
+	}
+};
+
+class XMLParserTestSuite : public CxxTest::TestSuite {
+	public:
+	void test_compiled_replay() {
+		Common::MemoryWriteStreamDynamic recording(DisposeAfterUse::YES);
+
+		XMLParserTestParser parser;
+		parser.loadBuffer((const byte *)xmlparser_test_document, strlen(xmlparser_test_document));
+		parser.setCompileStream(&recording);
+		TS_ASSERT(parser.parse());
+		parser.setCompileStream(nullptr);
+		parser.close();
+
+		const Common::String parsedTrace = parser._trace;
+		TS_ASSERT_EQUALS(parsedTrace,
+			"close:xml;"
+			"layout:main/320;widget:OK;close:widget;widget:Cancel/button;close:widget;close:layout;"
+			"layout:second;close:layout;");
+
+		Common::MemoryReadStream compiled(recording.getData(), recording.size());
+		XMLParserTestParser replayParser;
+		TS_ASSERT(replayParser.parseCompiled(&compiled));
+		TS_ASSERT_EQUALS(replayParser._trace, parsedTrace);
+	}
+
+	void test_compiled_bad_header() {
+		static const byte garbage[] = { 'N', 'O', 'P', 'E', 0, 0, 0 };
+		Common::MemoryReadStream stream(garbage, sizeof(garbage));
+
+		XMLParserTestParser parser;
+		TS_ASSERT(!parser.parseCompiled(&stream));
+		TS_ASSERT(parser._trace.empty());
+	}
+};
@@ -13,6 +13,18 @@ ifeq ($(ENABLE_WINTERMUTE), STATIC_PLUGIN)
 	TEST_LIBS += engines/wintermute/libwintermute.a
 endif
 
+# Only the SMUSH codecs are tested, linking all of libscumm.a would pull in
+# the whole engine
+ifeq ($(ENABLE_SCUMM), STATIC_PLUGIN)
+ifdef ENABLE_SCUMM_7_8
+	TESTS += $(srcdir)/test/engines/scumm/*.h
+	TEST_LIBS := engines/scumm/smush/codec37.o engines/scumm/smush/codec47.o $(TEST_LIBS)
+ifdef USE_ARM_SMUSH_ASM
+	TEST_LIBS := engines/scumm/smush/codec47ARM.o $(TEST_LIBS)
+endif
+endif
+endif
+
 ifeq ($(ENABLE_ULTIMA), STATIC_PLUGIN)
 	TESTS += $(srcdir)/test/engines/ultima/*/*/*.h
 	TEST_LIBS += engines/ultima/libultima.a
@@ -25,8 +25,10 @@
 #include "audio/audiostream.h"
 #include "audio/mixer.h" // for kMaxChannelVolume
 
+#include "common/bufferedstream.h"
 #include "common/rational.h"
 #include "common/file.h"
+#include "common/profiler.h"
 #include "common/system.h"
 
 #include "graphics/palette.h"
@@ -90,7 +92,9 @@ bool VideoDecoder::loadFile(const Common::String &filename) {
 		return false;
 	}
 
-	return loadStream(file);
+	// Videos are mostly read front to back, so the next window is read on
+	// the task pool while the decoder works on the current one
+	return loadStream(Common::wrapReadAheadSeekableReadStream(file, 64 * 1024, DisposeAfterUse::YES, true));
 }
 
 bool VideoDecoder::needsUpdate() const {
@@ -182,6 +186,8 @@ Graphics::PixelFormat VideoDecoder::getPixelFormat() const {
 }
 
 const Graphics::Surface *VideoDecoder::decodeNextFrame() {
+	PROFILE_ZONE("VideoDecoder::decodeNextFrame");
+
 	_needsUpdate = false;
 	_canSetDither = false;
 
@@ -62,6 +62,7 @@ public:
 	 * Load a video from a file with the given name.
 	 *
 	 * A default implementation using Common::File and loadStream is provided.
+	 * It reads ahead of the decoder on the shared TaskPool.
 	 *
 	 * @param filename	the filename to load
 	 * @return whether loading the file succeeded